@@ -1,8 +1,28 @@
+#include <sample_algorithm.hpp>
 #include <sample_anyiterator.hpp>
+#include <sample_anyrange.hpp>
+#include <sample_anysentinel.hpp>
+#include <sample_bufferediterator.hpp>
+#include <sample_generator.hpp>
+#include <sample_mappedrecords.hpp>
+#include <sample_parallelalgorithm.hpp>
+#include <sample_readahead.hpp>
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <numeric>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <span>
+#include <vector>
 
 namespace {
     template <typename It>
@@ -13,9 +33,72 @@ namespace {
     void BM_IteratorCopyToOutput(benchmark::State& state);
     template <typename OutIt>
     void BM_IteratorOutputIt(benchmark::State& state);
+    template <typename OutIt>
+    void BM_SampleCopyToOutputIt(benchmark::State& state);
+    template <typename InIt, typename OutIt>
+    void BM_ErasedCopyToOutputIt(benchmark::State& state);
+    template <typename It>
+    void BM_SampleCopyToOutput(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_IteratorDereference(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_IteratorIncrement(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_IteratorVectorGrowth(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_IteratorSort(benchmark::State& state);
+    template <typename It, bool Pooled>
+    void BM_SpilledIteratorCopy(benchmark::State& state);
+    template <typename Container>
+    void BM_PassIteratorPair(benchmark::State& state);
+    template <typename Container>
+    void BM_PassRange(benchmark::State& state);
+    template <typename Container>
+    void BM_TraverseToEndIterator(benchmark::State& state);
+    template <typename Container>
+    void BM_TraverseToSentinel(benchmark::State& state);
+    template <typename It>
+    void BM_StdFind(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_StdCountIf(benchmark::State& state);
+    template <typename It, typename Container>
+    void BM_SampleCountIf(benchmark::State& state);
+    template <typename It>
+    void BM_SampleFind(benchmark::State& state);
+
+    enum class Reduction { sum, count, find, minElement, maxElement };
+    template <typename T, Reduction R>
+    void BM_ScalarReduction(benchmark::State& state);
+    template <typename T, Reduction R>
+    void BM_SampleReduction(benchmark::State& state);
+    template <typename Container>
+    void BM_SampleAccumulate(benchmark::State& state);
+    template <typename Container>
+    void BM_ParallelReduce(benchmark::State& state);
+    void BM_SkewedStaticChunks(benchmark::State& state);
+    void BM_SkewedWorkStealing(benchmark::State& state);
+    void BM_GeneratorSum(benchmark::State& state);
+    void BM_BatchGeneratorSum(benchmark::State& state);
+    void BM_ParseDirect(benchmark::State& state);
+    void BM_ParseReadAhead(benchmark::State& state);
+    void BM_LoadRecordsAndSum(benchmark::State& state);
+    void BM_MapRecordsAndSum(benchmark::State& state);
+
+    using HeapRandomAccessIterator = sample::any_random_access_iterator<int,
+        int&, int*, std::ptrdiff_t, sample::heap_storage>;
+    using SharedRandomAccessIterator = sample::any_random_access_iterator<int,
+        int&, int*, std::ptrdiff_t, sample::shared_storage<0>>;
+    using UnsyncSharedRandomAccessIterator =
+        sample::any_random_access_iterator<int, int&, int*, std::ptrdiff_t,
+            sample::shared_storage<0, false>>;
 
     using ContainerType = std::vector<int>;
     constexpr std::size_t N = 200u;
+    constexpr std::size_t REDUCTION_N = 4096u;
+    constexpr std::size_t PARALLEL_N = 1u << 20;
+    constexpr std::size_t SKEWED_N = 1u << 16;
+    constexpr std::size_t PARSE_N = 1u << 14;
+    constexpr std::size_t RECORDS_N = 1u << 21;
 }
 
 BENCHMARK_TEMPLATE(BM_IteratorCreation, sample::any_input_iterator<int>)->Arg(N);
@@ -26,6 +109,96 @@ BENCHMARK_TEMPLATE(BM_IteratorCopyToOutput, sample::any_input_iterator<int>)->Ar
 BENCHMARK_TEMPLATE(BM_IteratorCopyToOutput, ContainerType::iterator)->Arg(N);
 BENCHMARK_TEMPLATE(BM_IteratorOutputIt, sample::any_output_iterator<int>)->Arg(N);
 BENCHMARK_TEMPLATE(BM_IteratorOutputIt, std::back_insert_iterator<ContainerType>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorOutputIt, sample::buffered_output_iterator<sample::any_output_iterator<int>>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_ErasedCopyToOutputIt, sample::any_input_iterator<int>, sample::any_output_iterator<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_ErasedCopyToOutputIt, sample::buffered_input_iterator<sample::any_input_iterator<int>>, sample::buffered_output_iterator<sample::any_output_iterator<int>>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_ErasedCopyToOutputIt, std::deque<int>::iterator, std::back_insert_iterator<ContainerType>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCopyToOutputIt, sample::any_output_iterator<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCopyToOutputIt, std::back_insert_iterator<ContainerType>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCopyToOutput, sample::any_input_iterator<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCopyToOutput, ContainerType::iterator)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorDereference, sample::any_random_access_iterator<int>, ContainerType)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorDereference, sample::any_random_access_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorDereference, ContainerType::iterator, ContainerType)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorIncrement, sample::any_random_access_iterator<int>, ContainerType)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorIncrement, sample::any_random_access_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorIncrement, ContainerType::iterator, ContainerType)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorVectorGrowth, sample::any_random_access_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorVectorGrowth, HeapRandomAccessIterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorVectorGrowth, std::deque<int>::iterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorSort, sample::any_random_access_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorSort, HeapRandomAccessIterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorSort, SharedRandomAccessIterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_IteratorSort, std::deque<int>::iterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SpilledIteratorCopy, HeapRandomAccessIterator, false)->Arg(N)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpilledIteratorCopy, HeapRandomAccessIterator, true)->Arg(N)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpilledIteratorCopy, SharedRandomAccessIterator, false)->Arg(N)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpilledIteratorCopy, UnsyncSharedRandomAccessIterator, false)->Arg(N)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PassIteratorPair, std::deque<int>)->Arg(8)->Arg(N);
+BENCHMARK_TEMPLATE(BM_PassRange, std::deque<int>)->Arg(8)->Arg(N);
+BENCHMARK_TEMPLATE(BM_TraverseToEndIterator, std::list<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_TraverseToSentinel, std::list<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdFind, sample::any_forward_iterator<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleFind, sample::any_forward_iterator<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdFind, ContainerType::iterator)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdCountIf, sample::any_forward_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCountIf, sample::any_forward_iterator<int>, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdCountIf, std::deque<int>::iterator, std::deque<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdCountIf, sample::any_forward_iterator<int>, std::list<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_SampleCountIf, sample::any_forward_iterator<int>, std::list<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_StdCountIf, std::list<int>::iterator, std::list<int>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, int, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, int, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, int, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, int, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, int, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, int, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, int, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, int, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, int, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, int, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, std::int64_t, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, std::int64_t, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, std::int64_t, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, std::int64_t, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, std::int64_t, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, std::int64_t, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, std::int64_t, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, std::int64_t, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, std::int64_t, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, std::int64_t, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, float, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, float, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, float, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, float, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, float, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, float, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, float, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, float, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, float, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, float, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, double, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, double, Reduction::sum)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, double, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, double, Reduction::count)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, double, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, double, Reduction::find)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, double, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, double, Reduction::minElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_ScalarReduction, double, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleReduction, double, Reduction::maxElement)->Arg(REDUCTION_N);
+BENCHMARK_TEMPLATE(BM_SampleAccumulate, std::deque<std::int64_t>)->Arg(PARALLEL_N)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ParallelReduce, std::deque<std::int64_t>)->Arg(PARALLEL_N)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SampleAccumulate, std::vector<std::int64_t>)->Arg(PARALLEL_N)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ParallelReduce, std::vector<std::int64_t>)->Arg(PARALLEL_N)->UseRealTime();
+BENCHMARK(BM_SkewedStaticChunks)->Arg(SKEWED_N)->UseRealTime();
+BENCHMARK(BM_SkewedWorkStealing)->Arg(SKEWED_N)->UseRealTime();
+BENCHMARK(BM_GeneratorSum)->Arg(REDUCTION_N);
+BENCHMARK(BM_BatchGeneratorSum)->Arg(REDUCTION_N);
+BENCHMARK(BM_ParseDirect)->Arg(PARSE_N)->UseRealTime();
+BENCHMARK(BM_ParseReadAhead)->Arg(PARSE_N)->UseRealTime();
+BENCHMARK(BM_LoadRecordsAndSum)->Arg(RECORDS_N)->UseRealTime();
+BENCHMARK(BM_MapRecordsAndSum)->Arg(RECORDS_N)->UseRealTime();
 
 namespace {
 template <typename It, typename... Args>
@@ -92,6 +265,633 @@ void BM_IteratorOutputIt(benchmark::State& state)
         std::copy(begin(input), end(input), d_first);
     }
 }
-} // close anonymous namespace
 
-BENCHMARK_MAIN();
+template <typename OutIt>
+void BM_SampleCopyToOutputIt(benchmark::State& state)
+{
+    ContainerType input(state.range(0));
+    ContainerType output;
+    output.reserve(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        output.clear();
+        auto d_first = CreateIterator<OutIt>(std::back_inserter(output));
+        sample::copy(begin(input), end(input), d_first);
+    }
+}
+
+template <typename InIt, typename OutIt>
+void BM_ErasedCopyToOutputIt(benchmark::State& state)
+{
+    std::deque<int> input(state.range(0));
+    ContainerType output;
+    output.reserve(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        output.clear();
+        if constexpr (std::is_same_v<InIt, std::deque<int>::iterator>)
+        {
+            std::copy(begin(input), end(input), std::back_inserter(output));
+        }
+        else if constexpr (std::is_same_v<InIt, sample::any_input_iterator<int>>)
+        {
+            auto first = CreateIterator<InIt>(begin(input));
+            auto last = CreateIterator<InIt>(end(input));
+            std::copy(first, last, OutIt(std::back_inserter(output)));
+        }
+        else
+        {
+            using AnyIterator = sample::any_input_iterator<int>;
+            auto first = CreateIterator<InIt>(AnyIterator(begin(input)),
+                                              AnyIterator(end(input)));
+            std::copy(first, InIt(), OutIt(std::back_inserter(output)));
+        }
+    }
+}
+
+template <typename It>
+void BM_SampleCopyToOutput(benchmark::State& state)
+{
+    ContainerType input(state.range(0));
+    ContainerType output(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto first = CreateIterator<It>(begin(input));
+        auto last = CreateIterator<It>(end(input));
+
+        sample::copy(first, last, begin(output));
+    }
+}
+
+template <typename It, typename Container>
+void BM_IteratorDereference(benchmark::State& state)
+{
+    Container input(state.range(0));
+    auto first = CreateIterator<It>(begin(input));
+
+    while (state.KeepRunning())
+    {
+        int sum = 0;
+        for (typename It::difference_type i = 0; i != state.range(0); ++i)
+        {
+            sum += first[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename It, typename Container>
+void BM_IteratorIncrement(benchmark::State& state)
+{
+    Container input(state.range(0));
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        int sum = 0;
+        for (auto it = first; it != last; ++it)
+        {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename It, typename Container>
+void BM_IteratorVectorGrowth(benchmark::State& state)
+{
+    Container input(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        std::vector<It> cursors;
+        for (auto it = begin(input); it != end(input); ++it)
+        {
+            cursors.push_back(CreateIterator<It>(it));
+        }
+        benchmark::DoNotOptimize(cursors.data());
+    }
+}
+
+template <typename It, typename Container>
+void BM_IteratorSort(benchmark::State& state)
+{
+    Container input(state.range(0));
+    std::iota(begin(input), end(input), 0);
+    std::shuffle(begin(input), end(input), std::mt19937{});
+
+    std::vector<It> cursors;
+    for (auto it = begin(input); it != end(input); ++it)
+    {
+        cursors.push_back(CreateIterator<It>(it));
+    }
+
+    bool ascending = true;
+    while (state.KeepRunning())
+    {
+        // Alternate the order so that every iteration does real work.
+        std::sort(begin(cursors), end(cursors),
+            [ascending](const It& lhs, const It& rhs) {
+                return ascending ? *lhs < *rhs : *rhs < *lhs;
+            });
+        ascending = !ascending;
+    }
+}
+
+template <typename It, bool Pooled>
+void BM_SpilledIteratorCopy(benchmark::State& state)
+{
+    std::deque<int> input(state.range(0));
+    std::pmr::memory_resource* const resource = Pooled
+        ? sample::iterator_pool_resource() : std::pmr::new_delete_resource();
+    auto first = CreateIterator<It>(std::allocator_arg, resource, begin(input));
+
+    while (state.KeepRunning())
+    {
+        // Hold a few copies at once, as passing iterators down by value does.
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            It copy1(first);
+            It copy2(copy1);
+            It copy3(copy2);
+            benchmark::DoNotOptimize(copy3.base());
+        }
+    }
+    state.SetItemsProcessed(3 * state.iterations() * state.range(0));
+}
+
+[[gnu::noinline]] int SumPair(sample::any_forward_iterator<int> first,
+                              sample::any_forward_iterator<int> last)
+{
+    int sum = 0;
+    for (; first != last; ++first)
+    {
+        sum += *first;
+    }
+    return sum;
+}
+
+[[gnu::noinline]] int SumRange(sample::any_forward_range<int> range)
+{
+    int sum = 0;
+    for (int i : range)
+    {
+        sum += i;
+    }
+    return sum;
+}
+
+template <typename Container>
+void BM_PassIteratorPair(benchmark::State& state)
+{
+    Container input(state.range(0));
+    sample::any_forward_iterator<int> first(begin(input));
+    sample::any_forward_iterator<int> last(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(SumPair(first, last));
+    }
+}
+
+template <typename Container>
+void BM_PassRange(benchmark::State& state)
+{
+    Container input(state.range(0));
+    sample::any_forward_range<int> range(input);
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(SumRange(range));
+    }
+}
+
+template <typename Container>
+void BM_TraverseToEndIterator(benchmark::State& state)
+{
+    Container input(state.range(0));
+    sample::any_forward_iterator<int> first(begin(input));
+    sample::any_forward_iterator<int> last(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(std::ranges::count(first, last, 1));
+    }
+}
+
+template <typename Container>
+void BM_TraverseToSentinel(benchmark::State& state)
+{
+    using Iterator = sample::any_forward_iterator<int>;
+    Container input(state.range(0));
+    Iterator first(begin(input));
+    sample::any_sentinel<Iterator> last(
+        std::in_place_type<typename Container::iterator>, end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(std::ranges::count(first, last, 1));
+    }
+}
+
+template <typename It>
+void BM_StdFind(benchmark::State& state)
+{
+    ContainerType input(state.range(0));
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(std::find(first, last, 1));
+    }
+}
+
+template <typename It>
+void BM_SampleFind(benchmark::State& state)
+{
+    ContainerType input(state.range(0));
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(sample::find(first, last, 1));
+    }
+}
+
+template <typename It, typename Container>
+void BM_StdCountIf(benchmark::State& state)
+{
+    Container input(state.range(0));
+    std::iota(begin(input), end(input), 0);
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(std::count_if(first, last,
+            [](int i) { return i % 3 == 0; }));
+    }
+}
+
+template <typename It, typename Container>
+void BM_SampleCountIf(benchmark::State& state)
+{
+    Container input(state.range(0));
+    std::iota(begin(input), end(input), 0);
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(sample::count_if(first, last,
+            [](int i) { return i % 3 == 0; }));
+    }
+}
+
+template <typename T, Reduction R>
+[[gnu::noinline, gnu::optimize("no-tree-vectorize")]]
+auto ScalarReduce(const T* first, const T* last)
+{
+    if constexpr (R == Reduction::sum)
+    {
+        T sum{};
+        for (; first != last; ++first)
+        {
+            sum += *first;
+        }
+        return sum;
+    }
+    else if constexpr (R == Reduction::count)
+    {
+        std::ptrdiff_t count = 0;
+        for (; first != last; ++first)
+        {
+            count += *first == T{-1};
+        }
+        return count;
+    }
+    else if constexpr (R == Reduction::find)
+    {
+        for (; first != last && *first != T{-1}; ++first)
+        {
+        }
+        return first;
+    }
+    else
+    {
+        const T* result = first;
+        for (; first != last; ++first)
+        {
+            if (R == Reduction::minElement ? *first < *result
+                                           : *result < *first)
+            {
+                result = first;
+            }
+        }
+        return result;
+    }
+}
+
+template <typename T>
+std::vector<T> ReductionInput(std::size_t size)
+{
+    std::vector<T> input(size);
+    std::mt19937 generator(size);
+    std::uniform_int_distribution<int> distribution(0, 1000);
+    for (T& value : input)
+    {
+        value = static_cast<T>(distribution(generator));
+    }
+    return input;
+}
+
+template <typename T, Reduction R>
+void BM_ScalarReduction(benchmark::State& state)
+{
+    const std::vector<T> input = ReductionInput<T>(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(ScalarReduce<T, R>(input.data(),
+            input.data() + input.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T, Reduction R>
+void BM_SampleReduction(benchmark::State& state)
+{
+    std::vector<T> input = ReductionInput<T>(state.range(0));
+    using It = sample::any_random_access_iterator<T>;
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        if constexpr (R == Reduction::sum)
+        {
+            benchmark::DoNotOptimize(sample::accumulate(first, last, T{}));
+        }
+        else if constexpr (R == Reduction::count)
+        {
+            benchmark::DoNotOptimize(sample::count(first, last, T{-1}));
+        }
+        else if constexpr (R == Reduction::find)
+        {
+            benchmark::DoNotOptimize(sample::find(first, last, T{-1}));
+        }
+        else if constexpr (R == Reduction::minElement)
+        {
+            benchmark::DoNotOptimize(sample::min_element(first, last));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(sample::max_element(first, last));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_SampleAccumulate(benchmark::State& state)
+{
+    Container input(state.range(0));
+    std::iota(begin(input), end(input), 0);
+    using It = sample::any_random_access_iterator<
+        typename Container::value_type>;
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(sample::accumulate(first, last,
+            typename Container::value_type{}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_ParallelReduce(benchmark::State& state)
+{
+    Container input(state.range(0));
+    std::iota(begin(input), end(input), 0);
+    using It = sample::any_random_access_iterator<
+        typename Container::value_type>;
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(sample::parallel::reduce(first, last,
+            typename Container::value_type{}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void SkewedWork(int& element)
+{
+    // The elements in the first eighth of the range cost 100 times more.
+    for (int i = 0; i != element; ++i)
+    {
+        benchmark::DoNotOptimize(i);
+    }
+}
+
+std::deque<int> SkewedInput(std::size_t size)
+{
+    std::deque<int> input(size, 10);
+    std::fill_n(begin(input), size / 8, 1000);
+    return input;
+}
+
+void BM_SkewedStaticChunks(benchmark::State& state)
+{
+    std::deque<int> input = SkewedInput(state.range(0));
+    using It = sample::any_random_access_iterator<int>;
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+    sample::thread_pool& pool = sample::thread_pool::instance();
+    const std::size_t chunks = pool.concurrency();
+
+    while (state.KeepRunning())
+    {
+        const auto ranges = sample::split(
+            sample::split_range<It>(first, last), chunks);
+        pool.run(chunks, [&](std::size_t chunk)
+        {
+            sample::for_each(ranges[chunk].begin(), ranges[chunk].end(),
+                SkewedWork);
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SkewedWorkStealing(benchmark::State& state)
+{
+    std::deque<int> input = SkewedInput(state.range(0));
+    using It = sample::any_random_access_iterator<int>;
+    auto first = CreateIterator<It>(begin(input));
+    auto last = CreateIterator<It>(end(input));
+
+    while (state.KeepRunning())
+    {
+        sample::parallel::for_each(first, last, SkewedWork);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+sample::generator<int> GenerateValues(int count)
+{
+    for (int i = 0; i != count; ++i)
+    {
+        co_yield i;
+    }
+}
+
+sample::batch_generator<int> GenerateBatches(int count)
+{
+    std::array<int, 256> batch;
+    for (int i = 0; i < count; i += static_cast<int>(batch.size()))
+    {
+        const int size = std::min(count - i, static_cast<int>(batch.size()));
+        std::iota(batch.begin(), batch.begin() + size, i);
+        co_yield std::span<int>(batch.data(), size);
+    }
+}
+
+void BM_GeneratorSum(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        auto values = GenerateValues(state.range(0));
+        sample::any_input_iterator<int> first(values.begin());
+        sample::any_input_iterator<int> last(values.end());
+        benchmark::DoNotOptimize(sample::accumulate(first, last, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BatchGeneratorSum(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        auto values = GenerateBatches(state.range(0));
+        sample::any_input_iterator<int> first(values.begin());
+        sample::any_input_iterator<int> last(values.end());
+        benchmark::DoNotOptimize(sample::accumulate(first, last, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+std::string ParseInput(std::size_t size)
+{
+    std::string input;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        input += std::to_string(i * 7919) + ' ';
+    }
+    return input;
+}
+
+using ParsedIterator = sample::any_input_iterator<int, const int&,
+    const int*>;
+
+int ProcessParsed(ParsedIterator first, ParsedIterator last)
+{
+    // Each element costs about as much to process as to parse.
+    int result = 0;
+    for (; first != last; ++first)
+    {
+        for (int i = 0; i != 50; ++i)
+        {
+            benchmark::DoNotOptimize(result += *first);
+        }
+    }
+    return result;
+}
+
+void BM_ParseDirect(benchmark::State& state)
+{
+    const std::string input = ParseInput(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        std::istringstream stream(input);
+        benchmark::DoNotOptimize(ProcessParsed(
+            std::istream_iterator<int>(stream), std::istream_iterator<int>()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ParseReadAhead(benchmark::State& state)
+{
+    const std::string input = ParseInput(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        std::istringstream stream(input);
+        sample::read_ahead_range<int> parsed{
+            std::istream_iterator<int>(stream), std::istream_iterator<int>()};
+        benchmark::DoNotOptimize(ProcessParsed(parsed.begin(), parsed.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+std::filesystem::path RecordsFile(std::size_t size)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sample_records.bin";
+    if (!std::filesystem::exists(path) ||
+        std::filesystem::file_size(path) != size * sizeof(std::int64_t))
+    {
+        std::vector<std::int64_t> records(size);
+        std::iota(begin(records), end(records), 0);
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(records.data()),
+                     records.size() * sizeof(std::int64_t));
+    }
+    return path;
+}
+
+void BM_LoadRecordsAndSum(benchmark::State& state)
+{
+    const std::filesystem::path path = RecordsFile(state.range(0));
+    using It = sample::any_random_access_iterator<const std::int64_t>;
+
+    while (state.KeepRunning())
+    {
+        std::vector<std::int64_t> records(state.range(0));
+        std::ifstream stream(path, std::ios::binary);
+        stream.read(reinterpret_cast<char*>(records.data()),
+                    records.size() * sizeof(std::int64_t));
+        auto first = CreateIterator<It>(records.data());
+        auto last = CreateIterator<It>(records.data() + records.size());
+        benchmark::DoNotOptimize(sample::accumulate(first, last,
+            std::int64_t{}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapRecordsAndSum(benchmark::State& state)
+{
+    const std::filesystem::path path = RecordsFile(state.range(0));
+    using It = sample::any_random_access_iterator<const std::int64_t>;
+
+    while (state.KeepRunning())
+    {
+        sample::mapped_records<std::int64_t> records(path,
+            sample::access_pattern::sequential);
+        auto first = CreateIterator<It>(records.begin());
+        auto last = CreateIterator<It>(records.end());
+        benchmark::DoNotOptimize(sample::accumulate(first, last,
+            std::int64_t{}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // close anonymous namespace
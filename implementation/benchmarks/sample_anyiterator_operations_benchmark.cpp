@@ -0,0 +1,616 @@
+#include <sample_anyiterator.hpp>
+#include <sample_smallbuffer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// This suite measures each operation of the `any_iterator` aliases, for
+// every combination of alias, value type and the path the erased iterator
+// takes:
+//
+//: o `inline`: the underlying iterator, a `std::deque` iterator, is held
+//:   in the `SmallBuffer` and operations dispatch through the vtable;
+//: o `spilled`: the underlying iterator is padded past the `SmallBuffer`,
+//:   so it is allocated and operations dispatch through the vtable to it;
+//: o `contiguous`: the underlying iterator is a `std::vector` iterator,
+//:   held as a raw pointer, so most operations do not dispatch at all.
+//
+// Each `BM_<Operation>` benchmark applies the operation `OPERATION_N` times
+// to the same iterators, and so measures the operation alone, but for
+// `BM_Assign`, which increments after each assignment as an output iterator
+// must.  `BM_Traverse` dereferences and increments through ranges of sizes
+// from one to ten million elements, to show how the paths behave as the
+// elements leave the caches.  Benchmarks are named after the operation,
+// the alias, the value type and the path, so that a subset can be run with
+// `--benchmark_filter`, such as `--benchmark_filter=spilled`.
+
+namespace {
+    template <std::size_t Size>
+    struct Payload;
+    template <typename It>
+    struct Spilled;
+    template <typename T>
+    struct Writer;
+
+    struct InputAlias;
+    struct OutputAlias;
+    struct ForwardAlias;
+    struct BidirectionalAlias;
+    struct RandomAccessAlias;
+
+    enum class Path { inlined, spilled, contiguous };
+
+    template <typename Alias, Path P, typename T>
+    class Fixture;
+
+    template <typename Alias, Path P, typename T>
+    void BM_Dereference(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Arrow(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_PreIncrement(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_PostIncrement(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_PreDecrement(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_PostDecrement(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_PlusAssign(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Subscript(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Equal(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Less(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Difference(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Assign(benchmark::State& state);
+    template <typename Alias, typename ToAlias, Path P, typename T>
+    void BM_Convert(benchmark::State& state);
+    template <typename Alias, Path P, typename T>
+    void BM_Traverse(benchmark::State& state);
+
+    template <typename T>
+    bool RegisterValueType();
+    bool RegisterSuite();
+
+    constexpr std::size_t OPERATION_N = 4096u;
+    constexpr std::array<std::size_t, 8> TRAVERSE_N = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u };
+    constexpr std::size_t MAX_TRAVERSE_BYTES = 256u << 20;
+
+    const bool REGISTERED = RegisterSuite();
+}
+
+namespace {
+template <std::size_t Size>
+struct Payload
+{
+    // A value type of `Size` bytes.
+    std::array<unsigned char, Size> d_bytes;
+};
+
+template <typename It>
+struct Spilled
+{
+    // An iterator behaving as `It`, padded so that it does not fit in the
+    // `SmallBuffer` of an `any_iterator`.
+    using iterator_category =
+        typename std::iterator_traits<It>::iterator_category;
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using reference = typename std::iterator_traits<It>::reference;
+    using pointer = typename std::iterator_traits<It>::pointer;
+
+    decltype(auto) operator*() const { return *d_it; }
+    auto operator->() const { return std::addressof(*d_it); }
+    decltype(auto) operator[](difference_type n) const { return d_it[n]; }
+    Spilled& operator++() { ++d_it; return *this; }
+    Spilled operator++(int) { Spilled copy(*this); ++d_it; return copy; }
+    Spilled& operator--() { --d_it; return *this; }
+    Spilled operator--(int) { Spilled copy(*this); --d_it; return copy; }
+    Spilled& operator+=(difference_type n) { d_it += n; return *this; }
+    Spilled& operator-=(difference_type n) { d_it -= n; return *this; }
+    Spilled operator+(difference_type n) const { return {d_it + n}; }
+    Spilled operator-(difference_type n) const { return {d_it - n}; }
+    difference_type operator-(const Spilled& rhs) const
+    {
+        return d_it - rhs.d_it;
+    }
+    bool operator==(const Spilled& rhs) const { return d_it == rhs.d_it; }
+    auto operator<=>(const Spilled& rhs) const { return d_it <=> rhs.d_it; }
+
+    It d_it;
+    std::array<std::byte, sample::detail::DEFAULT_BUFFER_SIZE> d_padding{};
+};
+
+template <typename T>
+struct Writer
+{
+    // An output iterator writing to consecutive elements of an array.
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using reference = void;
+    using pointer = void;
+
+    T& operator*() const { return *d_cursor; }
+    Writer& operator++() { ++d_cursor; return *this; }
+    Writer operator++(int) { return {d_cursor++}; }
+
+    T *d_cursor;
+};
+
+struct InputAlias
+{
+    template <typename T>
+    using type = sample::any_input_iterator<T>;
+    static constexpr const char *name = "any_input_iterator";
+};
+
+struct OutputAlias
+{
+    template <typename T>
+    using type = sample::any_output_iterator<T>;
+    static constexpr const char *name = "any_output_iterator";
+};
+
+struct ForwardAlias
+{
+    template <typename T>
+    using type = sample::any_forward_iterator<T>;
+    static constexpr const char *name = "any_forward_iterator";
+};
+
+struct BidirectionalAlias
+{
+    template <typename T>
+    using type = sample::any_bidirectional_iterator<T>;
+    static constexpr const char *name = "any_bidirectional_iterator";
+};
+
+struct RandomAccessAlias
+{
+    template <typename T>
+    using type = sample::any_random_access_iterator<T>;
+    static constexpr const char *name = "any_random_access_iterator";
+};
+
+template <typename T>
+std::string TypeName()
+{
+    if constexpr (std::is_same_v<T, char>)
+    {
+        return "char";
+    }
+    else if constexpr (std::is_same_v<T, int>)
+    {
+        return "int";
+    }
+    else
+    {
+        return "Payload<" + std::to_string(sizeof(T)) + ">";
+    }
+}
+
+const char* PathName(Path path)
+{
+    switch (path)
+    {
+      case Path::inlined:
+        return "inline";
+      case Path::spilled:
+        return "spilled";
+      case Path::contiguous:
+        return "contiguous";
+    }
+    return "";
+}
+
+template <typename Alias, Path P, typename T>
+class Fixture
+{
+    // The elements a benchmark runs on, and erased iterators to the first
+    // and past the last of them, the latter a copy of the former for output
+    // iterators.
+public:
+    using Any = typename Alias::template type<T>;
+    static constexpr bool isOutput = std::is_same_v<Alias, OutputAlias>;
+    using Container = std::conditional_t<P == Path::contiguous || isOutput,
+        std::vector<T>, std::deque<T>>;
+
+    explicit Fixture(std::size_t size)
+        : d_elements(size)
+        , d_first(Erase(d_elements.begin()))
+        , d_last(isOutput ? d_first : Erase(d_elements.end()))
+    {}
+
+    Container d_elements;
+    Any       d_first;
+    Any       d_last;
+
+private:
+    static Any Erase(typename Container::iterator it)
+    {
+        if constexpr (isOutput)
+        {
+            const Writer<T> writer{std::to_address(it)};
+            if constexpr (P == Path::spilled)
+            {
+                return Any(Spilled<Writer<T>>{writer});
+            }
+            else
+            {
+                return Any(writer);
+            }
+        }
+        else if constexpr (P == Path::spilled)
+        {
+            return Any(Spilled<typename Container::iterator>{it});
+        }
+        else
+        {
+            return Any(it);
+        }
+    }
+};
+
+template <typename Alias, Path P, typename T>
+std::string BenchmarkName(const char *operation)
+{
+    return std::string(operation) + "<" + Alias::name + "<" + TypeName<T>() +
+        ">," + PathName(P) + ">";
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Dereference(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+    const auto& it = fixture.d_first;
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Arrow(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+    const auto& it = fixture.d_first;
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(it.operator->());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_PreIncrement(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_first;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            ++it;
+        }
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_PostIncrement(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_first;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            if constexpr (!std::is_same_v<Alias, ForwardAlias> &&
+                          !std::is_same_v<Alias, BidirectionalAlias> &&
+                          !std::is_same_v<Alias, RandomAccessAlias>)
+            {
+                // Single pass iterators return no copy.
+                it++;
+            }
+            else
+            {
+                benchmark::DoNotOptimize(it++);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_PreDecrement(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_last;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            --it;
+        }
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_PostDecrement(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_last;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(it--);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_PlusAssign(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_first;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            it += 1;
+        }
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Subscript(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+    const auto& it = fixture.d_first;
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(it[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Equal(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(fixture.d_first == fixture.d_last);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Less(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(fixture.d_first < fixture.d_last);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Difference(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(fixture.d_last - fixture.d_first);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Assign(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+    const T value{};
+
+    while (state.KeepRunning())
+    {
+        auto it = fixture.d_first;
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            *it = value;
+            ++it;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, typename ToAlias, Path P, typename T>
+void BM_Convert(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+    using To = typename ToAlias::template type<T>;
+
+    while (state.KeepRunning())
+    {
+        for (std::int64_t i = 0; i != state.range(0); ++i)
+        {
+            To converted(fixture.d_first);
+            benchmark::DoNotOptimize(converted);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void BM_Traverse(benchmark::State& state)
+{
+    Fixture<Alias, P, T> fixture(state.range(0));
+
+    while (state.KeepRunning())
+    {
+        if constexpr (std::is_same_v<Alias, OutputAlias>)
+        {
+            const T value{};
+            auto it = fixture.d_first;
+            for (std::int64_t i = 0; i != state.range(0); ++i)
+            {
+                *it = value;
+                ++it;
+            }
+            benchmark::ClobberMemory();
+        }
+        else
+        {
+            for (auto it = fixture.d_first; it != fixture.d_last; ++it)
+            {
+                benchmark::DoNotOptimize(*it);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Alias, Path P, typename T>
+void RegisterPath()
+{
+    const auto add = [](const char *operation, auto *function)
+    {
+        benchmark::RegisterBenchmark(
+            BenchmarkName<Alias, P, T>(operation).c_str(), function)
+            ->Arg(OPERATION_N);
+    };
+
+    if constexpr (std::is_same_v<Alias, OutputAlias>)
+    {
+        add("BM_Assign", &BM_Assign<Alias, P, T>);
+        add("BM_PreIncrement", &BM_PreIncrement<Alias, P, T>);
+        add("BM_PostIncrement", &BM_PostIncrement<Alias, P, T>);
+    }
+    else
+    {
+        add("BM_Dereference", &BM_Dereference<Alias, P, T>);
+        add("BM_Arrow", &BM_Arrow<Alias, P, T>);
+        add("BM_PreIncrement", &BM_PreIncrement<Alias, P, T>);
+        add("BM_PostIncrement", &BM_PostIncrement<Alias, P, T>);
+        add("BM_Equal", &BM_Equal<Alias, P, T>);
+    }
+    if constexpr (std::is_same_v<Alias, BidirectionalAlias> ||
+                  std::is_same_v<Alias, RandomAccessAlias>)
+    {
+        add("BM_PreDecrement", &BM_PreDecrement<Alias, P, T>);
+        add("BM_PostDecrement", &BM_PostDecrement<Alias, P, T>);
+    }
+    if constexpr (std::is_same_v<Alias, RandomAccessAlias>)
+    {
+        add("BM_PlusAssign", &BM_PlusAssign<Alias, P, T>);
+        add("BM_Subscript", &BM_Subscript<Alias, P, T>);
+        add("BM_Less", &BM_Less<Alias, P, T>);
+        add("BM_Difference", &BM_Difference<Alias, P, T>);
+        add("BM_ConvertToBidirectional",
+            &BM_Convert<Alias, BidirectionalAlias, P, T>);
+        add("BM_ConvertToForward",
+            &BM_Convert<Alias, ForwardAlias, P, T>);
+        add("BM_ConvertToInput",
+            &BM_Convert<Alias, InputAlias, P, T>);
+    }
+    if constexpr (std::is_same_v<Alias, ForwardAlias>)
+    {
+        add("BM_ConvertToInput",
+            &BM_Convert<Alias, InputAlias, P, T>);
+    }
+
+    auto *traverse = benchmark::RegisterBenchmark(
+        BenchmarkName<Alias, P, T>("BM_Traverse").c_str(),
+        &BM_Traverse<Alias, P, T>);
+    for (const std::size_t size : TRAVERSE_N)
+    {
+        if (size * sizeof(T) <= MAX_TRAVERSE_BYTES)
+        {
+            traverse->Arg(size);
+        }
+    }
+}
+
+template <typename Alias, typename T>
+void RegisterAlias()
+{
+    RegisterPath<Alias, Path::inlined, T>();
+    RegisterPath<Alias, Path::spilled, T>();
+    if constexpr (!std::is_same_v<Alias, OutputAlias>)
+    {
+        RegisterPath<Alias, Path::contiguous, T>();
+    }
+}
+
+template <typename T>
+bool RegisterValueType()
+{
+    RegisterAlias<InputAlias, T>();
+    RegisterAlias<OutputAlias, T>();
+    RegisterAlias<ForwardAlias, T>();
+    RegisterAlias<BidirectionalAlias, T>();
+    RegisterAlias<RandomAccessAlias, T>();
+    return true;
+}
+
+bool RegisterSuite()
+{
+    return RegisterValueType<char>() &&
+           RegisterValueType<int>() &&
+           RegisterValueType<Payload<16>>() &&
+           RegisterValueType<Payload<64>>() &&
+           RegisterValueType<Payload<256>>();
+}
+} // close anonymous namespace
@@ -0,0 +1,224 @@
+#include <benchmarks/sample_benchmarkbaseline.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr const char *DEFAULT_REPETITIONS =
+        "--benchmark_repetitions=10";
+        // The repetitions run to save or compare with a baseline unless
+        // given, which are enough for the Mann-Whitney U test to tell a
+        // change of a few percent from noise.
+
+    struct Options
+    {
+        std::string d_saveBaseline;     // empty if not saving
+        std::string d_compareBaseline;  // empty if not comparing
+        double      d_alpha = 0.05;
+        double      d_threshold = 0.05;
+    };
+
+    class RecordingReporter : public benchmark::ConsoleReporter
+    {
+        // A console reporter that also records the time per iteration of
+        // every repetition of every benchmark that ran without error, by
+        // benchmark name, comparing the real time of benchmarks that use it
+        // and the CPU time of the others.
+
+    public:
+        void ReportRuns(const std::vector<Run>& runs) override;
+
+        const sample::baseline::Samples& samples() const;
+
+    private:
+        sample::baseline::Samples d_samples;
+    };
+
+    bool ConsumeOption(std::string_view argument, std::string_view name,
+                       std::string& value);
+        // Set `value` to the value of `argument` and return `true` if it is
+        // `--name=value`, otherwise return `false`.
+
+    bool ParseOptions(int& argc, char **argv, Options& options);
+        // Remove the baseline options from `argv`, storing them in
+        // `options`, and return whether they are valid.
+} // close anonymous namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+    const bool baselineMode = !options.d_saveBaseline.empty() ||
+                              !options.d_compareBaseline.empty();
+
+    sample::baseline::Samples baseline;
+    if (!options.d_compareBaseline.empty())
+    {
+        try
+        {
+            std::ifstream stream(options.d_compareBaseline);
+            if (!stream)
+            {
+                throw std::runtime_error("cannot open");
+            }
+            baseline = sample::baseline::load(stream);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << options.d_compareBaseline << ": " << e.what()
+                      << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<char*> arguments(argv, argv + argc);
+    bool repetitionsGiven = false;
+    for (char *argument : arguments)
+    {
+        repetitionsGiven = repetitionsGiven ||
+            std::string_view(argument).starts_with("--benchmark_repetitions");
+    }
+    std::string repetitions = DEFAULT_REPETITIONS;
+    if (baselineMode && !repetitionsGiven)
+    {
+        arguments.push_back(repetitions.data());
+    }
+    int count = static_cast<int>(arguments.size());
+    arguments.push_back(nullptr);
+
+    benchmark::Initialize(&count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+    {
+        return EXIT_FAILURE;
+    }
+    if (!baselineMode)
+    {
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        return EXIT_SUCCESS;
+    }
+
+    RecordingReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!options.d_saveBaseline.empty())
+    {
+        std::ofstream stream(options.d_saveBaseline);
+        sample::baseline::save(stream, reporter.samples());
+        if (!stream.flush())
+        {
+            std::cerr << options.d_saveBaseline << ": cannot write\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!options.d_compareBaseline.empty())
+    {
+        const std::vector<sample::baseline::Comparison> comparisons =
+            sample::baseline::compare(baseline, reporter.samples());
+        std::cout << "\nComparison with " << options.d_compareBaseline
+                  << ":\n";
+        sample::baseline::printSignificant(std::cout, comparisons,
+                                           options.d_alpha,
+                                           options.d_threshold);
+        for (const sample::baseline::Comparison& comparison : comparisons)
+        {
+            if (comparison.d_change > 0 &&
+                sample::baseline::isSignificant(comparison, options.d_alpha,
+                                                options.d_threshold))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+namespace {
+void RecordingReporter::ReportRuns(const std::vector<Run>& runs)
+{
+    for (const Run& run : runs)
+    {
+        if (run.run_type != Run::RT_Iteration || run.error_occurred)
+        {
+            continue;
+        }
+        const std::string name = run.benchmark_name();
+        const bool realTime = name.find("/real_time") != std::string::npos;
+        const double time = realTime ? run.GetAdjustedRealTime()
+                                     : run.GetAdjustedCPUTime();
+        d_samples[name].push_back(
+            time * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit));
+    }
+    ConsoleReporter::ReportRuns(runs);
+}
+
+const sample::baseline::Samples& RecordingReporter::samples() const
+{
+    return d_samples;
+}
+
+bool ConsumeOption(std::string_view argument, std::string_view name,
+                   std::string& value)
+{
+    if (!argument.starts_with("--") ||
+        !argument.substr(2).starts_with(name) ||
+        argument.substr(2 + name.size(), 1) != "=")
+    {
+        return false;
+    }
+    value = argument.substr(3 + name.size());
+    return true;
+}
+
+bool ParseOptions(int& argc, char **argv, Options& options)
+{
+    int kept = 1;
+    for (int i = 1; i != argc; ++i)
+    {
+        std::string value;
+        if (ConsumeOption(argv[i], "save_baseline", value))
+        {
+            options.d_saveBaseline = value;
+        }
+        else if (ConsumeOption(argv[i], "compare_baseline", value))
+        {
+            options.d_compareBaseline = value;
+        }
+        else if (ConsumeOption(argv[i], "baseline_alpha", value))
+        {
+            options.d_alpha = std::atof(value.c_str());
+        }
+        else if (ConsumeOption(argv[i], "baseline_threshold", value))
+        {
+            options.d_threshold = std::atof(value.c_str()) / 100;
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    if (options.d_alpha <= 0.0 || options.d_alpha >= 1.0 ||
+        options.d_threshold < 0.0)
+    {
+        std::cerr << "--baseline_alpha must be in (0, 1) and "
+                     "--baseline_threshold, a percentage, at least 0\n";
+        return false;
+    }
+    return true;
+}
+} // close anonymous namespace
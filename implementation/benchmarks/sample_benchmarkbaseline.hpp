@@ -0,0 +1,272 @@
+#ifndef SAMPLE_BENCHMARKBASELINE
+#define SAMPLE_BENCHMARKBASELINE
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sample {
+namespace baseline {
+
+using Samples = std::map<std::string, std::vector<double>>;
+    // The time per iteration, in nanoseconds, measured by each repetition
+    // of each benchmark, by benchmark name.
+
+struct Comparison {
+    // The comparison of the samples of a benchmark in a baseline with those
+    // of the current run.
+
+    // DATA
+    std::string d_name;
+    double      d_baselineMedian;  // nanoseconds
+    double      d_currentMedian;   // nanoseconds
+    double      d_change;          // relative change of the median
+    double      d_pValue;          // of the Mann-Whitney U test
+};
+
+void save(std::ostream& stream, const Samples& samples);
+    // Write `samples` to `stream`, in the format read by `load`: a header
+    // line, then a line per benchmark holding its name and samples,
+    // separated by tabs.
+
+Samples load(std::istream& stream);
+    // Read samples written by `save` from `stream`.  Throw
+    // `std::runtime_error` if `stream` does not hold a baseline.
+
+double median(std::vector<double> values);
+    // Returns the median of `values`, or zero if it is empty.
+
+double mannWhitneyPValue(const std::vector<double>& lhs,
+                         const std::vector<double>& rhs);
+    // Returns the two-sided p-value of the Mann-Whitney U test of whether
+    // `lhs` and `rhs` are drawn from distributions of equal medians, from
+    // the normal approximation of `U` corrected for ties and continuity.
+    // Returns one if either is empty or all values are equal.  The
+    // approximation needs about eight or more values on each side.
+
+std::vector<Comparison> compare(const Samples& baseline,
+                                const Samples& current);
+    // Returns the comparisons of the benchmarks in both `baseline` and
+    // `current`, in name order.
+
+bool isSignificant(const Comparison& comparison, double alpha,
+                   double threshold) noexcept;
+    // Returns whether `comparison` has a p-value below `alpha` and a change
+    // of at least `threshold` either way.
+
+void printSignificant(std::ostream&                  stream,
+                      const std::vector<Comparison>& comparisons,
+                      double                         alpha,
+                      double                         threshold);
+    // Print tables of the significant slowdowns and speedups among
+    // `comparisons` to `stream`, followed by a summary line.
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+constexpr const char *BASELINE_HEADER = "# sample benchmark baseline 1";
+    // The first line of a baseline file.
+
+inline void printTable(std::ostream&                  stream,
+                       const char                    *title,
+                       const std::vector<Comparison>& rows)
+{
+    if (rows.empty()) {
+        return;
+    }
+    std::size_t width = 9;
+    for (const Comparison& row : rows) {
+        width = std::max(width, row.d_name.size());
+    }
+    stream << title << ":\n"
+           << std::left << std::setw(static_cast<int>(width)) << "Benchmark"
+           << std::right << std::setw(16) << "Baseline (ns)"
+           << std::setw(16) << "Current (ns)" << std::setw(10) << "Change"
+           << std::setw(10) << "p-value" << '\n';
+    for (const Comparison& row : rows) {
+        stream << std::left << std::setw(static_cast<int>(width))
+               << row.d_name << std::right << std::fixed
+               << std::setprecision(1) << std::setw(16)
+               << row.d_baselineMedian << std::setw(16)
+               << row.d_currentMedian << std::setw(9) << std::showpos
+               << row.d_change * 100 << std::noshowpos << '%'
+               << std::setprecision(4) << std::setw(10) << row.d_pValue
+               << '\n';
+    }
+    stream << std::defaultfloat << '\n';
+}
+
+} // close namespace detail
+
+inline void save(std::ostream& stream, const Samples& samples)
+{
+    stream << detail::BASELINE_HEADER << '\n' << std::setprecision(17);
+    for (const auto& [name, values] : samples) {
+        stream << name;
+        for (const double value : values) {
+            stream << '\t' << value;
+        }
+        stream << '\n';
+    }
+}
+
+inline Samples load(std::istream& stream)
+{
+    std::string line;
+    if (!std::getline(stream, line) || line != detail::BASELINE_HEADER) {
+        throw std::runtime_error("not a benchmark baseline");
+    }
+
+    Samples samples;
+    while (std::getline(stream, line)) {
+        const std::size_t tab = line.find('\t');
+        std::vector<double>& values = samples[line.substr(0, tab)];
+        if (tab == std::string::npos) {
+            continue;
+        }
+        std::istringstream fields(line.substr(tab + 1));
+        double value;
+        while (fields >> value) {
+            values.push_back(value);
+        }
+        if (!fields.eof()) {
+            throw std::runtime_error("malformed benchmark baseline line: " +
+                                     line);
+        }
+    }
+    return samples;
+}
+
+inline double median(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    const std::size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    if (values.size() % 2 != 0) {
+        return values[middle];
+    }
+    const double upper = values[middle];
+    return (*std::max_element(values.begin(), values.begin() + middle) +
+            upper) / 2;
+}
+
+inline double mannWhitneyPValue(const std::vector<double>& lhs,
+                                const std::vector<double>& rhs)
+{
+    const double n1 = static_cast<double>(lhs.size());
+    const double n2 = static_cast<double>(rhs.size());
+    if (lhs.empty() || rhs.empty()) {
+        return 1.0;
+    }
+
+    // Rank the pooled values, giving tied values their average rank.
+    std::vector<std::pair<double, bool>> pooled;  // value, is from `lhs`
+    pooled.reserve(lhs.size() + rhs.size());
+    for (const double value : lhs) {
+        pooled.emplace_back(value, true);
+    }
+    for (const double value : rhs) {
+        pooled.emplace_back(value, false);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double lhsRankSum = 0.0;
+    double tieTerm = 0.0;  // sum of t^3 - t over groups of t tied values
+    for (std::size_t first = 0; first != pooled.size();) {
+        std::size_t last = first + 1;
+        while (last != pooled.size() &&
+               pooled[last].first == pooled[first].first) {
+            ++last;
+        }
+        const double ties = static_cast<double>(last - first);
+        const double rank = static_cast<double>(first + last + 1) / 2;
+        for (std::size_t i = first; i != last; ++i) {
+            if (pooled[i].second) {
+                lhsRankSum += rank;
+            }
+        }
+        tieTerm += ties * ties * ties - ties;
+        first = last;
+    }
+
+    const double n = n1 + n2;
+    const double u = lhsRankSum - n1 * (n1 + 1) / 2;
+    const double mean = n1 * n2 / 2;
+    const double variance = n1 * n2 / 12 *
+                            ((n + 1) - tieTerm / (n * (n - 1)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    const double z = (std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+}
+
+inline std::vector<Comparison> compare(const Samples& baseline,
+                                       const Samples& current)
+{
+    std::vector<Comparison> comparisons;
+    for (const auto& [name, values] : current) {
+        const auto found = baseline.find(name);
+        if (found == baseline.end()) {
+            continue;
+        }
+        const double before = median(found->second);
+        const double after = median(values);
+        comparisons.push_back({
+            name, before, after,
+            before != 0.0 ? (after - before) / before : 0.0,
+            mannWhitneyPValue(found->second, values) });
+    }
+    return comparisons;
+}
+
+inline bool isSignificant(const Comparison& comparison, double alpha,
+                          double threshold) noexcept
+{
+    return comparison.d_pValue < alpha &&
+           std::abs(comparison.d_change) >= threshold;
+}
+
+inline void printSignificant(std::ostream&                  stream,
+                             const std::vector<Comparison>& comparisons,
+                             double                         alpha,
+                             double                         threshold)
+{
+    std::vector<Comparison> slower;
+    std::vector<Comparison> faster;
+    for (const Comparison& comparison : comparisons) {
+        if (isSignificant(comparison, alpha, threshold)) {
+            (comparison.d_change > 0 ? slower : faster).push_back(comparison);
+        }
+    }
+    const auto byChange = [](const Comparison& lhs, const Comparison& rhs) {
+        return std::abs(lhs.d_change) > std::abs(rhs.d_change);
+    };
+    std::sort(slower.begin(), slower.end(), byChange);
+    std::sort(faster.begin(), faster.end(), byChange);
+
+    detail::printTable(stream, "Significant slowdowns", slower);
+    detail::printTable(stream, "Significant speedups", faster);
+    stream << slower.size() << " slower, " << faster.size() << " faster, "
+           << comparisons.size() - slower.size() - faster.size()
+           << " unchanged (p < " << alpha << ", change of at least "
+           << threshold * 100 << "%)\n";
+}
+
+} // close namespace baseline
+} // close namespace sample
+
+#endif // SAMPLE_BENCHMARKBASELINE
@@ -0,0 +1,560 @@
+#ifndef SAMPLE_ALGORITHM
+#define SAMPLE_ALGORITHM
+
+#include <sample_anyiterator.hpp>
+#include <sample_reductionkernels.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+namespace sample {
+namespace detail {
+
+constexpr std::size_t BULK_READ_BYTES = 4096ul;
+constexpr std::size_t MAX_BULK_READ_COUNT = 256ul;
+
+template <typename ValueType>
+constexpr std::size_t bulkReadCount = std::clamp(
+    BULK_READ_BYTES / sizeof(ValueType), std::size_t{1}, MAX_BULK_READ_COUNT);
+    // The number of elements of `ValueType` fetched per dispatch when reading
+    // from an `any_iterator` in batches.
+
+template <typename Iterator, typename = void>
+struct is_bulk_readable : std::false_type {};
+
+template <typename IteratorCategory, typename ValueType, typename Reference,
+          typename Pointer, typename DifferenceType, typename StoragePolicy>
+struct is_bulk_readable<
+    any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+        DifferenceType, StoragePolicy>,
+    std::enable_if_t<
+        std::is_base_of_v<std::input_iterator_tag, IteratorCategory> &&
+        std::is_default_constructible_v<std::remove_cv_t<ValueType>> &&
+        std::is_assignable_v<std::remove_cv_t<ValueType>&, Reference>
+    >
+> : std::true_type {};
+
+template <typename Iterator>
+constexpr bool is_bulk_readable_v = is_bulk_readable<Iterator>::value;
+
+template <typename Iterator, typename = void>
+struct is_visitable : std::false_type {};
+    // Trait detecting whether `Iterator` is an `any_iterator` supporting
+    // `for_each_until`, so that a loop over it may run inside a single
+    // dispatch to its underlying iterator.
+
+template <typename IteratorCategory, typename ValueType, typename Reference,
+          typename Pointer, typename DifferenceType, typename StoragePolicy>
+struct is_visitable<
+    any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+        DifferenceType, StoragePolicy>,
+    std::enable_if_t<
+        std::is_base_of_v<std::input_iterator_tag, IteratorCategory>
+    >
+> : std::true_type {};
+
+template <typename Iterator>
+constexpr bool is_visitable_v = is_visitable<Iterator>::value;
+
+template <typename Iterator, typename ValueType, typename = void>
+struct is_bulk_writable : std::false_type {};
+    // Trait detecting whether `Iterator` is an output `any_iterator` to which
+    // arrays of `ValueType` may be written with a single dispatch.
+
+template <typename IteratorCategory, typename ValueType, typename Reference,
+          typename Pointer, typename DifferenceType, typename StoragePolicy>
+struct is_bulk_writable<
+    any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+        DifferenceType, StoragePolicy>,
+    ValueType,
+    std::enable_if_t<
+        std::is_base_of_v<std::output_iterator_tag, IteratorCategory>
+    >
+> : std::true_type {};
+
+template <typename Iterator, typename ValueType>
+constexpr bool is_bulk_writable_v =
+    is_bulk_writable<Iterator, ValueType>::value;
+
+template <typename Iterator, typename = void>
+struct is_unwrappable : std::false_type {};
+    // Trait detecting whether `Iterator` is an `any_iterator` which may hold
+    // its underlying iterator as a raw `pointer`, in which case algorithms
+    // may operate on that pointer directly.
+
+template <typename IteratorCategory, typename ValueType, typename Reference,
+          typename Pointer, typename DifferenceType, typename StoragePolicy>
+struct is_unwrappable<
+    any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+        DifferenceType, StoragePolicy>,
+    std::enable_if_t<
+        std::is_base_of_v<std::input_iterator_tag, IteratorCategory> &&
+        std::is_pointer_v<Pointer> &&
+        std::is_same_v<Reference, std::remove_pointer_t<Pointer>&>
+    >
+> : std::true_type {};
+
+template <typename Iterator>
+constexpr bool is_unwrappable_v = is_unwrappable<Iterator>::value;
+
+template <typename Iterator, typename = void>
+struct is_reducible : std::false_type {};
+    // Trait detecting whether `Iterator` is an unwrappable `any_iterator`
+    // over elements of a type for which `ReductionKernels` are provided, so
+    // that algorithms may run them on the raw pointers it holds.
+
+template <typename Iterator>
+struct is_reducible<
+    Iterator,
+    std::enable_if_t<
+        is_unwrappable_v<Iterator> &&
+        is_simd_arithmetic_v<std::remove_cv_t<
+            typename std::iterator_traits<Iterator>::value_type>>
+    >
+> : std::true_type {};
+
+template <typename Iterator>
+constexpr bool is_reducible_v = is_reducible<Iterator>::value;
+
+template <typename Iterator>
+typename Iterator::pointer* unwrap(Iterator& it) noexcept;
+    // Returns the address of the raw pointer held by `it`, or the null
+    // pointer if `it` holds some other iterator.
+    //
+    // Only participates in overload resolution if `is_unwrappable_v<Iterator>`
+    // is `true`.
+
+} // close namespace detail
+
+template <typename InputIt, typename OutputIt>
+OutputIt copy(InputIt first, InputIt last, OutputIt d_first);
+    // Copies the elements in the range `[first, last)` to the range beginning
+    // at `d_first`, returning an iterator one past the last element written,
+    // as if by `std::copy`.
+    //
+    // If `InputIt` is an `any_iterator` and both `first` and `last` hold
+    // raw pointers, as they do when constructed from contiguous iterators,
+    // the elements are copied between those pointers without any dispatch,
+    // and to the raw pointer held by `d_first` if it is such an
+    // `any_iterator` too.  Otherwise, if `InputIt` is an `any_iterator` whose
+    // `value_type` is default constructible, the elements are read from its
+    // underlying iterator in batches with a single dispatch per batch, and
+    // then moved to `d_first`.
+    //
+    // If `OutputIt` is an output `any_iterator` of the `value_type` of
+    // `InputIt`, elements read from raw pointers, contiguous iterators or in
+    // batches of trivially copyable elements are written to it with a single
+    // dispatch per array, and if `InputIt` is a random access iterator the
+    // destination is first given a `reserve_hint` of the number of elements,
+    // so that appending to a container allocates at most once.
+
+template <typename InputIt, typename T>
+InputIt find(InputIt first, InputIt last, const T& value);
+    // Returns an iterator to the first element in the range `[first, last)`
+    // which is equal to `value`, or `last` if there is no such element, as
+    // if by `std::find`.
+    //
+    // If `InputIt` is an `any_iterator` and both `first` and `last` hold
+    // raw pointers, the elements are searched without any dispatch, with
+    // the vectorized kernel for `active_simd_level()` if `T` is the
+    // `value_type` of `InputIt` and it is `int`, `std::int64_t`, `float` or
+    // `double`.  Otherwise they are searched inside a single dispatch to the
+    // underlying iterator, by `for_each_until`.
+
+template <typename InputIt, typename T>
+typename std::iterator_traits<InputIt>::difference_type
+count(InputIt first, InputIt last, const T& value);
+    // Returns the number of elements in the range `[first, last)` which are
+    // equal to `value`, as if by `std::count`.
+    //
+    // If `InputIt` is an `any_iterator` and both `first` and `last` hold
+    // raw pointers, the elements are counted as by `find`, and otherwise
+    // they are visited inside a single dispatch to the underlying iterator,
+    // by `for_each_until`.
+
+template <typename InputIt, typename UnaryPredicate>
+InputIt find_if(InputIt first, InputIt last, UnaryPredicate p);
+    // Returns an iterator to the first element in the range `[first, last)`
+    // for which `p` returns `true`, or `last` if there is no such element,
+    // as if by `std::find_if`.
+    //
+    // If `InputIt` is an `any_iterator`, the elements are searched inside a
+    // single dispatch to the underlying iterator, by `for_each_until`.
+
+template <typename InputIt, typename UnaryPredicate>
+typename std::iterator_traits<InputIt>::difference_type
+count_if(InputIt first, InputIt last, UnaryPredicate p);
+    // Returns the number of elements in the range `[first, last)` for which
+    // `p` returns `true`, as if by `std::count_if`.
+    //
+    // If `InputIt` is an `any_iterator`, the elements are visited inside a
+    // single dispatch to the underlying iterator, by `for_each_until`.
+
+template <typename InputIt, typename T>
+T accumulate(InputIt first, InputIt last, T init);
+template <typename InputIt, typename T, typename BinaryOperation>
+T accumulate(InputIt first, InputIt last, T init, BinaryOperation op);
+    // Returns the result of folding the elements in the range `[first,
+    // last)` into `init`, from the left, with `op`, or with `+` if `op` is
+    // not given, as if by `std::accumulate`.
+    //
+    // If `InputIt` is an `any_iterator`, the elements are visited inside a
+    // single dispatch to the underlying iterator, by `for_each_until`.  If,
+    // in addition, `op` is not given, `T` is the `value_type` of `InputIt`,
+    // which is `int`, `std::int64_t`, `float` or `double`, and both `first`
+    // and `last` hold raw pointers, the elements are summed with the
+    // vectorized kernel for `active_simd_level()` and the sum added to
+    // `init`.  Such sums of floating point elements are reassociated, as by
+    // `std::reduce`, and so may differ in rounding from `std::accumulate`.
+
+template <typename ForwardIt>
+ForwardIt min_element(ForwardIt first, ForwardIt last);
+template <typename ForwardIt>
+ForwardIt max_element(ForwardIt first, ForwardIt last);
+    // Returns an iterator to the first smallest, respectively largest,
+    // element in the range `[first, last)`, or `last` if it is empty, as if
+    // by `std::min_element`, respectively `std::max_element`.
+    //
+    // If `ForwardIt` is an `any_iterator` whose `value_type` is `int`,
+    // `std::int64_t`, `float` or `double`, and both `first` and `last` hold
+    // raw pointers, the elements are searched with the vectorized kernel for
+    // `active_simd_level()`.
+
+template <typename InputIt1, typename InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2);
+    // Returns whether the elements in the range `[first1, last1)` are equal
+    // to those in the range beginning at `first2`, as if by `std::equal`.
+    //
+    // If `InputIt1` is an `any_iterator` and both `first1` and `last1` hold
+    // raw pointers, the elements are compared without any dispatch on that
+    // range, nor on the second if `first2` also holds a raw pointer.
+
+template <typename InputIt, typename UnaryFunction>
+UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction f);
+    // Applies `f` to each of the elements in the range `[first, last)`, in
+    // order, and returns `f`, as if by `std::for_each`.
+    //
+    // If `InputIt` is an `any_iterator` and both `first` and `last` hold
+    // raw pointers, `f` is applied to the elements without any dispatch, and
+    // otherwise it is applied inside a single dispatch to the underlying
+    // iterator, by `for_each_until`.
+
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(InputIt first, InputIt last, OutputIt d_first,
+                   UnaryOperation op);
+    // Applies `op` to each of the elements in the range `[first, last)` and
+    // writes the results to the range beginning at `d_first`, returning an
+    // iterator one past the last element written, as if by `std::transform`.
+    //
+    // If `InputIt` is an `any_iterator` whose `reference` is a value, rather
+    // than a reference, and whose `value_type` is default constructible, the
+    // elements are read from its underlying iterator in batches with a
+    // single dispatch per batch, and each is passed to `op` as an rvalue, as
+    // it would be by `std::transform`.  Otherwise, if `InputIt` is an
+    // `any_iterator`, `op` is applied to each `reference` inside a single
+    // dispatch to the underlying iterator, by `for_each_until`, so that an
+    // `op` taking its argument by non-`const` reference may modify it.
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+template <typename Iterator>
+inline typename Iterator::pointer* unwrap(Iterator& it) noexcept
+{
+    static_assert(is_unwrappable_v<Iterator>);
+    return it.template target<typename Iterator::pointer>();
+}
+
+} // close namespace detail
+
+template <typename InputIt, typename OutputIt>
+inline OutputIt copy(InputIt first, InputIt last, OutputIt d_first)
+{
+    using ValueType = std::remove_cv_t<
+        typename std::iterator_traits<InputIt>::value_type>;
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    constexpr bool isBulkWritable =
+        detail::is_bulk_writable_v<OutputIt, ValueType>;
+
+    if constexpr (detail::is_unwrappable_v<InputIt>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            if constexpr (detail::is_unwrappable_v<OutputIt>) {
+                if (auto* const output = detail::unwrap(d_first)) {
+                    *output = std::copy(*cursor, *end, *output);
+                    return d_first;
+                }
+            } else if constexpr (isBulkWritable) {
+                d_first.write_n(*cursor,
+                                static_cast<std::size_t>(*end - *cursor));
+                return d_first;
+            }
+            return std::copy(*cursor, *end, std::move(d_first));
+        }
+    }
+
+    if constexpr (isBulkWritable) {
+        if constexpr (std::contiguous_iterator<InputIt>) {
+            d_first.write_n(std::to_address(first),
+                            static_cast<std::size_t>(last - first));
+            return d_first;
+        } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                               Category>) {
+            d_first.reserve_hint(static_cast<std::size_t>(last - first));
+        }
+    }
+
+    if constexpr (detail::is_bulk_readable_v<InputIt>) {
+        constexpr std::size_t batchSize = detail::bulkReadCount<ValueType>;
+
+        ValueType batch[batchSize];
+        while (const std::size_t n = first.read(batch, batchSize, last)) {
+            if constexpr (isBulkWritable &&
+                          std::is_trivially_copyable_v<ValueType>) {
+                d_first.write_n(batch, n);
+            } else {
+                for (std::size_t i = 0; i != n; ++i, ++d_first) {
+                    *d_first = std::move(batch[i]);
+                }
+            }
+        }
+        return d_first;
+    } else {
+        return std::copy(std::move(first), std::move(last),
+                         std::move(d_first));
+    }
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+inline OutputIt transform(InputIt first, InputIt last, OutputIt d_first,
+                          UnaryOperation op)
+{
+    using Reference = typename std::iterator_traits<InputIt>::reference;
+    if constexpr (detail::is_bulk_readable_v<InputIt> &&
+                  !std::is_reference_v<Reference>) {
+        using ValueType = std::remove_cv_t<
+            typename std::iterator_traits<InputIt>::value_type>;
+        constexpr std::size_t batchSize = detail::bulkReadCount<ValueType>;
+
+        ValueType batch[batchSize];
+        while (const std::size_t n = first.read(batch, batchSize, last)) {
+            for (std::size_t i = 0; i != n; ++i, ++d_first) {
+                *d_first = op(std::move(batch[i]));
+            }
+        }
+        return d_first;
+    } else if constexpr (detail::is_visitable_v<InputIt>) {
+        first.for_each_until(last, [&d_first, &op](auto&& element) {
+            *d_first = op(std::forward<decltype(element)>(element));
+            ++d_first;
+            return false;
+        });
+        return d_first;
+    } else {
+        return std::transform(std::move(first), std::move(last),
+                              std::move(d_first), std::move(op));
+    }
+}
+
+template <typename InputIt, typename T>
+inline InputIt find(InputIt first, InputIt last, const T& value)
+{
+    if constexpr (detail::is_unwrappable_v<InputIt>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            using ValueType = std::remove_cv_t<
+                typename std::iterator_traits<InputIt>::value_type>;
+            if constexpr (detail::is_reducible_v<InputIt> &&
+                          std::is_same_v<T, ValueType>) {
+                *cursor += detail::reductionKernels<ValueType>().find(
+                    *cursor, *end, value) - *cursor;
+            } else {
+                *cursor = std::find(*cursor, *end, value);
+            }
+            return first;
+        }
+    }
+
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        first.for_each_until(last, [&value](auto&& element) {
+            return element == value;
+        });
+        return first;
+    } else {
+        return std::find(std::move(first), std::move(last), value);
+    }
+}
+
+template <typename InputIt, typename T>
+inline typename std::iterator_traits<InputIt>::difference_type
+count(InputIt first, InputIt last, const T& value)
+{
+    using ValueType = std::remove_cv_t<
+        typename std::iterator_traits<InputIt>::value_type>;
+    if constexpr (detail::is_reducible_v<InputIt> &&
+                  std::is_same_v<T, ValueType>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            return detail::reductionKernels<ValueType>().count(*cursor, *end,
+                                                               value);
+        }
+    }
+
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        return sample::count_if(std::move(first), std::move(last),
+                                [&value](auto&& element) {
+                                    return element == value;
+                                });
+    } else {
+        return std::count(std::move(first), std::move(last), value);
+    }
+}
+
+template <typename InputIt, typename UnaryPredicate>
+inline InputIt find_if(InputIt first, InputIt last, UnaryPredicate p)
+{
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        first.for_each_until(last, p);
+        return first;
+    } else {
+        return std::find_if(std::move(first), std::move(last), std::move(p));
+    }
+}
+
+template <typename InputIt, typename UnaryPredicate>
+inline typename std::iterator_traits<InputIt>::difference_type
+count_if(InputIt first, InputIt last, UnaryPredicate p)
+{
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        typename std::iterator_traits<InputIt>::difference_type count = 0;
+        first.for_each_until(last, [&p, &count](auto&& element) {
+            if (p(std::forward<decltype(element)>(element))) {
+                ++count;
+            }
+            return false;
+        });
+        return count;
+    } else {
+        return std::count_if(std::move(first), std::move(last), std::move(p));
+    }
+}
+
+template <typename InputIt, typename T>
+inline T accumulate(InputIt first, InputIt last, T init)
+{
+    if constexpr (detail::is_reducible_v<InputIt> &&
+                  std::is_same_v<T, std::remove_cv_t<typename
+                      std::iterator_traits<InputIt>::value_type>>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            return init + detail::reductionKernels<T>().sum(*cursor, *end);
+        }
+    }
+    return sample::accumulate(std::move(first), std::move(last),
+                              std::move(init), std::plus<>());
+}
+
+template <typename InputIt, typename T, typename BinaryOperation>
+inline T accumulate(InputIt first, InputIt last, T init, BinaryOperation op)
+{
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        first.for_each_until(last, [&init, &op](auto&& element) {
+            init = op(std::move(init),
+                      std::forward<decltype(element)>(element));
+            return false;
+        });
+        return init;
+    } else {
+        return std::accumulate(std::move(first), std::move(last),
+                               std::move(init), std::move(op));
+    }
+}
+
+template <typename ForwardIt>
+inline ForwardIt min_element(ForwardIt first, ForwardIt last)
+{
+    if constexpr (detail::is_reducible_v<ForwardIt>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            using ValueType = std::remove_cv_t<
+                typename std::iterator_traits<ForwardIt>::value_type>;
+            *cursor += detail::reductionKernels<ValueType>().minElement(
+                *cursor, *end) - *cursor;
+            return first;
+        }
+    }
+    return std::min_element(std::move(first), std::move(last));
+}
+
+template <typename ForwardIt>
+inline ForwardIt max_element(ForwardIt first, ForwardIt last)
+{
+    if constexpr (detail::is_reducible_v<ForwardIt>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            using ValueType = std::remove_cv_t<
+                typename std::iterator_traits<ForwardIt>::value_type>;
+            *cursor += detail::reductionKernels<ValueType>().maxElement(
+                *cursor, *end) - *cursor;
+            return first;
+        }
+    }
+    return std::max_element(std::move(first), std::move(last));
+}
+
+template <typename InputIt1, typename InputIt2>
+inline bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+{
+    if constexpr (detail::is_unwrappable_v<InputIt1>) {
+        auto* const cursor = detail::unwrap(first1);
+        auto* const end = detail::unwrap(last1);
+        if (cursor && end) {
+            if constexpr (detail::is_unwrappable_v<InputIt2>) {
+                if (auto* const cursor2 = detail::unwrap(first2)) {
+                    return std::equal(*cursor, *end, *cursor2);
+                }
+            }
+            return std::equal(*cursor, *end, std::move(first2));
+        }
+    }
+    return std::equal(std::move(first1), std::move(last1), std::move(first2));
+}
+
+template <typename InputIt, typename UnaryFunction>
+inline UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction f)
+{
+    if constexpr (detail::is_unwrappable_v<InputIt>) {
+        auto* const cursor = detail::unwrap(first);
+        auto* const end = detail::unwrap(last);
+        if (cursor && end) {
+            return std::for_each(*cursor, *end, std::move(f));
+        }
+    }
+
+    if constexpr (detail::is_visitable_v<InputIt>) {
+        first.for_each_until(last, [&f](auto&& element) {
+            f(std::forward<decltype(element)>(element));
+            return false;
+        });
+        return f;
+    } else {
+        return std::for_each(std::move(first), std::move(last), std::move(f));
+    }
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_ALGORITHM
@@ -3,42 +3,65 @@
 
 #include <sample_anyforwarditerator_base.hpp>
 
+#include <cassert>
+#include <cstdlib>
+#include <type_traits>
+
 namespace sample::detail {
 
 template <typename ValueType, typename Reference, typename Pointer>
-struct AnyBidirectionalIterator_Base : AnyForwardIterator_Base<ValueType, Reference, Pointer>
+struct AnyBidirectionalIterator_VTable
+    : AnyForwardIterator_VTable<ValueType, Reference, Pointer>
 {
-    // MUTATORS
-    virtual AnyBidirectionalIterator_Base& operator--() = 0;
+    // DATA
+    void (*decrement)(AnyIterator_Base& self);
+        // Decrement the underlying iterator of `self`.
 };
 
 template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
-struct AnyBidirectionalIterator_Impl final : AnyBidirectionalIterator_Base<ValueType, 
-    Reference, Pointer>
+struct AnyBidirectionalIterator_Impl final : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
+    using VTable = AnyBidirectionalIterator_VTable<ValueType, Reference, Pointer>;
 
     // CREATORS
     AnyBidirectionalIterator_Impl(BiDirIt it)
         noexcept(std::is_nothrow_copy_constructible_v<BiDirIt>);
 
-    // ACCESSORS
-    const void* base() const noexcept override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+
+    static reference dereference(const AnyIterator_Base& self);
+    static pointer arrow(const AnyIterator_Base& self);
 
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
+    static void increment(AnyIterator_Base& self);
+    static void decrement(AnyIterator_Base& self);
 
-    reference operator*() const override;
-    pointer operator->() const override;
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
 
-    // MANIPULATORS
-    void* base() noexcept override;
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
 
-    AnyBidirectionalIterator_Impl& operator++() override;
-    AnyBidirectionalIterator_Impl& operator--() override;
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {{&AnyBidirectionalIterator_Impl::base,
+          &AnyBidirectionalIterator_Impl::increment,
+          type_token::of<BiDirIt>()},
+         &AnyBidirectionalIterator_Impl::equal,
+         &AnyBidirectionalIterator_Impl::dereference,
+         &AnyBidirectionalIterator_Impl::arrow,
+         readEntry<AnyBidirectionalIterator_Impl, ValueType, Reference>(),
+         &AnyBidirectionalIterator_Impl::forEachUntil},
+        &AnyBidirectionalIterator_Impl::decrement
+    };
 
 private:
     // DATA
@@ -47,162 +70,186 @@ private:
 
 template <typename ValueType, typename Reference, typename Pointer>
 struct AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer> final
-    : AnyBidirectionalIterator_Base<ValueType, Reference, Pointer>
+    : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
+    using VTable = AnyBidirectionalIterator_VTable<ValueType, Reference, Pointer>;
 
     // CREATORS
     constexpr AnyBidirectionalIterator_Impl() noexcept = default;
 
-    // ACCESSORS
-    const void* base() const noexcept override;
-
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
-
-    reference operator*() const override;
-    pointer operator->() const override;
-
-    // MANIPULATORS
-    void* base() noexcept override;
-
-    AnyBidirectionalIterator_Impl& operator++() override;
-    AnyBidirectionalIterator_Impl& operator--() override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+
+    [[noreturn]] static reference dereference(const AnyIterator_Base& self);
+    [[noreturn]] static pointer arrow(const AnyIterator_Base& self);
+
+    [[noreturn]] static void increment(AnyIterator_Base& self);
+    [[noreturn]] static void decrement(AnyIterator_Base& self);
+
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
+
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {{&AnyBidirectionalIterator_Impl::base,
+          &AnyBidirectionalIterator_Impl::increment,
+          type_token::of<void>()},
+         &AnyBidirectionalIterator_Impl::equal,
+         &AnyBidirectionalIterator_Impl::dereference,
+         &AnyBidirectionalIterator_Impl::arrow,
+         &AnyBidirectionalIterator_Impl::read,
+         &AnyBidirectionalIterator_Impl::forEachUntil},
+        &AnyBidirectionalIterator_Impl::decrement
+    };
 };
 
 // ===========================================================================
 //      INLINE DEFINITIONS
 // ===========================================================================
 // CREATORS
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::AnyBidirectionalIterator_Impl(
-    FwdIt it) noexcept(std::is_nothrow_copy_constructible_v<FwdIt>) 
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::AnyBidirectionalIterator_Impl(
+    BiDirIt it) noexcept(std::is_nothrow_copy_constructible_v<BiDirIt>)
     : d_it(it)
 {}
 
-// ACCESSORS
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline const void* AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::base()
-    const noexcept
+// CLASS METHODS
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline void* AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::base(
+    AnyIterator_Base& self) noexcept
 {
-    return static_cast<const void*>(&d_it);
+    return static_cast<void*>(&static_cast<AnyBidirectionalIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline const void* AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::base()
-    const noexcept
+inline void* AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::base(
+    AnyIterator_Base&) noexcept
 {
     return nullptr;
 }
 
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline bool AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator==(
-    const AnyIterator_Base& rhs) const
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline bool AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::equal(
+    const AnyIterator_Base& lhs, const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyBidirectionalIterator_Impl*>(&rhs));
-    const AnyBidirectionalIterator_Impl* const ptr = static_cast<const AnyBidirectionalIterator_Impl*>(&rhs);
-    return d_it == ptr->d_it;
+    return static_cast<const AnyBidirectionalIterator_Impl&>(lhs).d_it ==
+        static_cast<const AnyBidirectionalIterator_Impl&>(rhs).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline bool AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator==(
-    const AnyIterator_Base& rhs) const
+inline bool AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::equal(
+    const AnyIterator_Base&, const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyBidirectionalIterator_Impl*>(&rhs));
     return true;
 }
 
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline bool AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator!=(
-    const AnyIterator_Base& rhs) const
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline typename AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::reference
+    AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::dereference(
+        const AnyIterator_Base& self)
 {
-    assert(dynamic_cast<const AnyBidirectionalIterator_Impl*>(&rhs));
-    const AnyBidirectionalIterator_Impl* const ptr = static_cast<const AnyBidirectionalIterator_Impl*>(&rhs);
-    return d_it != ptr->d_it;
+    return *static_cast<const AnyBidirectionalIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline bool AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator!=(
-    const AnyIterator_Base& rhs) const
+inline typename AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::reference
+    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::dereference(
+        const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyBidirectionalIterator_Impl*>(&rhs));
-    return false;
+    assert(false && "Cannot dereference a default constructed BidirectionalIterator");
+    std::abort();
 }
 
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline typename AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::reference
-    AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator*() const
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline typename AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::pointer
+    AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::arrow(
+        const AnyIterator_Base& self)
 {
-    return *d_it;
+    return std::addressof(*static_cast<const AnyBidirectionalIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline typename AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::reference
-    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator*() const
+inline typename AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::pointer
+    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::arrow(
+        const AnyIterator_Base&)
 {
     assert(false && "Cannot dereference a default constructed BidirectionalIterator");
+    std::abort();
 }
 
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline typename AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::pointer
-    AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator->() const
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline void AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::increment(
+    AnyIterator_Base& self)
 {
-    return std::addressof(*d_it);
+    ++static_cast<AnyBidirectionalIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline typename AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::pointer
-    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator->() const
+inline void AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::increment(
+    AnyIterator_Base&)
 {
-    assert(false && "Cannot dereference a default constructed BidirectionalIterator");
+    assert(false && "Cannot increment a default constructed BidirectionalIterator");
+    std::abort();
 }
 
-// MANIPULATORS
-template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline void* AnyBidirectionalIterator_Impl<FwdIt, ValueType, Reference, Pointer>::base()
-    noexcept
+template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
+inline void AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::decrement(
+    AnyIterator_Base& self)
 {
-    return static_cast<void*>(&d_it);
+    --static_cast<AnyBidirectionalIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline void* AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::base()
-    noexcept
+inline void AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::decrement(
+    AnyIterator_Base&)
 {
-    return nullptr;
+    assert(false && "Cannot decrement a default constructed BidirectionalIterator");
+    std::abort();
 }
 
 template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
-inline AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>&
-    AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::operator++()
+inline std::size_t AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::read(
+    AnyIterator_Base& self, std::remove_cv_t<value_type>* output, std::size_t count,
+    const AnyIterator_Base& last)
 {
-    ++d_it;
-    return *this;
+    return bulkRead<Reference>(static_cast<AnyBidirectionalIterator_Impl&>(self).d_it,
+                               static_cast<const AnyBidirectionalIterator_Impl&>(last).d_it,
+                               output, count);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>&
-    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator++()
+inline std::size_t AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::read(
+    AnyIterator_Base&, std::remove_cv_t<value_type>*, std::size_t, const AnyIterator_Base&)
 {
-    assert(false && "Cannot increment a default constructed BidirectionalIterator");
+    return 0;
 }
 
 template <typename BiDirIt, typename ValueType, typename Reference, typename Pointer>
-inline AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>&
-    AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::operator--()
+inline bool AnyBidirectionalIterator_Impl<BiDirIt, ValueType, Reference, Pointer>::forEachUntil(
+    AnyIterator_Base& self, const AnyIterator_Base& last,
+    AnyIterator_Visitor<reference> visitor)
 {
-    --d_it;
-    return *this;
+    return visitUntil(static_cast<AnyBidirectionalIterator_Impl&>(self).d_it,
+                      static_cast<const AnyBidirectionalIterator_Impl&>(last).d_it,
+                      visitor);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>&
-    AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::operator--()
+inline bool AnyBidirectionalIterator_Impl<void, ValueType, Reference, Pointer>::forEachUntil(
+    AnyIterator_Base&, const AnyIterator_Base&, AnyIterator_Visitor<reference>)
 {
-    assert(false && "Cannot decrement a default constructed BidirectionalIterator");
+    return false;
 }
 
 } // close namespace sample::detail
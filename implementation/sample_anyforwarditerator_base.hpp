@@ -4,39 +4,59 @@
 #include <sample_anyinputiterator_base.hpp>
 
 #include <cassert>
+#include <cstdlib>
 #include <type_traits>
 
 namespace sample::detail {
 
 template <typename ValueType, typename Reference, typename Pointer>
-struct AnyForwardIterator_Base : AnyInputIterator_Base<ValueType, Reference, Pointer> 
-{};
+using AnyForwardIterator_VTable
+    = AnyInputIterator_VTable<ValueType, Reference, Pointer>;
+    // Forward iterators provide no operations beyond those of input
+    // iterators, only stronger guarantees about them.
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-struct AnyForwardIterator_Impl final : AnyForwardIterator_Base<ValueType, Reference, Pointer>
+struct AnyForwardIterator_Impl final : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
+    using VTable = AnyForwardIterator_VTable<ValueType, Reference, Pointer>;
 
     // CREATORS
     AnyForwardIterator_Impl(FwdIt it)
         noexcept(std::is_nothrow_copy_constructible_v<FwdIt>);
 
-    // ACCESSORS
-    const void* base() const noexcept override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
 
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
 
-    reference operator*() const override;
-    pointer operator->() const override;
+    static reference dereference(const AnyIterator_Base& self);
+    static pointer arrow(const AnyIterator_Base& self);
 
-    // MANIPULATORS
-    void* base() noexcept override;
+    static void increment(AnyIterator_Base& self);
 
-    AnyForwardIterator_Impl& operator++() override;
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
+
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {&AnyForwardIterator_Impl::base,
+         &AnyForwardIterator_Impl::increment,
+         type_token::of<FwdIt>()},
+        &AnyForwardIterator_Impl::equal,
+        &AnyForwardIterator_Impl::dereference,
+        &AnyForwardIterator_Impl::arrow,
+        readEntry<AnyForwardIterator_Impl, ValueType, Reference>(),
+        &AnyForwardIterator_Impl::forEachUntil
+    };
 
 private:
     // DATA
@@ -44,30 +64,47 @@ private:
 };
 
 template <typename ValueType, typename Reference, typename Pointer>
-struct AnyForwardIterator_Impl<void, ValueType, Reference, Pointer> final 
-    : AnyForwardIterator_Base<ValueType, Reference, Pointer>
+struct AnyForwardIterator_Impl<void, ValueType, Reference, Pointer> final
+    : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
+    using VTable = AnyForwardIterator_VTable<ValueType, Reference, Pointer>;
 
     // CREATORS
     constexpr AnyForwardIterator_Impl() noexcept = default;
 
-    // ACCESSORS
-    const void* base() const noexcept override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
 
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
+    [[noreturn]] static reference dereference(const AnyIterator_Base& self);
+    [[noreturn]] static pointer arrow(const AnyIterator_Base& self);
 
-    [[noreturn]] reference operator*() const override;
-    [[noreturn]] pointer operator->() const override;
+    [[noreturn]] static void increment(AnyIterator_Base& self);
 
-    // MANIPULATORS
-    void* base() noexcept override;
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
 
-    [[noreturn]] AnyForwardIterator_Impl& operator++() override;
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {&AnyForwardIterator_Impl::base,
+         &AnyForwardIterator_Impl::increment,
+         type_token::of<void>()},
+        &AnyForwardIterator_Impl::equal,
+        &AnyForwardIterator_Impl::dereference,
+        &AnyForwardIterator_Impl::arrow,
+        &AnyForwardIterator_Impl::read,
+        &AnyForwardIterator_Impl::forEachUntil
+    };
 };
 
 // ===========================================================================
@@ -76,115 +113,121 @@ struct AnyForwardIterator_Impl<void, ValueType, Reference, Pointer> final
 // CREATORS
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
 inline AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::AnyForwardIterator_Impl(
-    FwdIt it) noexcept(std::is_nothrow_copy_constructible_v<FwdIt>) 
+    FwdIt it) noexcept(std::is_nothrow_copy_constructible_v<FwdIt>)
     : d_it(it)
 {}
 
-// ACCESSORS
+// CLASS METHODS
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline const void* AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::base()
-    const noexcept
+inline void* AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::base(
+    AnyIterator_Base& self) noexcept
 {
-    return static_cast<const void*>(&d_it);
+    return static_cast<void*>(&static_cast<AnyForwardIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline const void* AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::base() 
-    const noexcept
+inline void* AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::base(
+    AnyIterator_Base&) noexcept
 {
     return nullptr;
 }
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline bool AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator==(
-    const AnyIterator_Base& rhs) const
+inline bool AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::equal(
+    const AnyIterator_Base& lhs, const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyForwardIterator_Impl*>(&rhs));
-    const AnyForwardIterator_Impl* const ptr = static_cast<const AnyForwardIterator_Impl*>(&rhs);
-    return d_it == ptr->d_it;
+    return static_cast<const AnyForwardIterator_Impl&>(lhs).d_it ==
+        static_cast<const AnyForwardIterator_Impl&>(rhs).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline bool AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::operator==(
-    const AnyIterator_Base& rhs) const
+inline bool AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::equal(
+    const AnyIterator_Base&, const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyForwardIterator_Impl*>(&rhs));
     return true;
 }
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline bool AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator!=(
-    const AnyIterator_Base& rhs) const
+inline typename AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::reference
+    AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::dereference(
+        const AnyIterator_Base& self)
 {
-    assert(dynamic_cast<const AnyForwardIterator_Impl*>(&rhs));
-    const AnyForwardIterator_Impl* const ptr = static_cast<const AnyForwardIterator_Impl*>(&rhs);
-    return d_it != ptr->d_it;
+    return *static_cast<const AnyForwardIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline bool AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::operator!=(
-    const AnyIterator_Base& rhs) const
+inline typename AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::reference
+    AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::dereference(
+        const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyForwardIterator_Impl*>(&rhs));
-    return false;
+    assert(false && "Cannot dereference a default constructed ForwardIterator");
+    std::abort();
 }
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline typename AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::reference
-    AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator*() const
+inline typename AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::pointer
+    AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::arrow(
+        const AnyIterator_Base& self)
 {
-    return *d_it;
+    return std::addressof(*static_cast<const AnyForwardIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline typename AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::reference
-    AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::operator*() const
+inline typename AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::pointer
+    AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::arrow(
+        const AnyIterator_Base&)
 {
     assert(false && "Cannot dereference a default constructed ForwardIterator");
+    std::abort();
 }
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline typename AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::pointer
-    AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator->() const
+inline void AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::increment(
+    AnyIterator_Base& self)
 {
-    return std::addressof(*d_it);
+    ++static_cast<AnyForwardIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline typename AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::pointer
-    AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::operator->() const
+inline void AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::increment(
+    AnyIterator_Base&)
 {
-    assert(false && "Cannot dereference a default constructed ForwardIterator");
+    assert(false && "Cannot increment a default constructed ForwardIterator");
+    std::abort();
 }
 
-// MANIPULATORS
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline void* AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::base()
-    noexcept
+inline std::size_t AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::read(
+    AnyIterator_Base& self, std::remove_cv_t<value_type>* output, std::size_t count,
+    const AnyIterator_Base& last)
 {
-    return static_cast<void*>(&d_it);
+    return bulkRead<Reference>(static_cast<AnyForwardIterator_Impl&>(self).d_it,
+                               static_cast<const AnyForwardIterator_Impl&>(last).d_it,
+                               output, count);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline void* AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::base() 
-    noexcept
+inline std::size_t AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::read(
+    AnyIterator_Base&, std::remove_cv_t<value_type>*, std::size_t, const AnyIterator_Base&)
 {
-    return nullptr;
+    return 0;
 }
 
 template <typename FwdIt, typename ValueType, typename Reference, typename Pointer>
-inline AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>&
-    AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::operator++()
+inline bool AnyForwardIterator_Impl<FwdIt, ValueType, Reference, Pointer>::forEachUntil(
+    AnyIterator_Base& self, const AnyIterator_Base& last,
+    AnyIterator_Visitor<reference> visitor)
 {
-    ++d_it;
-    return *this;
+    return visitUntil(static_cast<AnyForwardIterator_Impl&>(self).d_it,
+                      static_cast<const AnyForwardIterator_Impl&>(last).d_it,
+                      visitor);
 }
 
 template <typename ValueType, typename Reference, typename Pointer>
-inline AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>&
-    AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::operator++()
+inline bool AnyForwardIterator_Impl<void, ValueType, Reference, Pointer>::forEachUntil(
+    AnyIterator_Base&, const AnyIterator_Base&, AnyIterator_Visitor<reference>)
 {
-    assert(false && "Cannot increment a default constructed ForwardIterator");
+    return false;
 }
 
 } // close namespace sample::detail
@@ -3,49 +3,143 @@
 
 #include <sample_anyiterator_base.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace sample::detail {
 
+template <typename Reference>
+struct AnyIterator_Visitor {
+    // A non-owning reference to a callable invoked with each element visited
+    // by `AnyInputIterator_VTable::forEachUntil`.  Calling it is a single
+    // indirect call, to a function instantiated for the type of the callable.
+
+    // CREATORS
+    template <typename Callable>
+    AnyIterator_Visitor(Callable& callable) noexcept;
+        // Construct an `AnyIterator_Visitor` referring to `callable`, which
+        // must outlive it.
+
+    // ACCESSORS
+    bool operator()(Reference value) const;
+        // Invoke the referenced callable with `value`, and return whether the
+        // visit should stop at this element.
+
+private:
+    // PRIVATE CLASS METHODS
+    template <typename Callable>
+    static bool call(void* callable, Reference value);
+
+private:
+    // DATA
+    void* d_callable;
+    bool (*d_call)(void* callable, Reference value);
+};
+
 template <typename ValueType, typename Reference = ValueType&,
           typename Pointer = ValueType*>
-struct AnyInputIterator_Base : AnyIterator_Base {
-    // ACCESSORS
-    virtual bool operator==(const AnyIterator_Base&) const = 0;
-    virtual bool operator!=(const AnyIterator_Base&) const = 0;
+struct AnyInputIterator_VTable : AnyIterator_VTable {
+    // DATA
+    bool (*equal)(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+        // Return whether the underlying iterators of `lhs` and `rhs`, which
+        // must be of the same type, compare equal.
+
+    Reference (*dereference)(const AnyIterator_Base& self);
+        // Return the result of dereferencing the underlying iterator of
+        // `self`.
 
-    virtual Reference operator*() const = 0;
-    virtual Pointer operator->() const = 0;
+    Pointer (*arrow)(const AnyIterator_Base& self);
+        // Return the address of the element referred to by the underlying
+        // iterator of `self`.
+
+    std::size_t (*read)(AnyIterator_Base& self,
+                        std::remove_cv_t<ValueType>* output,
+                        std::size_t count,
+                        const AnyIterator_Base& last);
+        // Assign up to `count` elements from the underlying iterator of
+        // `self` into `output`, stopping early at the underlying iterator of
+        // `last`, and return the number of elements assigned.
+
+    bool (*forEachUntil)(AnyIterator_Base& self, const AnyIterator_Base& last,
+                         AnyIterator_Visitor<Reference> visitor);
+        // Invoke `visitor` with each element from the underlying iterator of
+        // `self`, incrementing it after each, until `visitor` returns `true`
+        // or it compares equal to the underlying iterator of `last`.  Return
+        // whether `visitor` returned `true`, in which case the underlying
+        // iterator of `self` is left at the element for which it did.
 };
 
+template <typename Reference, typename InputIt, typename OutputType>
+std::size_t bulkRead(InputIt& it, const InputIt& last, OutputType* output,
+                     std::size_t count);
+    // Assign up to `count` elements from `it` into the array at `output`,
+    // incrementing `it` after each element and stopping early if `it`
+    // compares equal to `last`.  Return the number of elements assigned.
+    // Elements which cannot be assigned directly are converted to
+    // `Reference` first.  `OutputType` must be assignable from `Reference`.
+
+template <typename Impl, typename ValueType, typename Reference>
+constexpr auto readEntry() noexcept;
+    // Return `&Impl::read` if `ValueType` is assignable from `Reference`,
+    // and null otherwise, in which case `any_iterator::read` does not
+    // participate in overload resolution and `Impl::read` is never
+    // instantiated.
+
+template <typename InputIt, typename Visitor>
+bool visitUntil(InputIt& it, const InputIt& last, Visitor& visitor);
+    // Invoke `visitor` with each element from `it`, incrementing `it` after
+    // each, until `visitor` returns `true` or `it` compares equal to `last`.
+    // Return whether `visitor` returned `true`.
+
 template <typename InputIt, typename ValueType,
           typename Reference, typename Pointer>
-struct AnyInputIterator_Impl final 
-    : AnyInputIterator_Base<ValueType, Reference, Pointer>
-{ 
+struct AnyInputIterator_Impl final : AnyIterator_Base
+{
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
+    using VTable = AnyInputIterator_VTable<ValueType, Reference, Pointer>;
 
     // CREATORS
     AnyInputIterator_Impl(InputIt it)
         noexcept(std::is_nothrow_copy_constructible_v<InputIt>);
 
-    // ACCESSORS
-    const void* base() const noexcept override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
 
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
+    static bool equal(const AnyIterator_Base& lhs,
+                      const AnyIterator_Base& rhs);
 
-    reference operator*() const override;
-    pointer operator->() const override;
+    static reference dereference(const AnyIterator_Base& self);
+    static pointer arrow(const AnyIterator_Base& self);
 
-    // MANIPULATORS
-    void* base() noexcept override;
+    static void increment(AnyIterator_Base& self);
 
-    AnyInputIterator_Impl& operator++() override;
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
+
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {&AnyInputIterator_Impl::base,
+         &AnyInputIterator_Impl::increment,
+         type_token::of<InputIt>()},
+        &AnyInputIterator_Impl::equal,
+        &AnyInputIterator_Impl::dereference,
+        &AnyInputIterator_Impl::arrow,
+        readEntry<AnyInputIterator_Impl, ValueType, Reference>(),
+        &AnyInputIterator_Impl::forEachUntil
+    };
 
 private:
     // DATA
@@ -56,80 +150,161 @@ private:
 //      INLINE DEFINITIONS
 // ===========================================================================
 // CREATORS
-template <typename InputIt, typename ValueType, typename Reference, 
+template <typename Reference>
+template <typename Callable>
+inline AnyIterator_Visitor<Reference>::AnyIterator_Visitor(Callable& callable)
+    noexcept
+    : d_callable(const_cast<void*>(
+        static_cast<const void*>(std::addressof(callable))))
+    , d_call(&AnyIterator_Visitor::call<Callable>)
+{}
+
+// ACCESSORS
+template <typename Reference>
+inline bool AnyIterator_Visitor<Reference>::operator()(Reference value) const
+{
+    return d_call(d_callable, std::forward<Reference>(value));
+}
+
+// PRIVATE CLASS METHODS
+template <typename Reference>
+template <typename Callable>
+inline bool AnyIterator_Visitor<Reference>::call(void* callable,
+                                                 Reference value)
+{
+    return static_cast<bool>(
+        (*static_cast<Callable*>(callable))(std::forward<Reference>(value)));
+}
+
+// FREE FUNCTIONS
+template <typename Reference, typename InputIt, typename OutputType>
+inline std::size_t bulkRead(InputIt& it, const InputIt& last,
+                            OutputType* output, std::size_t count)
+{
+    static_assert(std::is_assignable_v<OutputType&, Reference>,
+        "Cannot bulk read into a value_type not assignable from reference");
+
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (!std::is_assignable_v<OutputType&, decltype(*it)>) {
+        std::size_t n = 0;
+        for (; n != count && it != last; ++n, ++it) {
+            output[n] = static_cast<Reference>(*it);
+        }
+        return n;
+    } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                           Category>) {
+        const std::size_t n = std::min(count,
+            static_cast<std::size_t>(last - it));
+        std::copy_n(it, n, output);
+        it += static_cast<
+            typename std::iterator_traits<InputIt>::difference_type>(n);
+        return n;
+    } else {
+        std::size_t n = 0;
+        for (; n != count && it != last; ++n, ++it) {
+            output[n] = *it;
+        }
+        return n;
+    }
+}
+
+template <typename Impl, typename ValueType, typename Reference>
+inline constexpr auto readEntry() noexcept
+{
+    using Function = std::size_t (*)(AnyIterator_Base&,
+        std::remove_cv_t<ValueType>*, std::size_t, const AnyIterator_Base&);
+    if constexpr (std::is_assignable_v<std::remove_cv_t<ValueType>&,
+                                       Reference>) {
+        return Function(&Impl::read);
+    } else {
+        return Function(nullptr);
+    }
+}
+
+template <typename InputIt, typename Visitor>
+inline bool visitUntil(InputIt& it, const InputIt& last, Visitor& visitor)
+{
+    for (; it != last; ++it) {
+        if (visitor(*it)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// CREATORS
+template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline AnyInputIterator_Impl<InputIt, ValueType, 
+inline AnyInputIterator_Impl<InputIt, ValueType,
     Reference, Pointer>::AnyInputIterator_Impl(InputIt it)
     noexcept(std::is_nothrow_copy_constructible_v<InputIt>)
     : d_it(it)
 {}
 
-// ACCESSORS
+// CLASS METHODS
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline const void* AnyInputIterator_Impl<InputIt, ValueType, Reference,
-    Pointer>::base() const noexcept
+inline void* AnyInputIterator_Impl<InputIt, ValueType, Reference,
+    Pointer>::base(AnyIterator_Base& self) noexcept
 {
-    return static_cast<const void*>(&d_it);
+    return static_cast<void*>(&static_cast<AnyInputIterator_Impl&>(self).d_it);
 }
 
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
 inline bool AnyInputIterator_Impl<InputIt, ValueType, Reference,
-    Pointer>::operator==(const AnyIterator_Base& rhs) const
+    Pointer>::equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyInputIterator_Impl*>(&rhs));
-    const AnyInputIterator_Impl* const ptr 
-        = static_cast<const AnyInputIterator_Impl*>(&rhs);
-    return d_it == ptr->d_it;
+    return static_cast<const AnyInputIterator_Impl&>(lhs).d_it ==
+        static_cast<const AnyInputIterator_Impl&>(rhs).d_it;
 }
 
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline bool AnyInputIterator_Impl<InputIt, ValueType, Reference,
-    Pointer>::operator!=(const AnyIterator_Base& rhs) const
+inline typename AnyInputIterator_Impl<InputIt, ValueType,
+    Reference, Pointer>::reference AnyInputIterator_Impl<InputIt,
+    ValueType, Reference, Pointer>::dereference(const AnyIterator_Base& self)
 {
-    assert(dynamic_cast<const AnyInputIterator_Impl*>(&rhs));
-    const AnyInputIterator_Impl* const ptr
-        = static_cast<const AnyInputIterator_Impl*>(&rhs);
-    return d_it != ptr->d_it;
+    return *static_cast<const AnyInputIterator_Impl&>(self).d_it;
 }
 
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
 inline typename AnyInputIterator_Impl<InputIt, ValueType,
-    Reference, Pointer>::reference AnyInputIterator_Impl<InputIt,
-    ValueType, Reference, Pointer>::operator*() const 
+    Reference, Pointer>::pointer AnyInputIterator_Impl<InputIt,
+    ValueType, Reference, Pointer>::arrow(const AnyIterator_Base& self)
 {
-    return *d_it;
+    return std::addressof(*static_cast<const AnyInputIterator_Impl&>(self).d_it);
 }
 
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline typename AnyInputIterator_Impl<InputIt, ValueType,
-    Reference, Pointer>::pointer AnyInputIterator_Impl<InputIt,
-    ValueType, Reference, Pointer>::operator->() const
+inline void AnyInputIterator_Impl<InputIt, ValueType, Reference,
+    Pointer>::increment(AnyIterator_Base& self)
 {
-    return std::addressof(*d_it);
+    ++static_cast<AnyInputIterator_Impl&>(self).d_it;
 }
 
-// MANIPULATORS
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline void* AnyInputIterator_Impl<InputIt, ValueType, Reference,
-    Pointer>::base() noexcept
+inline std::size_t AnyInputIterator_Impl<InputIt, ValueType, Reference,
+    Pointer>::read(AnyIterator_Base& self,
+                   std::remove_cv_t<value_type>* output, std::size_t count,
+                   const AnyIterator_Base& last)
 {
-    return static_cast<void*>(&d_it);
+    return bulkRead<Reference>(static_cast<AnyInputIterator_Impl&>(self).d_it,
+        static_cast<const AnyInputIterator_Impl&>(last).d_it, output, count);
 }
 
 template <typename InputIt, typename ValueType, typename Reference,
           typename Pointer>
-inline AnyInputIterator_Impl<InputIt, ValueType, Reference,
-    Pointer>& AnyInputIterator_Impl<InputIt, ValueType,
-    Reference, Pointer>::operator++()
+inline bool AnyInputIterator_Impl<InputIt, ValueType, Reference,
+    Pointer>::forEachUntil(AnyIterator_Base& self, const AnyIterator_Base& last,
+                           AnyIterator_Visitor<reference> visitor)
 {
-    ++d_it;
-    return *this;
+    return visitUntil(static_cast<AnyInputIterator_Impl&>(self).d_it,
+                      static_cast<const AnyInputIterator_Impl&>(last).d_it,
+                      visitor);
 }
 
 } // close namespace sample::detail
@@ -8,60 +8,120 @@
 #include <sample_anybidirectionaliterator_base.hpp>
 #include <sample_anyrandomaccessiterator_base.hpp>
 #include <sample_smallbuffer.hpp>
+#include <sample_stats.hpp>
+#include <sample_storagepolicy.hpp>
+#include <sample_typetoken.hpp>
 #include <sample_util.hpp>
 
 #include <cstddef>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <type_traits>
+#include <utility>
 
 namespace sample {
+namespace detail {
+
+template <typename IteratorCategory, typename ValueType, typename Reference,
+          typename Pointer, typename DifferenceType>
+using AnyIterator_VTableFor = std::conditional_t<
+    std::is_base_of_v<std::random_access_iterator_tag, IteratorCategory>,
+    AnyRandomAccessIterator_VTable<ValueType, Reference, Pointer,
+        DifferenceType>,
+    std::conditional_t<
+        std::is_base_of_v<std::bidirectional_iterator_tag, IteratorCategory>,
+        AnyBidirectionalIterator_VTable<ValueType, Reference, Pointer>,
+        std::conditional_t<
+            std::is_base_of_v<std::input_iterator_tag, IteratorCategory>,
+            AnyInputIterator_VTable<ValueType, Reference, Pointer>,
+            AnyOutputIterator_VTable<ValueType>>>>;
+    // The table of operations that an `any_iterator` of `IteratorCategory`
+    // dispatches through.
+
+template <typename IteratorCategory, typename It, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType>
+using AnyIterator_ImplFor = std::conditional_t<
+    std::is_base_of_v<std::random_access_iterator_tag, IteratorCategory>,
+    AnyRandomAccessIterator_Impl<It, ValueType, Reference, Pointer,
+        DifferenceType>,
+    std::conditional_t<
+        std::is_base_of_v<std::bidirectional_iterator_tag, IteratorCategory>,
+        AnyBidirectionalIterator_Impl<It, ValueType, Reference, Pointer>,
+        std::conditional_t<
+            std::is_base_of_v<std::forward_iterator_tag, IteratorCategory>,
+            AnyForwardIterator_Impl<It, ValueType, Reference, Pointer>,
+            std::conditional_t<
+                std::is_base_of_v<std::input_iterator_tag, IteratorCategory>,
+                AnyInputIterator_Impl<It, ValueType, Reference, Pointer>,
+                AnyOutputIterator_Impl<It, ValueType>>>>>;
+    // The object in which an `any_iterator` of `IteratorCategory` holds an
+    // `It` which is not stored as a pointer.
+
+} // close namespace detail
+
 template <typename IteratorCategory, 
           typename ValueType,
           typename ReferenceType = ValueType&,
           typename PointerType = ValueType*,
-          typename DifferenceType = std::ptrdiff_t>
+          typename DifferenceType = std::ptrdiff_t,
+          typename StoragePolicy = default_storage>
 struct any_iterator;
 
+template <typename AnyIterator>
+struct any_sentinel;
+
+template <typename It, typename AnyIterator>
+struct inline_fit;
+
+template <typename AnyIterator, typename... Its>
+struct sizing_report;
+
 inline namespace {
     template <typename ValueType, 
             typename ReferenceType = ValueType&,
             typename PointerType = ValueType*, 
-            typename DifferenceType = std::ptrdiff_t>
+            typename DifferenceType = std::ptrdiff_t,
+            typename StoragePolicy = default_storage>
     using any_input_iterator = any_iterator<std::input_iterator_tag, ValueType,
-        ReferenceType, PointerType, DifferenceType>;
+        ReferenceType, PointerType, DifferenceType, StoragePolicy>;
 
     template <typename ValueType, 
             typename ReferenceType = ValueType&,
             typename PointerType = ValueType*, 
-            typename DifferenceType = std::ptrdiff_t>
+            typename DifferenceType = std::ptrdiff_t,
+            typename StoragePolicy = default_storage>
     using any_output_iterator = any_iterator<std::output_iterator_tag, ValueType,
-        ReferenceType, PointerType, DifferenceType>;
+        ReferenceType, PointerType, DifferenceType, StoragePolicy>;
 
     template <typename ValueType, 
             typename ReferenceType = ValueType&,
             typename PointerType = ValueType*, 
-            typename DifferenceType = std::ptrdiff_t>
+            typename DifferenceType = std::ptrdiff_t,
+            typename StoragePolicy = default_storage>
     using any_forward_iterator = any_iterator<std::forward_iterator_tag, ValueType,
-        ReferenceType, PointerType, DifferenceType>;
+        ReferenceType, PointerType, DifferenceType, StoragePolicy>;
 
     template <typename ValueType, 
             typename ReferenceType = ValueType&,
             typename PointerType = ValueType*, 
-            typename DifferenceType = std::ptrdiff_t>
+            typename DifferenceType = std::ptrdiff_t,
+            typename StoragePolicy = default_storage>
     using any_bidirectional_iterator = any_iterator<std::bidirectional_iterator_tag, 
-        ValueType, ReferenceType, PointerType, DifferenceType>;
+        ValueType, ReferenceType, PointerType, DifferenceType, StoragePolicy>;
 
     template <typename ValueType, 
             typename ReferenceType = ValueType&,
             typename PointerType = ValueType*, 
-            typename DifferenceType = std::ptrdiff_t>
+            typename DifferenceType = std::ptrdiff_t,
+            typename StoragePolicy = default_storage>
     using any_random_access_iterator = any_iterator<std::random_access_iterator_tag, 
-        ValueType, ReferenceType, PointerType, DifferenceType>;
+        ValueType, ReferenceType, PointerType, DifferenceType, StoragePolicy>;
 } // close anonymous inline namespace
 
 template <typename IteratorCategory, typename ValueType,
           typename ReferenceType, typename PointerType,
-          typename DifferenceType>
+          typename DifferenceType, typename StoragePolicy>
 struct any_iterator {
     // TYPES
     using value_type = ValueType;
@@ -69,6 +129,7 @@ struct any_iterator {
     using pointer = PointerType;
     using difference_type = DifferenceType;
     using iterator_category = IteratorCategory;
+    using storage_policy = StoragePolicy;
 
     // CREATORS
     template <bool True = true, 
@@ -90,30 +151,57 @@ struct any_iterator {
         // Throws if allocation was required and failed, or if the copy
         // constructor of `It` throws.
 
-    any_iterator(any_iterator&&);
+    any_iterator(any_iterator&&) noexcept;
         // Move construct an `any_iterator` from an identically specified
-        // `any_iterator`.
-        //
-        // Throws if allocation was required and failed, or if the move
-        // constructor of `It` threw.
+        // `any_iterator`.  An underlying iterator held on the heap is taken
+        // over without allocating, and one held inline is relocated, which
+        // for trivially copyable iterators is a copy of its bytes.  The moved
+        // from `any_iterator` may only be destroyed or assigned to.
 
     template <typename It, 
               typename = std::enable_if_t<std::is_base_of_v<
                 iterator_category, 
                 typename std::iterator_traits<It>::iterator_category
-              >>>
+              > && !detail::is_compatible_iterator_v<any_iterator, It>>>
     any_iterator(It it);
         // Construct an `any_iterator` from an `It`.
         //
         // Only participates in the overload set if `It` satisfies the
         // IteratorCategory of this `any_iterator`.
         //
+        // If `It` models `std::contiguous_iterator`, `reference` is
+        // `std::remove_pointer_t<pointer>&` and `std::to_address(it)` is 
+        // convertible to `pointer`, then only that address is stored, and
+        // dereferencing, incrementing, indexing, comparing and subtracting
+        // such `any_iterator`s is performed inline without a dispatch to the
+        // underlying iterator.
+        //
+        // Throws if allocation was required and failed, or if the move
+        // constructor of `It` throws.
+
+    template <typename It, 
+              typename = std::enable_if_t<std::is_base_of_v<
+                iterator_category, 
+                typename std::iterator_traits<It>::iterator_category
+              > && !detail::is_compatible_iterator_v<any_iterator, It>>>
+    any_iterator(std::allocator_arg_t,
+                 const std::pmr::polymorphic_allocator<>& allocator, It it);
+        // Construct an `any_iterator` from an `It`, as above, allocating 
+        // from the memory resource of `allocator` if `It` must be held on
+        // the heap.  Copies of the `any_iterator`, and of `any_iterator`s 
+        // converted from it, allocate from the same resource, which must
+        // therefore outlive all of them.  No allocation takes place if `It`
+        // is held inline, but the resource is still recorded, unless the
+        // storage policy never allocates, for copies spilling to the heap.
+        //
         // Throws if allocation was required and failed, or if the move
         // constructor of `It` throws.
 
     template <typename OtherAnyIterator,
               typename = std::enable_if_t<detail::is_compatible_iterator_v<
-                any_iterator, OtherAnyIterator>>>
+                any_iterator, std::remove_cvref_t<OtherAnyIterator>> &&
+                detail::is_storage_convertible_v<typename std::remove_cvref_t<
+                    OtherAnyIterator>::storage_policy, storage_policy>>>
     any_iterator(OtherAnyIterator&& other_any_iterator);
         // Construct an `any_iterator` from the underlying iterator of 
         // `other_any_iterator`.
@@ -121,8 +209,12 @@ struct any_iterator {
         // Only participates in the overload set if `OtherAnyIterator` 
         // is a compatible iterator of this `any_iterator`, i.e. it 
         // is also an `any_iterator`, with the `iterator_category` 
-        // derived from `iterator_category` and all other template
-        // parameters the same.
+        // derived from `iterator_category`, a `storage_policy` whose
+        // underlying iterators can always be held under `storage_policy`,
+        // and all other template parameters the same.
+        //
+        // The resulting `any_iterator` shares the table of operations of
+        // `other_any_iterator`, so no further layer of type erasure is added.
         //
         // Throws if allocation was required and failed, or if the 
         // relevant constructor of the underlying iterator throws.
@@ -135,6 +227,22 @@ struct any_iterator {
     void* base() const noexcept;
         // Returns a pointer to the underlying iterator, or the null pointer if
         // the `any_iterator` was default constructed.
+        //
+        // If the `any_iterator` was constructed from a contiguous iterator
+        // whose address is convertible to `pointer` (for example a 
+        // `std::vector<value_type>::iterator`), the underlying iterator is 
+        // that address, stored as a `pointer`.
+
+    type_token target_type() const noexcept;
+        // Returns the token of the type of the underlying iterator, which is
+        // `pointer` if the underlying iterator is stored as an address, as
+        // described for `base()`, and `void` if the `any_iterator` was
+        // default constructed.  No RTTI is required.
+
+    template <typename T>
+    const T* target() const noexcept;
+        // Returns a pointer to the underlying iterator if its type is `T`,
+        // as given by `target_type()`, and the null pointer otherwise.
 
     template <bool True = true>
     std::enable_if_t<True && std::is_base_of_v<std::input_iterator_tag, 
@@ -151,10 +259,9 @@ struct any_iterator {
 
     template <bool True = true, typename = std::enable_if_t<True && 
         std::is_base_of_v<std::input_iterator_tag, iterator_category>>>
-    const detail::AnyInputIterator_Base<value_type, reference, pointer>& operator->() 
-        const;
-        // Returns an implementation-defined type which implements `operator->`
-        // which returns `pointer`.
+    pointer operator->() const;
+        // Returns the address of the element referred to by the underlying
+        // iterator.
         //
         // Only participates in overload resolution if the `iterator_category` is
         // derived from `input_iterator_tag`.
@@ -297,8 +404,28 @@ struct any_iterator {
         // `this->underlying_iterator`.
 
     // MANIPULATORS
+    any_iterator& operator=(const any_iterator& rhs);
+        // Replaces the underlying iterator of `*this` with a copy of that of
+        // `rhs`, and returns a reference to `*this`.
+        //
+        // Throws if allocation was required and failed, or if the copy
+        // constructor of the underlying iterator of `rhs` throws, in which
+        // case `*this` is unchanged.
+
+    any_iterator& operator=(any_iterator&& rhs) noexcept;
+        // Replaces the underlying iterator of `*this` with that of `rhs`, as
+        // if by move construction, and returns a reference to `*this`.
+
     void swap(any_iterator& other) noexcept;
-        // Swaps the underlying iterators of `*this` and `other`. 
+        // Swaps the underlying iterators of `*this` and `other`.  If both
+        // are held on the heap only their addresses are exchanged.
+
+    template <typename T>
+    T* target() noexcept(noexcept(std::declval<BufferType&>().unshare()));
+        // Returns a pointer to the underlying iterator if its type is `T`,
+        // as given by `target_type()`, and the null pointer otherwise.
+        // Under `shared_storage` the underlying iterator is first copied if
+        // it is shared with another `any_iterator`, which may throw.
 
     any_iterator& operator++();
         // Increments the underlying iterator contained within this `any_iterator`
@@ -326,6 +453,34 @@ struct any_iterator {
         // The behaviour of this function is undefined if the underlying iterator
         // is invalid.
 
+    template <bool True = true>
+    std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag,
+        iterator_category>, any_iterator&> write_n(const value_type* input,
+                                                   std::size_t count);
+        // Assigns the `count` elements of the array beginning at `input` to
+        // the underlying iterator, as if by `*it++ = input[i]` for each, and
+        // returns a reference to `*this`.  Writing the array costs a single
+        // dispatch to the underlying iterator, and appending to a container
+        // through a `std::back_insert_iterator` is done by a single range
+        // `insert`.
+        //
+        // Only participates in overload resolution if `iterator_category` is
+        // derived from `output_iterator_tag`.
+        //
+        // The behaviour of this function is undefined if `input` does not
+        // point to an array of at least `count` elements.
+
+    template <bool True = true>
+    std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag,
+        iterator_category>> reserve_hint(std::size_t count);
+        // Informs the underlying iterator that `count` more elements are
+        // about to be written.  If it is a `std::back_insert_iterator` into a
+        // container supporting `reserve`, room for them is reserved in the
+        // container; otherwise this function has no effect.
+        //
+        // Only participates in overload resolution if `iterator_category` is
+        // derived from `output_iterator_tag`.
+
     template <bool True = true, typename = std::enable_if_t<True &&
         std::is_base_of_v<std::forward_iterator_tag, iterator_category>>>
     any_iterator operator++(int);
@@ -338,6 +493,31 @@ struct any_iterator {
         // The behaviour of this function is undefined if the underlying iterator
         // is not incrementable.
 
+    template <bool True = true>
+    std::enable_if_t<True && std::is_base_of_v<std::input_iterator_tag,
+        iterator_category> && !std::is_base_of_v<std::forward_iterator_tag,
+        iterator_category>> operator++(int);
+        // Increments `*this`.
+        //
+        // Only participates in overload resolution if the `iterator_category` is
+        // derived from `input_iterator_tag` but not from `forward_iterator_tag`.
+        //
+        // The behaviour of this function is undefined if the underlying iterator
+        // is not incrementable.
+
+    template <bool True = true>
+    std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag, 
+        iterator_category>, any_iterator> operator++(int);
+        // Increments `*this` and returns a copy of its prior value, so that
+        // `*it++ = value` assigns `value` at the position before the
+        // increment, as for the underlying iterator.
+        //
+        // Only participates in overload resolution if the `iterator_category` is
+        // derived from `output_iterator_tag`.
+        //
+        // The behaviour of this function is undefined if the underlying iterator
+        // is not incrementable.
+
     template <bool True = true, typename = std::enable_if_t<True &&
         std::is_base_of_v<std::bidirectional_iterator_tag, iterator_category>>>
     any_iterator& operator--();
@@ -386,16 +566,83 @@ struct any_iterator {
         // The behaviour of this function is undefined if the underlying iterator
         // cannot be advanced by `offset`.
 
+    template <bool True = true, typename = std::enable_if_t<True &&
+        std::is_base_of_v<std::input_iterator_tag, iterator_category> &&
+        std::is_assignable_v<std::remove_cv_t<value_type>&, reference>>>
+    std::size_t read(std::remove_cv_t<value_type>* output, std::size_t count,
+                     const any_iterator& last);
+        // Assigns up to `count` elements, read from the underlying iterator, 
+        // into the array beginning at `output`, advancing the underlying 
+        // iterator past each element read and stopping early if it compares
+        // equal to the underlying iterator of `last`.  Returns the number of 
+        // elements assigned.  Reading a batch costs a single dispatch to the 
+        // underlying iterator, rather than one each for `!=`, `*` and `++` 
+        // per element.
+        //
+        // Only participates in overload resolution if the `iterator_category` is
+        // derived from `input_iterator_tag` and `value_type` is assignable
+        // from `reference`.
+        //
+        // The behaviour of this function is undefined if the underlying 
+        // iterators of `*this` and `last` are not of the same type, or if 
+        // `output` does not point to an array of at least `count` elements.
+
+    template <typename Visitor, bool True = true,
+        typename = std::enable_if_t<True &&
+            std::is_base_of_v<std::input_iterator_tag, iterator_category>>>
+    bool for_each_until(const any_iterator& last, Visitor&& visitor);
+        // Invokes `visitor` with each element from the underlying iterator,
+        // advancing it past each, until `visitor` returns `true` or the
+        // underlying iterator compares equal to that of `last`.  Returns
+        // whether `visitor` returned `true`, in which case `*this` refers to
+        // the element for which it did.  The whole loop runs inside a single
+        // dispatch to the underlying iterator, costing one indirect call to
+        // `visitor` per element rather than a dispatch each for `!=`, `*`
+        // and `++`, and no dispatch at all if the underlying iterator is
+        // held as a raw pointer.
+        //
+        // Only participates in overload resolution if the `iterator_category` is
+        // derived from `input_iterator_tag`.
+        //
+        // The behaviour of this function is undefined if the underlying
+        // iterators of `*this` and `last` are not of the same type.
+
 private:
     // FRIENDS
     template <typename OtherCategory, typename OtherValue,
         typename OtherReference, typename OtherPointer,
-        typename OtherDifferenceType>
-    friend class any_iterator;
+        typename OtherDifferenceType, typename OtherStoragePolicy>
+    friend struct any_iterator;
+
+    template <typename AnyIterator>
+    friend struct any_sentinel;
+
+    template <typename It, typename AnyIterator>
+    friend struct inline_fit;
+
+    template <typename AnyIterator, typename... Its>
+    friend struct sizing_report;
 
 private:
     // PRIVATE TYPES
-    using BufferType = detail::SmallBuffer<detail::AnyIterator_Base>;
+    using BufferType = detail::storage_buffer_t<detail::AnyIterator_Base,
+        StoragePolicy>;
+    using VTableType = detail::AnyIterator_VTableFor<IteratorCategory,
+        ValueType, ReferenceType, PointerType, DifferenceType>;
+    using ContiguousType = detail::AnyRandomAccessIterator_Impl<PointerType,
+        ValueType, ReferenceType, PointerType, DifferenceType>;
+
+    template <typename It>
+    static constexpr bool is_contiguous_source_v = 
+        detail::is_contiguous_iterator_for_v<It, PointerType> &&
+        std::is_same_v<ReferenceType, std::remove_pointer_t<PointerType>&> &&
+        std::is_base_of_v<std::input_iterator_tag, IteratorCategory>;
+
+    template <typename It>
+    using ImplType = std::conditional_t<is_contiguous_source_v<It>,
+        ContiguousType, detail::AnyIterator_ImplFor<IteratorCategory, It,
+            ValueType, ReferenceType, PointerType, DifferenceType>>;
+        // The object in which an `It` is held.
 
 private:
     // PRIVATE CREATORS
@@ -403,20 +650,44 @@ private:
     any_iterator(const std::bidirectional_iterator_tag&) noexcept;
     any_iterator(const std::forward_iterator_tag&) noexcept;
 
+    template <typename ContiguousIt>
+    any_iterator(const std::contiguous_iterator_tag&,
+                 std::pmr::memory_resource* resource, ContiguousIt&& it);
     template <typename RandIt>
-    any_iterator(const std::random_access_iterator_tag&, RandIt&& it);
+    any_iterator(const std::random_access_iterator_tag&,
+                 std::pmr::memory_resource* resource, RandIt&& it);
     template <typename BiDirIt>
-    any_iterator(const std::bidirectional_iterator_tag&, BiDirIt&& it);
+    any_iterator(const std::bidirectional_iterator_tag&,
+                 std::pmr::memory_resource* resource, BiDirIt&& it);
     template <typename FwdIt>
-    any_iterator(const std::forward_iterator_tag&, FwdIt&& it);
+    any_iterator(const std::forward_iterator_tag&,
+                 std::pmr::memory_resource* resource, FwdIt&& it);
     template <typename InIt>
-    any_iterator(const std::input_iterator_tag&, InIt&& it);
+    any_iterator(const std::input_iterator_tag&,
+                 std::pmr::memory_resource* resource, InIt&& it);
     template <typename OutIt>
-    any_iterator(const std::output_iterator_tag&, OutIt&& it);
+    any_iterator(const std::output_iterator_tag&,
+                 std::pmr::memory_resource* resource, OutIt&& it);
+
+private:
+    // PRIVATE ACCESSORS
+    bool isContiguous() const noexcept;
+        // Returns whether `d_buffer` holds a `ContiguousType`.
+
+    pointer& contiguousCursor() const noexcept;
+        // Returns a reference to the address held by `d_buffer`.  The
+        // behaviour is undefined unless `isContiguous()` is `true`.
+
+    // PRIVATE MANIPULATORS
+    pointer& mutableCursor();
+        // Returns a reference to the address held by `d_buffer`, so that it
+        // may be modified, first unsharing it under `shared_storage`.  The
+        // behaviour is undefined unless `isContiguous()` is `true`.
 
 private:
     // DATA
-    BufferType d_buffer;
+    const VTableType* d_vtable;  // operations on the object in `d_buffer`
+    BufferType        d_buffer;
 };
 
 template <typename It>
@@ -428,25 +699,36 @@ any_iterator(It) -> any_iterator<
     typename std::iterator_traits<It>::difference_type
 >;
 
+template <typename It>
+any_iterator(std::allocator_arg_t, const std::pmr::polymorphic_allocator<>&,
+             It) -> any_iterator<
+    typename std::iterator_traits<It>::iterator_category,
+    typename std::iterator_traits<It>::value_type,
+    typename std::iterator_traits<It>::reference,
+    typename std::iterator_traits<It>::pointer,
+    typename std::iterator_traits<It>::difference_type
+>;
+
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 void swap(any_iterator<IteratorCategory, ValueType, Reference, 
-    Pointer, DifferenceType>& lhs,
+    Pointer, DifferenceType, StoragePolicy>& lhs,
           any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& rhs) noexcept;
+    Pointer, DifferenceType, StoragePolicy>& rhs) noexcept;
     // Swaps the underlying iterators of `lhs` and `rhs`.
 
 // FREE OPERATORS
 template <typename IteratorCategory, typename ValueType,
           typename Reference, typename Pointer, typename DifferenceType,
-          typename = std::enable_if_t<
+          typename StoragePolicy, typename = std::enable_if_t<
             std::is_base_of_v<std::random_access_iterator_tag, IteratorCategory>>>
 any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType> operator+(
+    DifferenceType, StoragePolicy> operator+(
         typename any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-            DifferenceType>::difference_type offset, 
+            DifferenceType, StoragePolicy>::difference_type offset, 
         const any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-            DifferenceType>& rhs);
+            DifferenceType, StoragePolicy>& rhs);
     // Returns a copy of `rhs` and advances its underlying iterator by
     // `offset`.
     //
@@ -461,311 +743,409 @@ any_iterator<IteratorCategory, ValueType, Reference, Pointer,
 // ===========================================================================
 // CREATORS
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool True, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator() noexcept
+    DifferenceType, StoragePolicy>::any_iterator() noexcept
     : any_iterator(IteratorCategory{})
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const any_iterator&) = default;
+    DifferenceType, StoragePolicy>::any_iterator(const any_iterator&) = default;
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(any_iterator&&) = default;
+    DifferenceType, StoragePolicy>::any_iterator(any_iterator&&) noexcept
+        = default;
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename It, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(It it)
-    : any_iterator(IteratorCategory{}, std::move(it))
+    DifferenceType, StoragePolicy>::any_iterator(It it)
+    : any_iterator(std::conditional_t<is_contiguous_source_v<It>,
+        std::contiguous_iterator_tag, IteratorCategory>{}, nullptr,
+        std::move(it))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <typename It, typename>
+inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
+    DifferenceType, StoragePolicy>::any_iterator(std::allocator_arg_t,
+        const std::pmr::polymorphic_allocator<>& allocator, It it)
+    : any_iterator(std::conditional_t<is_contiguous_source_v<It>,
+        std::contiguous_iterator_tag, IteratorCategory>{},
+        allocator.resource(), std::move(it))
+{}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename OtherAnyIterator, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(OtherAnyIterator&& other_any_iterator)
-    : any_iterator(detail::forward_like<OtherAnyIterator>(
+    DifferenceType, StoragePolicy>::any_iterator(OtherAnyIterator&& other_any_iterator)
+    : d_vtable(other_any_iterator.d_vtable)
+    , d_buffer(detail::forward_like<OtherAnyIterator>(
         other_any_iterator.d_buffer))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::~any_iterator() = default;
+    DifferenceType, StoragePolicy>::~any_iterator() = default;
 
 // ACCESSORS
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline void* any_iterator<IteratorCategory, ValueType,
-        Reference, Pointer, DifferenceType>::base() const noexcept
+        Reference, Pointer, DifferenceType, StoragePolicy>::base() const noexcept
 {
-    return d_buffer->base();
+    return d_vtable->base(*d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline type_token any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>::target_type() const noexcept
+{
+    return d_vtable->type;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <typename T>
+inline const T* any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>::target() const noexcept
+{
+    if (target_type() == type_token::of<T>()) {
+        return static_cast<const T*>(base());
+    }
+    return nullptr;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool True>
 inline std::enable_if_t<True && std::is_base_of_v<std::input_iterator_tag, 
     IteratorCategory>, typename any_iterator<IteratorCategory, ValueType,
-        Reference, Pointer, DifferenceType>::reference> 
+        Reference, Pointer, DifferenceType, StoragePolicy>::reference> 
     any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-        DifferenceType>::operator*() const
+        DifferenceType, StoragePolicy>::operator*() const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using InputType = detail::AnyInputIterator_Base<ValueType, Reference, 
-        Pointer>;
-    
-    assert(dynamic_cast<InputType*>(&underlying));
-    return *static_cast<InputType&>(underlying);
+    if (isContiguous()) {
+        return *contiguousCursor();
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::dereference);
+    return d_vtable->dereference(*d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
-inline const detail::AnyInputIterator_Base<ValueType, Reference, Pointer>& 
-    any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-        DifferenceType>::operator->() const
+inline Pointer any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
+        DifferenceType, StoragePolicy>::operator->() const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using InputType = detail::AnyInputIterator_Base<ValueType, Reference, 
-        Pointer>;
-    
-    assert(dynamic_cast<InputType*>(&underlying));
-    return static_cast<InputType&>(underlying);
+    if (isContiguous()) {
+        return contiguousCursor();
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::arrow);
+    return d_vtable->arrow(*d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline Reference any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator[](difference_type offset) const
+        DifferenceType, StoragePolicy>::operator[](difference_type offset) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using InputType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
-    
-    assert(dynamic_cast<InputType*>(&underlying));
-    return static_cast<InputType&>(underlying);
+    if (isContiguous()) {
+        return contiguousCursor()[offset];
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::subscript);
+    return d_vtable->subscript(*d_buffer, offset);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator==(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator==(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() == rhs.contiguousCursor();
+    }
 
-    using RequiredType = detail::AnyInputIterator_Base<ValueType, Reference, 
-        Pointer>;
-
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) == 
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::equal);
+    return d_vtable->equal(*d_buffer, *rhs.d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator!=(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator!=(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
-
-    using RequiredType = detail::AnyInputIterator_Base<ValueType, Reference, 
-        Pointer>;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() != rhs.contiguousCursor();
+    }
 
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) != 
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::equal);
+    return !d_vtable->equal(*d_buffer, *rhs.d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator<(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator<(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() < rhs.contiguousCursor();
+    }
 
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
-
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) < 
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::compare);
+    return d_vtable->compare(*d_buffer, *rhs.d_buffer) < 0;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator>(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator>(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
-
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() > rhs.contiguousCursor();
+    }
 
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) > 
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::compare);
+    return d_vtable->compare(*d_buffer, *rhs.d_buffer) > 0;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator<=(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator<=(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
-
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() <= rhs.contiguousCursor();
+    }
 
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) <=
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::compare);
+    return d_vtable->compare(*d_buffer, *rhs.d_buffer) <= 0;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator>=(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator>=(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() >= rhs.contiguousCursor();
+    }
 
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
-
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) >=
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::compare);
+    return d_vtable->compare(*d_buffer, *rhs.d_buffer) >= 0;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType> any_iterator<IteratorCategory, ValueType, Reference, 
-        Pointer, DifferenceType>::operator+(difference_type offset) const
+        DifferenceType, StoragePolicy> any_iterator<IteratorCategory, ValueType, Reference, 
+        Pointer, DifferenceType, StoragePolicy>::operator+(difference_type offset) const
 {
     auto tmp{*this};
     return tmp += offset;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType> any_iterator<IteratorCategory, ValueType, Reference, 
-        Pointer, DifferenceType>::operator-(difference_type offset) const
+        DifferenceType, StoragePolicy> any_iterator<IteratorCategory, ValueType, Reference, 
+        Pointer, DifferenceType, StoragePolicy>::operator-(difference_type offset) const
 {
     auto tmp{*this};
     return tmp -= offset;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline DifferenceType any_iterator<IteratorCategory, ValueType, Reference, Pointer,
-        DifferenceType>::operator-(const any_iterator& rhs) const
+        DifferenceType, StoragePolicy>::operator-(const any_iterator& rhs) const
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    detail::AnyIterator_Base& rhs_underlying = *rhs.d_buffer;
+    if (isContiguous() && rhs.isContiguous()) {
+        return contiguousCursor() - rhs.contiguousCursor();
+    }
 
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType, 
-        Reference, Pointer, DifferenceType>;
-
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    assert(dynamic_cast<RequiredType*>(&rhs_underlying));
-    return static_cast<RequiredType&>(underlying) -
-        static_cast<RequiredType&>(rhs_underlying);
+    assert(d_vtable->type == rhs.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::distance);
+    return d_vtable->distance(*d_buffer, *rhs.d_buffer);
 }
 
 // MANIPULATORS
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType,
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator=(
+        const any_iterator& rhs)
+{
+    any_iterator tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType,
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator=(
+        any_iterator&& rhs) noexcept = default;
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline void any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>::swap(any_iterator& other) noexcept
+    Pointer, DifferenceType, StoragePolicy>::swap(any_iterator& other) noexcept
 {
     using std::swap;
+    swap(d_vtable, other.d_vtable);
     swap(d_buffer, other.d_buffer);
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <typename T>
+inline T* any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>::target()
+    noexcept(noexcept(std::declval<BufferType&>().unshare()))
+{
+    d_buffer.unshare();
+    return const_cast<T*>(std::as_const(*this).template target<T>());
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator++()
+    Pointer, DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator++()
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    ++underlying;
+    if (isContiguous()) {
+        ++mutableCursor();
+        return *this;
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::increment);
+    d_vtable->increment(d_buffer.unshare());
     return *this;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool True>
 inline std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag, 
     IteratorCategory>, any_iterator<IteratorCategory, ValueType,
-        Reference, Pointer, DifferenceType>&> 
+        Reference, Pointer, DifferenceType, StoragePolicy>&> 
     any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-        DifferenceType>::operator*()
+        DifferenceType, StoragePolicy>::operator*()
 {
-#ifndef NDEBUG
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using OutputType = detail::AnyOutputIterator_Base<ValueType>;
-    assert(dynamic_cast<OutputType*>(&underlying));
-#endif // NDEBUG
-
     return *this;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool True>
 inline std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag, 
     IteratorCategory>, any_iterator<IteratorCategory, ValueType,
-        Reference, Pointer, DifferenceType>&> 
+        Reference, Pointer, DifferenceType, StoragePolicy>&> 
     any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-        DifferenceType>::operator=(value_type value)
+        DifferenceType, StoragePolicy>::operator=(value_type value)
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using OutputType = detail::AnyOutputIterator_Base<ValueType>;
+    detail::statsCount(d_vtable->type, stats_counter::assign);
+    d_vtable->moveAssign(d_buffer.unshare(), std::move(value));
+    return *this;
+}
 
-    assert(dynamic_cast<OutputType*>(&underlying));
-    static_cast<OutputType&>(underlying) = std::move(value);
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <bool True>
+inline std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag,
+    IteratorCategory>, any_iterator<IteratorCategory, ValueType,
+        Reference, Pointer, DifferenceType, StoragePolicy>&>
+    any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+        DifferenceType, StoragePolicy>::write_n(const value_type* input,
+                                                std::size_t count)
+{
+    detail::statsCount(d_vtable->type, stats_counter::write);
+    d_vtable->write(d_buffer.unshare(), input, count);
     return *this;
 }
 
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <bool True>
+inline std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag,
+    IteratorCategory>> any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>::reserve_hint(std::size_t count)
+{
+    detail::statsCount(d_vtable->type, stats_counter::reserve);
+    d_vtable->reserve(d_buffer.unshare(), count);
+}
+
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType> any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator++(int)
+    Pointer, DifferenceType, StoragePolicy> any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator++(int)
 {
     auto tmp{*this};
     ++*this;
@@ -773,27 +1153,56 @@ inline any_iterator<IteratorCategory, ValueType, Reference,
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <bool True>
+inline std::enable_if_t<True && std::is_base_of_v<std::input_iterator_tag,
+    IteratorCategory> && !std::is_base_of_v<std::forward_iterator_tag,
+    IteratorCategory>> any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>::operator++(int)
+{
+    ++*this;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <bool True>
+inline std::enable_if_t<True && std::is_base_of_v<std::output_iterator_tag,
+    IteratorCategory>, any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>> any_iterator<IteratorCategory,
+    ValueType, Reference, Pointer, DifferenceType, StoragePolicy>::operator++(int)
+{
+    auto tmp{*this};
+    ++*this;
+    return tmp;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator--()
+    Pointer, DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator--()
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using RequiredType = detail::AnyBidirectionalIterator_Base<ValueType,
-        Reference, Pointer>;
-    
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    --static_cast<RequiredType&>(underlying);
+    if (isContiguous()) {
+        --mutableCursor();
+        return *this;
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::decrement);
+    d_vtable->decrement(d_buffer.unshare());
     return *this;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType> any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator--(int)
+    Pointer, DifferenceType, StoragePolicy> any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator--(int)
 {
     auto tmp{*this};
     --*this;
@@ -801,121 +1210,234 @@ inline any_iterator<IteratorCategory, ValueType, Reference,
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator+=(difference_type offset)
+    Pointer, DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator+=(difference_type offset)
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType,
-        Reference, Pointer, DifferenceType>;
-    
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    static_cast<RequiredType&>(underlying) += offset;
+    if (isContiguous()) {
+        mutableCursor() += offset;
+        return *this;
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::advance);
+    d_vtable->advance(d_buffer.unshare(), offset);
     return *this;
 }
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <bool, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& any_iterator<IteratorCategory, ValueType, 
-    Reference, Pointer, DifferenceType>::operator-=(difference_type offset)
+    Pointer, DifferenceType, StoragePolicy>& any_iterator<IteratorCategory, ValueType, 
+    Reference, Pointer, DifferenceType, StoragePolicy>::operator-=(difference_type offset)
 {
-    detail::AnyIterator_Base& underlying = *d_buffer;
-    using RequiredType = detail::AnyRandomAccessIterator_Base<ValueType,
-        Reference, Pointer, DifferenceType>;
-    
-    assert(dynamic_cast<RequiredType*>(&underlying));
-    static_cast<RequiredType&>(underlying) -= offset;
+    if (isContiguous()) {
+        mutableCursor() -= offset;
+        return *this;
+    }
+
+    detail::statsCount(d_vtable->type, stats_counter::advance);
+    d_vtable->advance(d_buffer.unshare(), -offset);
     return *this;
 }
 
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <bool, typename>
+inline std::size_t any_iterator<IteratorCategory, ValueType, Reference,
+    Pointer, DifferenceType, StoragePolicy>::read(std::remove_cv_t<value_type>* output,
+                                   std::size_t count, const any_iterator& last)
+{
+    assert(d_vtable->type == last.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::read);
+    return d_vtable->read(d_buffer.unshare(), output, count, *last.d_buffer);
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <typename Visitor, bool, typename>
+inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>::for_each_until(const any_iterator& last,
+                                                   Visitor&& visitor)
+{
+    if (isContiguous()) {
+        return detail::visitUntil(mutableCursor(), last.contiguousCursor(),
+                                  visitor);
+    }
+
+    assert(d_vtable->type == last.d_vtable->type);
+    detail::statsCount(d_vtable->type, stats_counter::for_each);
+    return d_vtable->forEachUntil(d_buffer.unshare(), *last.d_buffer,
+        detail::AnyIterator_Visitor<reference>(visitor));
+}
+
 // PRIVATE CREATORS
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::random_access_iterator_tag&) 
+    DifferenceType, StoragePolicy>::any_iterator(const std::random_access_iterator_tag&) 
         noexcept
-    : d_buffer(std::in_place_type<detail::AnyRandomAccessIterator_Impl<void, ValueType,
+    : d_vtable(&detail::AnyRandomAccessIterator_Impl<void, ValueType,
+        Reference, Pointer, DifferenceType>::vtable)
+    , d_buffer(detail::inPlaceStatic<detail::AnyRandomAccessIterator_Impl<void, ValueType,
         Reference, Pointer, DifferenceType>>)
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::bidirectional_iterator_tag&) 
+    DifferenceType, StoragePolicy>::any_iterator(const std::bidirectional_iterator_tag&) 
         noexcept
-    : d_buffer(std::in_place_type<detail::AnyBidirectionalIterator_Impl<void, ValueType,
+    : d_vtable(&detail::AnyBidirectionalIterator_Impl<void, ValueType,
+        Reference, Pointer>::vtable)
+    , d_buffer(detail::inPlaceStatic<detail::AnyBidirectionalIterator_Impl<void, ValueType,
         Reference, Pointer>>)
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::forward_iterator_tag&) 
+    DifferenceType, StoragePolicy>::any_iterator(const std::forward_iterator_tag&) 
         noexcept
-    : d_buffer(std::in_place_type<detail::AnyForwardIterator_Impl<void, ValueType,
+    : d_vtable(&detail::AnyForwardIterator_Impl<void, ValueType,
+        Reference, Pointer>::vtable)
+    , d_buffer(detail::inPlaceStatic<detail::AnyForwardIterator_Impl<void, ValueType,
         Reference, Pointer>>)
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+template <typename ContiguousIt>
+inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::contiguous_iterator_tag&,
+        std::pmr::memory_resource* resource, ContiguousIt&& it)
+    : d_vtable(&ContiguousType::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<ContiguousType>, std::to_address(it))
+{}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename RandIt>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::random_access_iterator_tag&,
-        RandIt&& it) 
-    : d_buffer(std::in_place_type<detail::AnyRandomAccessIterator_Impl<std::decay_t<RandIt>, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::random_access_iterator_tag&,
+        std::pmr::memory_resource* resource, RandIt&& it)
+    : d_vtable(&detail::AnyRandomAccessIterator_Impl<std::decay_t<RandIt>, 
+            ValueType, Reference, Pointer, DifferenceType>::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<detail::AnyRandomAccessIterator_Impl<std::decay_t<RandIt>, 
         ValueType, Reference, Pointer, DifferenceType>>, std::forward<RandIt>(it))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename BiDirIt>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::bidirectional_iterator_tag&,
-        BiDirIt&& it) 
-    : d_buffer(std::in_place_type<detail::AnyBidirectionalIterator_Impl<std::decay_t<BiDirIt>, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::bidirectional_iterator_tag&,
+        std::pmr::memory_resource* resource, BiDirIt&& it)
+    : d_vtable(&detail::AnyBidirectionalIterator_Impl<std::decay_t<BiDirIt>, 
+            ValueType, Reference, Pointer>::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<detail::AnyBidirectionalIterator_Impl<std::decay_t<BiDirIt>, 
         ValueType, Reference, Pointer>>, std::forward<BiDirIt>(it))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename FwdIt>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::forward_iterator_tag&,
-        FwdIt&& it) 
-    : d_buffer(std::in_place_type<detail::AnyForwardIterator_Impl<std::decay_t<FwdIt>, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::forward_iterator_tag&,
+        std::pmr::memory_resource* resource, FwdIt&& it)
+    : d_vtable(&detail::AnyForwardIterator_Impl<std::decay_t<FwdIt>, 
+            ValueType, Reference, Pointer>::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<detail::AnyForwardIterator_Impl<std::decay_t<FwdIt>, 
         ValueType, Reference, Pointer>>, std::forward<FwdIt>(it))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename InIt>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::input_iterator_tag&,
-        InIt&& it) 
-    : d_buffer(std::in_place_type<detail::AnyInputIterator_Impl<std::decay_t<InIt>, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::input_iterator_tag&,
+        std::pmr::memory_resource* resource, InIt&& it)
+    : d_vtable(&detail::AnyInputIterator_Impl<std::decay_t<InIt>, 
+            ValueType, Reference, Pointer>::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<detail::AnyInputIterator_Impl<std::decay_t<InIt>, 
         ValueType, Reference, Pointer>>, std::forward<InIt>(it))
 {}
 
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 template <typename OutIt>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType>::any_iterator(const std::output_iterator_tag&,
-        OutIt&& it) 
-    : d_buffer(std::in_place_type<detail::AnyOutputIterator_Impl<std::decay_t<OutIt>, 
+    DifferenceType, StoragePolicy>::any_iterator(const std::output_iterator_tag&,
+        std::pmr::memory_resource* resource, OutIt&& it)
+    : d_vtable(&detail::AnyOutputIterator_Impl<std::decay_t<OutIt>, 
+            ValueType>::vtable)
+    , d_buffer(std::allocator_arg, resource,
+        std::in_place_type<detail::AnyOutputIterator_Impl<std::decay_t<OutIt>, 
         ValueType>>, std::forward<OutIt>(it))
 {}
 
+// PRIVATE ACCESSORS
 template <typename IteratorCategory, typename ValueType,
-          typename Reference, typename Pointer, typename DifferenceType>
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline bool any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>::isContiguous() const noexcept
+{
+    if constexpr (std::is_base_of_v<std::input_iterator_tag, IteratorCategory>) {
+        return d_vtable == &ContiguousType::vtable;
+    } else {
+        return false;
+    }
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline Pointer& any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>::contiguousCursor() const noexcept
+{
+    assert(isContiguous());
+    return static_cast<ContiguousType&>(*d_buffer).iterator();
+}
+
+// PRIVATE MANIPULATORS
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
+inline Pointer& any_iterator<IteratorCategory, ValueType, Reference, Pointer,
+    DifferenceType, StoragePolicy>::mutableCursor()
+{
+    assert(isContiguous());
+    return static_cast<ContiguousType&>(d_buffer.unshare()).iterator();
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename Reference, typename Pointer, typename DifferenceType,
+          typename StoragePolicy>
 inline void swap(any_iterator<IteratorCategory, ValueType, Reference, 
-    Pointer, DifferenceType>& lhs,
+    Pointer, DifferenceType, StoragePolicy>& lhs,
           any_iterator<IteratorCategory, ValueType, Reference,
-    Pointer, DifferenceType>& rhs) noexcept
+    Pointer, DifferenceType, StoragePolicy>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -923,13 +1445,13 @@ inline void swap(any_iterator<IteratorCategory, ValueType, Reference,
 // FREE OPERATORS
 template <typename IteratorCategory, typename ValueType,
           typename Reference, typename Pointer, typename DifferenceType,
-          typename>
+          typename StoragePolicy, typename>
 inline any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-    DifferenceType> operator+(
+    DifferenceType, StoragePolicy> operator+(
         typename any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-            DifferenceType>::difference_type offset, 
+            DifferenceType, StoragePolicy>::difference_type offset, 
         const any_iterator<IteratorCategory, ValueType, Reference, Pointer, 
-            DifferenceType>& rhs)
+            DifferenceType, StoragePolicy>& rhs)
 {
     return rhs + offset;
 }
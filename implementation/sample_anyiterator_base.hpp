@@ -1,30 +1,34 @@
 #ifndef SAMPLE_ANYITERATOR_BASE
 #define SAMPLE_ANYITERATOR_BASE
 
+#include <sample_typetoken.hpp>
+
 namespace sample::detail {
 
 struct AnyIterator_Base {
-    // This class provides a common base for all of the other
-    // iterator bases
-    
-    // CREATORS
-    virtual ~AnyIterator_Base() = 0;
+    // This class provides a common, non-polymorphic base for all of the
+    // iterator implementations held within an `any_iterator`.  The
+    // operations on those implementations are reached through the static
+    // tables of function pointers below, rather than through virtual
+    // functions.
+};
 
-    // ACCESSORS
-    virtual const void* base() const noexcept = 0;
+struct AnyIterator_VTable {
+    // This class provides a common base for the tables of operations of
+    // each of the iterator categories.  Exactly one table exists for each
+    // combination of underlying iterator and category, and it is built at
+    // compile time.
 
-    // MANIPULATORS
-    virtual void* base() noexcept = 0;
+    // DATA
+    void* (*base)(AnyIterator_Base& self) noexcept;
+        // Return the address of the underlying iterator of `self`.
 
-    virtual AnyIterator_Base& operator++() = 0;
+    void (*increment)(AnyIterator_Base& self);
+        // Increment the underlying iterator of `self`.
+    type_token type;
+        // The type of the underlying iterator.
 };
 
-// ===========================================================================
-//      INLINE DEFINITIONS
-// ===========================================================================
-// CREATORS
-inline AnyIterator_Base::~AnyIterator_Base() = default;
-
 } // close namespace sample::detail
 
 #endif // SAMPLE_ANYITERATOR_BASE
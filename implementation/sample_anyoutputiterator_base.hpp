@@ -3,36 +3,119 @@
 
 #include <sample_anyiterator_base.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace sample::detail {
 
 template <typename OutputType>
-struct AnyOutputIterator_Base : AnyIterator_Base {
-    // ACCESSORS
-    AnyOutputIterator_Base& operator*() const noexcept;
+struct AnyOutputIterator_VTable : AnyIterator_VTable {
+    // DATA
+    void (*assign)(AnyIterator_Base& self, const OutputType& value);
+        // Assign `value` through the underlying iterator of `self`.
+
+    void (*moveAssign)(AnyIterator_Base& self, OutputType&& value);
+        // Move assign `value` through the underlying iterator of `self`.
+
+    void (*write)(AnyIterator_Base& self, const OutputType* input,
+                  std::size_t count);
+        // Assign the `count` elements of the array at `input` through the
+        // underlying iterator of `self`, incrementing it after each.
+
+    void (*reserve)(AnyIterator_Base& self, std::size_t count);
+        // Prepare the destination of the underlying iterator of `self` for
+        // `count` more elements, if it is a container which can reserve.
+};
+
+template <typename OutputIt>
+struct back_insert_container {
+    // Trait naming the container appended to by `OutputIt`, or `void` if
+    // `OutputIt` is not a `std::back_insert_iterator`.
+
+    using type = void;
+};
 
-    // MANIPULATORS
-    virtual AnyOutputIterator_Base& operator=(OutputType&& value) = 0;
-    virtual AnyOutputIterator_Base& operator=(const OutputType& value) = 0;
+template <typename Container>
+struct back_insert_container<std::back_insert_iterator<Container>> {
+    using type = Container;
 };
 
+template <typename Container, typename Input, typename = void>
+struct is_range_insertable : std::false_type {};
+    // Trait detecting whether `Container` supports `insert(end, first, last)`
+    // for a range of `Input` pointers.
+
+template <typename Container, typename Input>
+struct is_range_insertable<Container, Input, std::void_t<
+    decltype(std::declval<Container&>().insert(
+        std::declval<Container&>().end(), std::declval<Input>(),
+        std::declval<Input>()))>> : std::true_type {};
+
+template <typename Container, typename = void>
+struct is_reservable : std::false_type {};
+    // Trait detecting whether `Container` supports `reserve`, `capacity` and
+    // `size`.
+
+template <typename Container>
+struct is_reservable<Container, std::void_t<
+    decltype(std::declval<Container&>().reserve(
+        std::declval<Container&>().capacity() +
+        std::declval<Container&>().size()))>> : std::true_type {};
+
+template <typename Container>
+Container& backInsertContainer(std::back_insert_iterator<Container>& it)
+    noexcept;
+    // Return the container appended to by `it`.
+
+template <typename OutputIt, typename OutputType>
+void bulkWrite(OutputIt& it, const OutputType* input, std::size_t count);
+    // Assign the `count` elements of the array at `input` through `it`,
+    // leaving `it` as if incremented after each.  Appending to a container
+    // which supports range insertion is done by a single `insert`.
+
+template <typename OutputIt>
+void reserveHint(OutputIt& it, std::size_t count);
+    // Reserve room for `count` more elements in the container appended to by
+    // `it`, if `it` is a `std::back_insert_iterator` into a container
+    // supporting `reserve`, and do nothing otherwise.  The capacity is at
+    // least doubled when it grows, so that repeatedly appending short
+    // ranges remains amortized constant time per element.
+
 template <typename OutputIt, typename OutputType>
-struct AnyOutputIterator_Impl final : AnyOutputIterator_Base<OutputType>
-{ 
+struct AnyOutputIterator_Impl final : AnyIterator_Base
+{
+    // TYPES
+    using VTable = AnyOutputIterator_VTable<OutputType>;
+
     // CREATORS
     AnyOutputIterator_Impl(OutputIt it)
         noexcept(std::is_nothrow_copy_constructible_v<OutputIt>);
 
-    // ACCESSORS
-    const void* base() const noexcept override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static void assign(AnyIterator_Base& self, const OutputType& value);
+    static void moveAssign(AnyIterator_Base& self, OutputType&& value);
 
-    // MANIPULATORS
-    void* base() noexcept override;
+    static void write(AnyIterator_Base& self, const OutputType* input,
+                      std::size_t count);
+    static void reserve(AnyIterator_Base& self, std::size_t count);
 
-    AnyOutputIterator_Impl& operator=(OutputType&& value) override;
-    AnyOutputIterator_Impl& operator=(const OutputType& value) override;
-    AnyOutputIterator_Impl& operator++() override;
+    static void increment(AnyIterator_Base& self);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {&AnyOutputIterator_Impl::base,
+         &AnyOutputIterator_Impl::increment,
+         type_token::of<OutputIt>()},
+        &AnyOutputIterator_Impl::assign,
+        &AnyOutputIterator_Impl::moveAssign,
+        &AnyOutputIterator_Impl::write,
+        &AnyOutputIterator_Impl::reserve
+    };
 
 private:
     // DATA
@@ -42,20 +125,54 @@ private:
 // ===========================================================================
 //      INLINE DEFINITIONS
 // ===========================================================================
-                // =================================
-                // class AnyOutputIterator_Base
-                // =================================
-// ACCESSORS
-template <typename OutputType>
-inline AnyOutputIterator_Base<OutputType>& 
-    AnyOutputIterator_Base<OutputType>::operator*() const noexcept
+// FREE FUNCTIONS
+template <typename Container>
+inline Container& backInsertContainer(std::back_insert_iterator<Container>& it)
+    noexcept
+{
+    // `container` is a protected member of `back_insert_iterator`, which is
+    // reachable through a pointer to member formed in a derived class.
+    struct Access : std::back_insert_iterator<Container> {
+        static Container& get(std::back_insert_iterator<Container>& it)
+            noexcept
+        {
+            return *(it.*&Access::container);
+        }
+    };
+    return Access::get(it);
+}
+
+template <typename OutputIt, typename OutputType>
+inline void bulkWrite(OutputIt& it, const OutputType* input,
+                      std::size_t count)
 {
-    return *this;
+    using Container = typename back_insert_container<OutputIt>::type;
+    if constexpr (!std::is_void_v<Container> &&
+                  is_range_insertable<Container, const OutputType*>::value) {
+        Container& container = backInsertContainer(it);
+        container.insert(container.end(), input, input + count);
+    } else {
+        for (std::size_t i = 0; i != count; ++i, ++it) {
+            *it = input[i];
+        }
+    }
+}
+
+template <typename OutputIt>
+inline void reserveHint(OutputIt& it, std::size_t count)
+{
+    using Container = typename back_insert_container<OutputIt>::type;
+    if constexpr (!std::is_void_v<Container>) {
+        if constexpr (is_reservable<Container>::value) {
+            Container& container = backInsertContainer(it);
+            const auto required = container.size() + count;
+            if (required > container.capacity()) {
+                container.reserve(std::max(required, 2 * container.capacity()));
+            }
+        }
+    }
 }
 
-                // =================================
-                // class AnyOutputIterator_Impl
-                // =================================
 // CREATORS
 template <typename OutputIt, typename OutputType>
 inline AnyOutputIterator_Impl<OutputIt, OutputType>::AnyOutputIterator_Impl(
@@ -63,45 +180,48 @@ inline AnyOutputIterator_Impl<OutputIt, OutputType>::AnyOutputIterator_Impl(
     : d_it(it)
 {}
 
-// ACCESSORS
+// CLASS METHODS
 template <typename OutputIt, typename OutputType>
-inline const void* AnyOutputIterator_Impl<OutputIt, OutputType>::base() const
-    noexcept
+inline void* AnyOutputIterator_Impl<OutputIt, OutputType>::base(
+    AnyIterator_Base& self) noexcept
 {
-    return static_cast<const void*>(&d_it);
+    return static_cast<void*>(&static_cast<AnyOutputIterator_Impl&>(self).d_it);
 }
 
-// MANIPULATORS
 template <typename OutputIt, typename OutputType>
-inline void* AnyOutputIterator_Impl<OutputIt, OutputType>::base() noexcept
+inline void AnyOutputIterator_Impl<OutputIt, OutputType>::assign(
+    AnyIterator_Base& self, const OutputType& value)
 {
-    return static_cast<void*>(&d_it);
+    *static_cast<AnyOutputIterator_Impl&>(self).d_it = value;
 }
 
 template <typename OutputIt, typename OutputType>
-inline AnyOutputIterator_Impl<OutputIt, OutputType>& 
-    AnyOutputIterator_Impl<OutputIt, OutputType>::operator=(OutputType&& value)
+inline void AnyOutputIterator_Impl<OutputIt, OutputType>::moveAssign(
+    AnyIterator_Base& self, OutputType&& value)
 {
-    *d_it = std::move(value);
-    return *this;
+    *static_cast<AnyOutputIterator_Impl&>(self).d_it = std::move(value);
 }
 
 template <typename OutputIt, typename OutputType>
-inline AnyOutputIterator_Impl<OutputIt, OutputType>& 
-    AnyOutputIterator_Impl<OutputIt, OutputType>::operator=(const OutputType& value)
+inline void AnyOutputIterator_Impl<OutputIt, OutputType>::write(
+    AnyIterator_Base& self, const OutputType* input, std::size_t count)
 {
-    *d_it = value;
-    return *this;
+    bulkWrite(static_cast<AnyOutputIterator_Impl&>(self).d_it, input, count);
 }
 
 template <typename OutputIt, typename OutputType>
-inline AnyOutputIterator_Impl<OutputIt, OutputType>& 
-    AnyOutputIterator_Impl<OutputIt, OutputType>::operator++()
+inline void AnyOutputIterator_Impl<OutputIt, OutputType>::reserve(
+    AnyIterator_Base& self, std::size_t count)
 {
-    ++d_it;
-    return *this;
+    reserveHint(static_cast<AnyOutputIterator_Impl&>(self).d_it, count);
 }
 
+template <typename OutputIt, typename OutputType>
+inline void AnyOutputIterator_Impl<OutputIt, OutputType>::increment(
+    AnyIterator_Base& self)
+{
+    ++static_cast<AnyOutputIterator_Impl&>(self).d_it;
+}
 
 } // close namespace sample::detail
 
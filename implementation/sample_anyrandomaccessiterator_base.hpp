@@ -3,76 +3,103 @@
 
 #include <sample_anybidirectionaliterator_base.hpp>
 
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+
 namespace sample::detail {
 
 template <typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-struct AnyRandomAccessIterator_Base 
-    : AnyBidirectionalIterator_Base<ValueType, Reference, Pointer> 
+struct AnyRandomAccessIterator_VTable
+    : AnyBidirectionalIterator_VTable<ValueType, Reference, Pointer>
 {
-    // ACCESSORS
-    virtual Reference operator[](DifferenceType offset) const = 0;
-
-    virtual DifferenceType operator-(const AnyRandomAccessIterator_Base& rhs) const = 0;
-
-    virtual bool operator<(const AnyRandomAccessIterator_Base& rhs) const = 0;
-    virtual bool operator>(const AnyRandomAccessIterator_Base& rhs) const = 0;
-
-    virtual bool operator<=(const AnyRandomAccessIterator_Base& rhs) const = 0;
-    virtual bool operator>=(const AnyRandomAccessIterator_Base& rhs) const = 0;
-
-    // MANIPULATORS
-    virtual AnyRandomAccessIterator_Base& operator+=(DifferenceType offset) = 0;
-    virtual AnyRandomAccessIterator_Base& operator-=(DifferenceType offset) = 0;
+    // DATA
+    Reference (*subscript)(const AnyIterator_Base& self, DifferenceType offset);
+        // Return the element `offset` positions away from the underlying
+        // iterator of `self`.
+
+    DifferenceType (*distance)(const AnyIterator_Base& lhs,
+                               const AnyIterator_Base& rhs);
+        // Return the distance from the underlying iterator of `rhs` to that
+        // of `lhs`.
+
+    int (*compare)(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+        // Return a negative value, zero or a positive value if the underlying
+        // iterator of `lhs` is respectively before, at or after that of
+        // `rhs`.  All four relational operators are derived from this single
+        // entry so that each costs only one indirect call.
+
+    void (*advance)(AnyIterator_Base& self, DifferenceType offset);
+        // Advance the underlying iterator of `self` by `offset`, which may be
+        // negative.
 };
 
 template <typename RandIt, typename ValueType, typename Reference,
           typename Pointer, typename DifferenceType>
-struct AnyRandomAccessIterator_Impl final
-    : AnyRandomAccessIterator_Base<ValueType, Reference, Pointer, DifferenceType>
+struct AnyRandomAccessIterator_Impl final : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
     using difference_type = DifferenceType;
-
-private:
-    // PRIVATE TYPES
-    using BaseClass = AnyRandomAccessIterator_Base<ValueType, Reference, 
+    using VTable = AnyRandomAccessIterator_VTable<ValueType, Reference,
         Pointer, DifferenceType>;
 
-public:
     // CREATORS
     AnyRandomAccessIterator_Impl(RandIt it)
         noexcept(std::is_nothrow_copy_constructible_v<RandIt>);
 
     // ACCESSORS
-    const void* base() const noexcept override;
-
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
-
-    bool operator<(const BaseClass& rhs) const override;
-    bool operator>(const BaseClass& rhs) const override;
-
-    bool operator<=(const BaseClass& rhs) const override;
-    bool operator>=(const BaseClass& rhs) const override;
-
-    reference operator*() const override;
-    pointer operator->() const override;
-
-    reference operator[](difference_type offset) const override;
-
-    difference_type operator-(const BaseClass& rhs) const override;
+    const RandIt& iterator() const noexcept;
 
     // MANIPULATORS
-    void* base() noexcept override;
-
-    AnyRandomAccessIterator_Impl& operator++() override;
-    AnyRandomAccessIterator_Impl& operator--() override;
-    AnyRandomAccessIterator_Impl& operator+=(difference_type offset) override;
-    AnyRandomAccessIterator_Impl& operator-=(difference_type offset) override;
+    RandIt& iterator() noexcept;
+
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+    static int compare(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+
+    static reference dereference(const AnyIterator_Base& self);
+    static pointer arrow(const AnyIterator_Base& self);
+    static reference subscript(const AnyIterator_Base& self,
+                               difference_type offset);
+
+    static difference_type distance(const AnyIterator_Base& lhs,
+                                    const AnyIterator_Base& rhs);
+
+    static void increment(AnyIterator_Base& self);
+    static void decrement(AnyIterator_Base& self);
+    static void advance(AnyIterator_Base& self, difference_type offset);
+
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
+
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {{{&AnyRandomAccessIterator_Impl::base,
+           &AnyRandomAccessIterator_Impl::increment,
+           type_token::of<RandIt>()},
+          &AnyRandomAccessIterator_Impl::equal,
+          &AnyRandomAccessIterator_Impl::dereference,
+          &AnyRandomAccessIterator_Impl::arrow,
+          readEntry<AnyRandomAccessIterator_Impl, ValueType, Reference>(),
+          &AnyRandomAccessIterator_Impl::forEachUntil},
+         &AnyRandomAccessIterator_Impl::decrement},
+        &AnyRandomAccessIterator_Impl::subscript,
+        &AnyRandomAccessIterator_Impl::distance,
+        &AnyRandomAccessIterator_Impl::compare,
+        &AnyRandomAccessIterator_Impl::advance
+    };
 
 private:
     // DATA
@@ -82,49 +109,62 @@ private:
 template <typename ValueType, typename Reference,
           typename Pointer, typename DifferenceType>
 struct AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, DifferenceType> final
-    : AnyRandomAccessIterator_Base<ValueType, Reference, Pointer, DifferenceType>
+    : AnyIterator_Base
 {
     // TYPES
     using value_type = ValueType;
     using reference = Reference;
     using pointer = Pointer;
     using difference_type = DifferenceType;
-
-private:
-    // PRIVATE TYPES
-    using BaseClass = AnyRandomAccessIterator_Base<ValueType, Reference, 
+    using VTable = AnyRandomAccessIterator_VTable<ValueType, Reference,
         Pointer, DifferenceType>;
 
-public:
     // CREATORS
     constexpr AnyRandomAccessIterator_Impl() noexcept = default;
 
-    // ACCESSORS
-    const void* base() const noexcept override;
-
-    bool operator==(const AnyIterator_Base& rhs) const override;
-    bool operator!=(const AnyIterator_Base& rhs) const override;
-
-    bool operator<(const BaseClass& rhs) const override;
-    bool operator>(const BaseClass& rhs) const override;
-
-    bool operator<=(const BaseClass& rhs) const override;
-    bool operator>=(const BaseClass& rhs) const override;
-
-    reference operator*() const override;
-    pointer operator->() const override;
-
-    reference operator[](difference_type offset) const override;
-
-    difference_type operator-(const BaseClass& rhs) const override;
-
-    // MANIPULATORS
-    void* base() noexcept override;
-
-    AnyRandomAccessIterator_Impl& operator++() override;
-    AnyRandomAccessIterator_Impl& operator--() override;
-    AnyRandomAccessIterator_Impl& operator+=(difference_type offset) override;
-    AnyRandomAccessIterator_Impl& operator-=(difference_type offset) override;
+    // CLASS METHODS
+    static void* base(AnyIterator_Base& self) noexcept;
+
+    static bool equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+    static int compare(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs);
+
+    [[noreturn]] static reference dereference(const AnyIterator_Base& self);
+    [[noreturn]] static pointer arrow(const AnyIterator_Base& self);
+    [[noreturn]] static reference subscript(const AnyIterator_Base& self,
+                                            difference_type offset);
+
+    static difference_type distance(const AnyIterator_Base& lhs,
+                                    const AnyIterator_Base& rhs);
+
+    [[noreturn]] static void increment(AnyIterator_Base& self);
+    [[noreturn]] static void decrement(AnyIterator_Base& self);
+    [[noreturn]] static void advance(AnyIterator_Base& self,
+                                     difference_type offset);
+
+    static std::size_t read(AnyIterator_Base& self,
+                            std::remove_cv_t<value_type>* output,
+                            std::size_t count, const AnyIterator_Base& last);
+
+    static bool forEachUntil(AnyIterator_Base& self,
+                             const AnyIterator_Base& last,
+                             AnyIterator_Visitor<reference> visitor);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        {{{&AnyRandomAccessIterator_Impl::base,
+           &AnyRandomAccessIterator_Impl::increment,
+           type_token::of<void>()},
+          &AnyRandomAccessIterator_Impl::equal,
+          &AnyRandomAccessIterator_Impl::dereference,
+          &AnyRandomAccessIterator_Impl::arrow,
+          &AnyRandomAccessIterator_Impl::read,
+          &AnyRandomAccessIterator_Impl::forEachUntil},
+         &AnyRandomAccessIterator_Impl::decrement},
+        &AnyRandomAccessIterator_Impl::subscript,
+        &AnyRandomAccessIterator_Impl::distance,
+        &AnyRandomAccessIterator_Impl::compare,
+        &AnyRandomAccessIterator_Impl::advance
+    };
 };
 
 // ===========================================================================
@@ -133,7 +173,7 @@ public:
 // CREATORS
 template <typename RandIt, typename ValueType, typename Reference,
           typename Pointer, typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
+inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
     DifferenceType>::AnyRandomAccessIterator_Impl(RandIt it)
         noexcept(std::is_nothrow_copy_constructible_v<RandIt>)
     : d_it(it)
@@ -142,288 +182,232 @@ inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
 // ACCESSORS
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline const void* AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::base() const noexcept
-{
-    return static_cast<const void*>(&d_it);
-}
-
-template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline const void* AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::base() const noexcept
-{
-    return nullptr;
-}
-
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
-          typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator==(const AnyIterator_Base& rhs) const
-{
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it == ptr->d_it;
-}
-
-template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator==(const AnyIterator_Base& rhs) const
-{
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    return true;
-}
-
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer, 
-          typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator!=(const AnyIterator_Base& rhs) const
-{
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it != ptr->d_it;
-}
-
-template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator!=(const AnyIterator_Base& rhs) const
+inline const RandIt& AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::iterator() const noexcept
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    return false;
+    return d_it;
 }
 
+// MANIPULATORS
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator<(const BaseClass& rhs) const
-{
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it < ptr->d_it;
-}
-
-template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator<(const BaseClass& rhs) const
+inline RandIt& AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::iterator() noexcept
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    return false;
+    return d_it;
 }
 
+// CLASS METHODS
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator>(const BaseClass& rhs) const
+inline void* AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::base(AnyIterator_Base& self) noexcept
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it > ptr->d_it;
+    return static_cast<void*>(&static_cast<AnyRandomAccessIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator>(const BaseClass& rhs) const
+inline void* AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::base(AnyIterator_Base&) noexcept
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    return false;
+    return nullptr;
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator<=(const BaseClass& rhs) const
+inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::equal(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it <= ptr->d_it;
+    return static_cast<const AnyRandomAccessIterator_Impl&>(lhs).d_it ==
+        static_cast<const AnyRandomAccessIterator_Impl&>(rhs).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator<=(const BaseClass& rhs) const
+inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::equal(const AnyIterator_Base&, const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
     return true;
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator>=(const BaseClass& rhs) const
+inline int AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::compare(const AnyIterator_Base& lhs, const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it >= ptr->d_it;
+    const RandIt& l = static_cast<const AnyRandomAccessIterator_Impl&>(lhs).d_it;
+    const RandIt& r = static_cast<const AnyRandomAccessIterator_Impl&>(rhs).d_it;
+    return l < r ? -1 : (r < l ? 1 : 0);
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator>=(const BaseClass& rhs) const
+inline int AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::compare(const AnyIterator_Base&, const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    return true;
+    return 0;
 }
 
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer, 
+template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
 inline typename AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::reference AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::operator*() const
+    DifferenceType>::reference AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference,
+    Pointer, DifferenceType>::dereference(const AnyIterator_Base& self)
 {
-    return *d_it;
+    return *static_cast<const AnyRandomAccessIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::reference AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
-    DifferenceType>::operator*() const
+inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::reference AnyRandomAccessIterator_Impl<void, ValueType, Reference,
+    Pointer, DifferenceType>::dereference(const AnyIterator_Base&)
 {
     assert(false && "Cannot dereference a default constructed RandomAccessIterator");
+    std::abort();
 }
 
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer, 
+template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
 inline typename AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::pointer AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::operator->() const
+    DifferenceType>::pointer AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference,
+    Pointer, DifferenceType>::arrow(const AnyIterator_Base& self)
 {
-    return std::addressof(*d_it);
+    return std::addressof(*static_cast<const AnyRandomAccessIterator_Impl&>(self).d_it);
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
 inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
-    DifferenceType>::pointer AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
-    DifferenceType>::operator->() const
+    DifferenceType>::pointer AnyRandomAccessIterator_Impl<void, ValueType, Reference,
+    Pointer, DifferenceType>::arrow(const AnyIterator_Base&)
 {
     assert(false && "Cannot dereference a default constructed RandomAccessIterator");
+    std::abort();
 }
 
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer, 
+template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
 inline typename AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::reference AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::operator[](difference_type offset) const
+    DifferenceType>::reference AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference,
+    Pointer, DifferenceType>::subscript(const AnyIterator_Base& self,
+                                        difference_type offset)
 {
-    return d_it[offset];
+    return static_cast<const AnyRandomAccessIterator_Impl&>(self).d_it[offset];
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::reference AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
-    DifferenceType>::operator[](difference_type offset) const
+inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::reference AnyRandomAccessIterator_Impl<void, ValueType, Reference,
+    Pointer, DifferenceType>::subscript(const AnyIterator_Base&, difference_type)
 {
     assert(false && "Cannot dereference a default constructed RandomAccessIterator");
+    std::abort();
 }
 
-template <typename RandIt, typename ValueType, typename Reference, typename Pointer, 
+template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
 inline typename AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::difference_type AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
-    DifferenceType>::operator-(const BaseClass& rhs) const
+    DifferenceType>::difference_type AnyRandomAccessIterator_Impl<RandIt, ValueType,
+    Reference, Pointer, DifferenceType>::distance(const AnyIterator_Base& lhs,
+                                                  const AnyIterator_Base& rhs)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs));
-    const AnyRandomAccessIterator_Impl* const ptr = static_cast<const AnyRandomAccessIterator_Impl*>(&rhs);
-    return d_it - ptr->d_it;
+    return static_cast<const AnyRandomAccessIterator_Impl&>(lhs).d_it -
+        static_cast<const AnyRandomAccessIterator_Impl&>(rhs).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::difference_type AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
-    DifferenceType>::operator-(const BaseClass& rhs) const
+inline typename AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::difference_type AnyRandomAccessIterator_Impl<void, ValueType,
+    Reference, Pointer, DifferenceType>::distance(const AnyIterator_Base&,
+                                                  const AnyIterator_Base&)
 {
-    assert(dynamic_cast<const AnyRandomAccessIterator_Impl*>(&rhs)); // Can only subtract another
-                                                                     // default-constructed iterator.
-    return true;
+    return 0; // Two default constructed iterators are always equal.
 }
 
-// MANIPULATORS
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline void* AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::base() noexcept
+inline void AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::increment(AnyIterator_Base& self)
 {
-    return static_cast<void*>(&d_it);
+    ++static_cast<AnyRandomAccessIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline void* AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::base() noexcept
+inline void AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::increment(AnyIterator_Base&)
 {
-    return nullptr;
+    assert(false && "Cannot increment a default constructed RandomAccessIterator");
+    std::abort();
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator++()
+inline void AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::decrement(AnyIterator_Base& self)
 {
-    ++d_it;
-    return *this;
+    --static_cast<AnyRandomAccessIterator_Impl&>(self).d_it;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator++()
+inline void AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::decrement(AnyIterator_Base&)
 {
-    assert(false && "Cannot increment a default constructed RandomAccessIterator");
+    assert(false && "Cannot decrement a default constructed RandomAccessIterator");
+    std::abort();
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator--()
+inline void AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::advance(AnyIterator_Base& self, difference_type offset)
 {
-    --d_it;
-    return *this;
+    static_cast<AnyRandomAccessIterator_Impl&>(self).d_it += offset;
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator--()
+inline void AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::advance(AnyIterator_Base&, difference_type)
 {
-    assert(false && "Cannot decrement a default constructed RandomAccessIterator");
+    assert(false && "Cannot advance a default constructed RandomAccessIterator");
+    std::abort();
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator+=(difference_type offset)
+inline std::size_t AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::read(AnyIterator_Base& self, std::remove_cv_t<value_type>* output,
+                          std::size_t count, const AnyIterator_Base& last)
 {
-    d_it += offset;
-    return *this;
+    return bulkRead<Reference>(static_cast<AnyRandomAccessIterator_Impl&>(self).d_it,
+                               static_cast<const AnyRandomAccessIterator_Impl&>(last).d_it,
+                               output, count);
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator+=(difference_type)
+inline std::size_t AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::read(AnyIterator_Base&, std::remove_cv_t<value_type>*, std::size_t,
+                          const AnyIterator_Base&)
 {
-    assert(false && "Cannot increment a default constructed RandomAccessIterator");
+    return 0;
 }
 
 template <typename RandIt, typename ValueType, typename Reference, typename Pointer,
           typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer, 
-    DifferenceType>::operator-=(difference_type offset)
+inline bool AnyRandomAccessIterator_Impl<RandIt, ValueType, Reference, Pointer,
+    DifferenceType>::forEachUntil(
+    AnyIterator_Base& self, const AnyIterator_Base& last,
+    AnyIterator_Visitor<reference> visitor)
 {
-    d_it -= offset;
-    return *this;
+    return visitUntil(static_cast<AnyRandomAccessIterator_Impl&>(self).d_it,
+                      static_cast<const AnyRandomAccessIterator_Impl&>(last).d_it,
+                      visitor);
 }
 
 template <typename ValueType, typename Reference, typename Pointer, typename DifferenceType>
-inline AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, DifferenceType>&
-    AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer, 
-    DifferenceType>::operator-=(difference_type)
+inline bool AnyRandomAccessIterator_Impl<void, ValueType, Reference, Pointer,
+    DifferenceType>::forEachUntil(
+    AnyIterator_Base&, const AnyIterator_Base&, AnyIterator_Visitor<reference>)
 {
-    assert(false && "Cannot increment a default constructed RandomAccessIterator");
+    return false;
 }
 
-
 } // close namespace sample::detail
 
 #endif // SAMPLE_ANYRANDOMACCESSITERATOR_BASE
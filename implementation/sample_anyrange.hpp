@@ -0,0 +1,338 @@
+#ifndef SAMPLE_ANYRANGE
+#define SAMPLE_ANYRANGE
+
+#include <sample_anyiterator.hpp>
+#include <sample_anyrange_base.hpp>
+#include <sample_anysentinel.hpp>
+#include <sample_storagepolicy.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sample {
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType = ValueType&,
+          typename PointerType = ValueType*,
+          typename DifferenceType = std::ptrdiff_t,
+          typename StoragePolicy = default_storage>
+struct any_range;
+    // An `any_range` holds any range whose iterators satisfy
+    // `IteratorCategory` and yield `ReferenceType`, storing its begin and
+    // end together, as a single object under `StoragePolicy`.  Its
+    // iterators are `any_iterator`s with the same template parameters, and
+    // its end is an `any_sentinel` for them, so that each step of a loop
+    // over the range compares the underlying iterator with the underlying
+    // end directly, with a single dispatch.
+
+inline namespace {
+    template <typename ValueType,
+              typename ReferenceType = ValueType&,
+              typename PointerType = ValueType*,
+              typename DifferenceType = std::ptrdiff_t,
+              typename StoragePolicy = default_storage>
+    using any_input_range = any_range<std::input_iterator_tag, ValueType,
+        ReferenceType, PointerType, DifferenceType, StoragePolicy>;
+
+    template <typename ValueType,
+              typename ReferenceType = ValueType&,
+              typename PointerType = ValueType*,
+              typename DifferenceType = std::ptrdiff_t,
+              typename StoragePolicy = default_storage>
+    using any_forward_range = any_range<std::forward_iterator_tag, ValueType,
+        ReferenceType, PointerType, DifferenceType, StoragePolicy>;
+
+    template <typename ValueType,
+              typename ReferenceType = ValueType&,
+              typename PointerType = ValueType*,
+              typename DifferenceType = std::ptrdiff_t,
+              typename StoragePolicy = default_storage>
+    using any_bidirectional_range = any_range<std::bidirectional_iterator_tag,
+        ValueType, ReferenceType, PointerType, DifferenceType, StoragePolicy>;
+
+    template <typename ValueType,
+              typename ReferenceType = ValueType&,
+              typename PointerType = ValueType*,
+              typename DifferenceType = std::ptrdiff_t,
+              typename StoragePolicy = default_storage>
+    using any_random_access_range = any_range<std::random_access_iterator_tag,
+        ValueType, ReferenceType, PointerType, DifferenceType, StoragePolicy>;
+} // close anonymous inline namespace
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+struct any_range {
+private:
+    // PRIVATE TYPES
+    template <typename Range>
+    using RangeIterator = decltype(std::begin(std::declval<Range&>()));
+
+    template <typename Range>
+    static constexpr bool is_source_v = !std::is_same_v<
+        std::remove_cvref_t<Range>, any_range> &&
+        std::is_base_of_v<IteratorCategory, typename std::iterator_traits<
+            RangeIterator<Range>>::iterator_category>;
+
+public:
+    // TYPES
+    using iterator = any_iterator<IteratorCategory, ValueType, ReferenceType,
+        PointerType, DifferenceType, StoragePolicy>;
+    using sentinel = any_sentinel<iterator>;
+    using value_type = ValueType;
+    using reference = ReferenceType;
+    using pointer = PointerType;
+    using difference_type = DifferenceType;
+    using size_type = std::size_t;
+    using storage_policy = StoragePolicy;
+
+    // CREATORS
+    template <typename It,
+              typename = std::enable_if_t<std::is_base_of_v<
+                IteratorCategory,
+                typename std::iterator_traits<It>::iterator_category
+              >>>
+    any_range(It first, It last);
+        // Construct an `any_range` over the elements from `first` up to
+        // `last`.  The range is sized if `It` is a random access iterator.
+        //
+        // Throws if allocation was required and failed, or if the move
+        // constructor of `It` throws.
+
+    template <typename Range,
+              typename = std::enable_if_t<is_source_v<Range>>>
+    any_range(Range&& range);
+        // Construct an `any_range` over the elements of `range`.  If `range`
+        // is an lvalue, then only its address is stored, and it must outlive
+        // the `any_range`.  Otherwise `range` is moved into the
+        // `any_range`, which then owns it, and copying the `any_range`
+        // copies it.  The range is sized if `std::size` applies to it or its
+        // iterators are random access.
+        //
+        // Iterators into an owned range are invalidated when the `any_range`
+        // is moved if the range holds its elements inline, as `std::array`
+        // does.
+        //
+        // Throws if allocation was required and failed, or if the relevant
+        // constructor of `Range` throws.
+
+    any_range(const any_range&) = default;
+    any_range(any_range&&) noexcept = default;
+    ~any_range() = default;
+
+    // ACCESSORS
+    iterator begin() const;
+        // Returns an iterator to the first element of the range.
+
+    sentinel end() const;
+        // Returns a sentinel which the iterators of the range reach past its
+        // last element.
+
+    iterator last() const;
+        // Returns an iterator past the last element of the range, for use
+        // where an iterator is required, such as to delimit a subrange.
+
+    bool is_sized() const noexcept;
+        // Returns whether `size()` may be called, i.e. whether the number
+        // of elements is known in constant time.
+
+    size_type size() const;
+        // Returns the number of elements in the range in constant time.  The
+        // behaviour is undefined unless `is_sized()` is `true`.
+
+    bool empty() const;
+        // Returns whether the range has no elements.
+
+    // MANIPULATORS
+    any_range& operator=(const any_range& rhs);
+    any_range& operator=(any_range&& rhs) noexcept = default;
+
+    void swap(any_range& other) noexcept;
+
+private:
+    // PRIVATE TYPES
+    using VTableType = detail::AnyRange_VTable<iterator, sentinel>;
+    using BufferType = detail::storage_buffer_t<detail::AnyRange_Base,
+        StoragePolicy>;
+
+    template <typename Range>
+    using ImplType = detail::AnyRange_Impl<Range, iterator, sentinel>;
+
+    template <typename Range>
+    using SourceType = std::conditional_t<std::is_lvalue_reference_v<Range>,
+        detail::RangeReference<std::remove_reference_t<Range>>,
+        std::remove_cv_t<Range>>;
+        // The range which an `any_range` constructed from a `Range&&` holds.
+
+private:
+    // PRIVATE CREATORS
+    template <typename Impl, typename Source>
+    any_range(std::in_place_type_t<Impl>, Source&& source);
+
+private:
+    // DATA
+    const VTableType* d_vtable;  // operations on the object in `d_buffer`
+    BufferType        d_buffer;
+};
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+void swap(any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+                    DifferenceType, StoragePolicy>& lhs,
+          any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+                    DifferenceType, StoragePolicy>& rhs) noexcept;
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+template <typename It, typename>
+inline any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::any_range(It first, It last)
+    : any_range(std::in_place_type<ImplType<detail::IteratorPair<It>>>,
+        detail::IteratorPair<It>{std::move(first), std::move(last)})
+{}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+template <typename Range, typename>
+inline any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::any_range(Range&& range)
+    : any_range(std::in_place_type<ImplType<SourceType<Range>>>, [&] {
+        if constexpr (std::is_lvalue_reference_v<Range>) {
+            return SourceType<Range>{std::addressof(range)};
+        } else {
+            return std::move(range);
+        }
+    }())
+{}
+
+// PRIVATE CREATORS
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+template <typename Impl, typename Source>
+inline any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::any_range(std::in_place_type_t<Impl>,
+        Source&& source)
+    : d_vtable(&Impl::vtable)
+    , d_buffer(std::in_place_type<Impl>, std::forward<Source>(source))
+{}
+
+// ACCESSORS
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline typename any_range<IteratorCategory, ValueType, ReferenceType,
+    PointerType, DifferenceType, StoragePolicy>::iterator
+    any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+        DifferenceType, StoragePolicy>::begin() const
+{
+    return d_vtable->begin(*d_buffer);
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline typename any_range<IteratorCategory, ValueType, ReferenceType,
+    PointerType, DifferenceType, StoragePolicy>::sentinel
+    any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+        DifferenceType, StoragePolicy>::end() const
+{
+    return d_vtable->end(*d_buffer);
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline typename any_range<IteratorCategory, ValueType, ReferenceType,
+    PointerType, DifferenceType, StoragePolicy>::iterator
+    any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+        DifferenceType, StoragePolicy>::last() const
+{
+    return d_vtable->last(*d_buffer);
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline bool any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::is_sized() const noexcept
+{
+    return d_vtable->size != nullptr;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline typename any_range<IteratorCategory, ValueType, ReferenceType,
+    PointerType, DifferenceType, StoragePolicy>::size_type
+    any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+        DifferenceType, StoragePolicy>::size() const
+{
+    assert(is_sized());
+    return d_vtable->size(*d_buffer);
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline bool any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::empty() const
+{
+    if (is_sized()) {
+        return size() == 0;
+    }
+    return begin() == end();
+}
+
+// MANIPULATORS
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>&
+    any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+        DifferenceType, StoragePolicy>::operator=(const any_range& rhs)
+{
+    any_range tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline void any_range<IteratorCategory, ValueType, ReferenceType, PointerType,
+    DifferenceType, StoragePolicy>::swap(any_range& other) noexcept
+{
+    using std::swap;
+    swap(d_vtable, other.d_vtable);
+    swap(d_buffer, other.d_buffer);
+}
+
+// FREE FUNCTIONS
+template <typename IteratorCategory, typename ValueType,
+          typename ReferenceType, typename PointerType,
+          typename DifferenceType, typename StoragePolicy>
+inline void swap(any_range<IteratorCategory, ValueType, ReferenceType,
+                           PointerType, DifferenceType, StoragePolicy>& lhs,
+                 any_range<IteratorCategory, ValueType, ReferenceType,
+                           PointerType, DifferenceType, StoragePolicy>& rhs)
+    noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_ANYRANGE
@@ -0,0 +1,175 @@
+#ifndef SAMPLE_ANYRANGE_BASE
+#define SAMPLE_ANYRANGE_BASE
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace sample::detail {
+
+struct AnyRange_Base {};
+    // The common base of every object held by an `any_range`.
+
+template <typename It>
+struct IteratorPair {
+    // This class presents a pair of iterators as a range.
+
+    // DATA
+    It d_first;
+    It d_last;
+
+    // ACCESSORS
+    It begin() const { return d_first; }
+    It end() const { return d_last; }
+};
+
+template <typename Range>
+struct RangeReference;
+
+template <typename Range, typename = void>
+struct has_size : std::false_type {};
+    // Trait detecting whether `std::size` applies to a `Range`.
+
+template <typename Range>
+struct has_size<Range,
+    std::void_t<decltype(std::size(std::declval<Range&>()))>>
+    : std::true_type {};
+
+template <typename Range>
+constexpr bool has_size_v = has_size<Range>::value;
+
+template <typename Range>
+struct RangeReference {
+    // This class presents a reference to a range as a range.
+
+    // DATA
+    Range* d_range;
+
+    // ACCESSORS
+    auto begin() const { return std::begin(*d_range); }
+    auto end() const { return std::end(*d_range); }
+
+    template <typename R = Range, typename = std::enable_if_t<has_size_v<R>>>
+    auto size() const { return std::size(*d_range); }
+};
+
+template <typename Range>
+constexpr bool is_sized_range_v = has_size_v<Range> || std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<decltype(std::begin(
+        std::declval<Range&>()))>::iterator_category>;
+    // Whether the number of elements of a `Range` is known in constant
+    // time, i.e. whether `std::size` applies to it or its iterators are
+    // random access.
+
+template <typename Iterator, typename Sentinel>
+struct AnyRange_VTable {
+    // DATA
+    Iterator (*begin)(AnyRange_Base& self);
+        // Return an `Iterator` to the first element of `self`.
+
+    Sentinel (*end)(AnyRange_Base& self);
+        // Return a `Sentinel` reached past the last element of `self`.
+
+    Iterator (*last)(AnyRange_Base& self);
+        // Return an `Iterator` past the last element of `self`.
+
+    std::size_t (*size)(AnyRange_Base& self);
+        // Return the number of elements of `self` in constant time, or the
+        // null pointer if that is not possible.
+};
+
+template <typename Range, typename Iterator, typename Sentinel>
+struct AnyRange_Impl final : AnyRange_Base
+{
+    // TYPES
+    using VTable = AnyRange_VTable<Iterator, Sentinel>;
+
+    // CREATORS
+    AnyRange_Impl(Range range)
+        noexcept(std::is_nothrow_move_constructible_v<Range>);
+
+    // CLASS METHODS
+    static Iterator begin(AnyRange_Base& self);
+    static Sentinel end(AnyRange_Base& self);
+    static Iterator last(AnyRange_Base& self);
+    static std::size_t size(AnyRange_Base& self);
+
+    static constexpr std::size_t (*sizeFunction())(AnyRange_Base&);
+        // Return `&size` if `Range` is sized, and the null pointer
+        // otherwise.
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        &AnyRange_Impl::begin,
+        &AnyRange_Impl::end,
+        &AnyRange_Impl::last,
+        AnyRange_Impl::sizeFunction()
+    };
+
+private:
+    // DATA
+    Range d_range;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+template <typename Range, typename Iterator, typename Sentinel>
+inline AnyRange_Impl<Range, Iterator, Sentinel>::AnyRange_Impl(Range range)
+    noexcept(std::is_nothrow_move_constructible_v<Range>)
+    : d_range(std::move(range))
+{}
+
+// CLASS METHODS
+template <typename Range, typename Iterator, typename Sentinel>
+inline Iterator AnyRange_Impl<Range, Iterator, Sentinel>::begin(
+    AnyRange_Base& self)
+{
+    return Iterator(std::begin(static_cast<AnyRange_Impl&>(self).d_range));
+}
+
+template <typename Range, typename Iterator, typename Sentinel>
+inline Sentinel AnyRange_Impl<Range, Iterator, Sentinel>::end(
+    AnyRange_Base& self)
+{
+    Range& range = static_cast<AnyRange_Impl&>(self).d_range;
+    return Sentinel(std::in_place_type<decltype(std::begin(range))>,
+                    std::end(range));
+}
+
+template <typename Range, typename Iterator, typename Sentinel>
+inline Iterator AnyRange_Impl<Range, Iterator, Sentinel>::last(
+    AnyRange_Base& self)
+{
+    return Iterator(std::end(static_cast<AnyRange_Impl&>(self).d_range));
+}
+
+template <typename Range, typename Iterator, typename Sentinel>
+inline std::size_t AnyRange_Impl<Range, Iterator, Sentinel>::size(
+    AnyRange_Base& self)
+{
+    Range& range = static_cast<AnyRange_Impl&>(self).d_range;
+    if constexpr (has_size_v<Range>) {
+        return std::size(range);
+    } else {
+        return static_cast<std::size_t>(std::end(range) - std::begin(range));
+    }
+}
+
+template <typename Range, typename Iterator, typename Sentinel>
+inline constexpr std::size_t (*AnyRange_Impl<Range, Iterator,
+    Sentinel>::sizeFunction())(AnyRange_Base&)
+{
+    if constexpr (is_sized_range_v<Range>) {
+        return &AnyRange_Impl::size;
+    } else {
+        return nullptr;
+    }
+}
+
+} // close namespace sample::detail
+
+#endif // SAMPLE_ANYRANGE_BASE
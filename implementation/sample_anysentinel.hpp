@@ -0,0 +1,179 @@
+#ifndef SAMPLE_ANYSENTINEL
+#define SAMPLE_ANYSENTINEL
+
+#include <sample_anyiterator.hpp>
+#include <sample_anysentinel_base.hpp>
+#include <sample_stats.hpp>
+#include <sample_storagepolicy.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sample {
+
+template <typename AnyIterator>
+struct any_sentinel {
+    // An `any_sentinel` holds any sentinel for the underlying iterators of
+    // `AnyIterator`s, so that a range whose end is not an iterator of the
+    // same type as its begin, such as a null terminated buffer or a counted
+    // stream, can be traversed by `AnyIterator`s without constructing an
+    // `AnyIterator` for its end.  Comparing an `AnyIterator` with an
+    // `any_sentinel` dispatches once, directly to the comparison of the
+    // underlying iterator with the underlying sentinel.
+    //
+    // An `any_sentinel` models `std::sentinel_for<AnyIterator>`, and so may
+    // be used with the `std::ranges` algorithms and `std::ranges::subrange`.
+
+    // TYPES
+    using iterator = AnyIterator;
+    using storage_policy = typename AnyIterator::storage_policy;
+
+    // CREATORS
+    any_sentinel() noexcept;
+        // Construct an `any_sentinel` which no iterator reaches.
+
+    any_sentinel(std::unreachable_sentinel_t) noexcept;
+        // Construct an `any_sentinel` which no iterator reaches.  Comparing
+        // such a sentinel involves no dispatch.  Where the end of a range is
+        // known at compile time to be unreachable, `std::unreachable_sentinel`
+        // may be used with `AnyIterator`s directly, with no comparison at
+        // all.
+
+    template <typename It, typename Sentinel>
+    any_sentinel(std::in_place_type_t<It>, Sentinel sentinel);
+        // Construct an `any_sentinel` comparing `sentinel` with the
+        // underlying iterators of `AnyIterator`s constructed from an `It`.
+        //
+        // If `AnyIterator` stores `It` as a pointer then `sentinel` is
+        // compared with that pointer, and so must either be comparable with
+        // it or be an `It`, in which case its address is compared.
+        //
+        // Throws if allocation was required and failed, or if the move
+        // constructor of `Sentinel` throws.
+
+    any_sentinel(const any_sentinel&) = default;
+    any_sentinel(any_sentinel&&) noexcept = default;
+    ~any_sentinel() = default;
+
+    // ACCESSORS
+    bool operator==(const AnyIterator& it) const;
+        // Returns whether `it` has reached this sentinel.  The behaviour is
+        // undefined unless the underlying iterator of `it` is an `It` as
+        // given on construction of this sentinel, whether `it` was
+        // constructed from it or converted from an `any_iterator` of a
+        // stronger category which was.
+
+    // MANIPULATORS
+    any_sentinel& operator=(const any_sentinel& rhs);
+    any_sentinel& operator=(any_sentinel&& rhs) noexcept = default;
+
+    void swap(any_sentinel& other) noexcept;
+
+private:
+    // PRIVATE TYPES
+    using VTableType = detail::AnySentinel_VTable;
+    using BufferType = detail::storage_buffer_t<detail::AnySentinel_Base,
+        storage_policy>;
+
+    template <typename It>
+    using IteratorImpl = typename AnyIterator::template ImplType<It>;
+
+    template <typename It, typename Sentinel>
+    static constexpr bool compares_by_address_v =
+        AnyIterator::template is_contiguous_source_v<It> &&
+        std::is_same_v<std::decay_t<Sentinel>, It>;
+
+    template <typename It, typename Sentinel>
+    using ImplType = std::conditional_t<
+        AnyIterator::template is_contiguous_source_v<It>,
+        detail::AnySentinel_Impl<IteratorImpl<It>,
+            typename AnyIterator::pointer,
+            std::conditional_t<compares_by_address_v<It, Sentinel>,
+                typename AnyIterator::pointer, Sentinel>>,
+        detail::AnySentinel_Impl<IteratorImpl<It>, It, Sentinel>>;
+
+private:
+    // DATA
+    const VTableType* d_vtable;  // null if the sentinel is unreachable
+    BufferType        d_buffer;
+};
+
+template <typename AnyIterator>
+void swap(any_sentinel<AnyIterator>& lhs,
+          any_sentinel<AnyIterator>& rhs) noexcept;
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+template <typename AnyIterator>
+inline any_sentinel<AnyIterator>::any_sentinel() noexcept
+    : any_sentinel(std::unreachable_sentinel)
+{}
+
+template <typename AnyIterator>
+inline any_sentinel<AnyIterator>::any_sentinel(std::unreachable_sentinel_t)
+    noexcept
+    : d_vtable(nullptr)
+    , d_buffer(detail::inPlaceStatic<detail::AnySentinel_Unreachable>)
+{}
+
+template <typename AnyIterator>
+template <typename It, typename Sentinel>
+inline any_sentinel<AnyIterator>::any_sentinel(std::in_place_type_t<It>,
+    Sentinel sentinel)
+    : d_vtable(&ImplType<It, Sentinel>::vtable)
+    , d_buffer(std::in_place_type<ImplType<It, Sentinel>>, [&] {
+        if constexpr (compares_by_address_v<It, Sentinel>) {
+            return typename AnyIterator::pointer(std::to_address(sentinel));
+        } else {
+            return std::move(sentinel);
+        }
+    }())
+{}
+
+// ACCESSORS
+template <typename AnyIterator>
+inline bool any_sentinel<AnyIterator>::operator==(const AnyIterator& it) const
+{
+    if (!d_vtable) {
+        return false;
+    }
+
+    assert(d_vtable->type == it.d_vtable->type);
+    detail::statsCount(it.d_vtable->type, stats_counter::equal);
+    return d_vtable->equal(*d_buffer, *it.d_buffer);
+}
+
+// MANIPULATORS
+template <typename AnyIterator>
+inline any_sentinel<AnyIterator>& any_sentinel<AnyIterator>::operator=(
+    const any_sentinel& rhs)
+{
+    any_sentinel tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename AnyIterator>
+inline void any_sentinel<AnyIterator>::swap(any_sentinel& other) noexcept
+{
+    using std::swap;
+    swap(d_vtable, other.d_vtable);
+    swap(d_buffer, other.d_buffer);
+}
+
+// FREE FUNCTIONS
+template <typename AnyIterator>
+inline void swap(any_sentinel<AnyIterator>& lhs,
+                 any_sentinel<AnyIterator>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_ANYSENTINEL
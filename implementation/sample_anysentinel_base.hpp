@@ -0,0 +1,75 @@
+#ifndef SAMPLE_ANYSENTINEL_BASE
+#define SAMPLE_ANYSENTINEL_BASE
+
+#include <sample_anyiterator_base.hpp>
+
+#include <type_traits>
+
+namespace sample::detail {
+
+struct AnySentinel_Base {};
+    // The common base of every object held by an `any_sentinel`.
+
+struct AnySentinel_VTable {
+    // DATA
+    bool (*equal)(const AnySentinel_Base& self, AnyIterator_Base& it);
+        // Return whether the iterator held by `it` has reached the sentinel
+        // held by `self`.
+
+    type_token type;
+        // The type of the underlying iterators which may be compared with
+        // the sentinel.
+};
+
+template <typename IteratorImpl, typename Iterator, typename Sentinel>
+struct AnySentinel_Impl final : AnySentinel_Base
+{
+    // TYPES
+    using VTable = AnySentinel_VTable;
+
+    // CREATORS
+    AnySentinel_Impl(Sentinel sentinel)
+        noexcept(std::is_nothrow_move_constructible_v<Sentinel>);
+
+    // CLASS METHODS
+    static bool equal(const AnySentinel_Base& self, AnyIterator_Base& it);
+
+    // CLASS DATA
+    static constexpr VTable vtable = {
+        &AnySentinel_Impl::equal,
+        IteratorImpl::vtable.type
+    };
+
+private:
+    // DATA
+    Sentinel d_sentinel;
+};
+
+struct AnySentinel_Unreachable final : AnySentinel_Base {};
+    // The object held by an `any_sentinel` which no iterator reaches.
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+template <typename IteratorImpl, typename Iterator, typename Sentinel>
+inline AnySentinel_Impl<IteratorImpl, Iterator, Sentinel>::AnySentinel_Impl(
+    Sentinel sentinel)
+    noexcept(std::is_nothrow_move_constructible_v<Sentinel>)
+    : d_sentinel(std::move(sentinel))
+{}
+
+// CLASS METHODS
+template <typename IteratorImpl, typename Iterator, typename Sentinel>
+inline bool AnySentinel_Impl<IteratorImpl, Iterator, Sentinel>::equal(
+    const AnySentinel_Base& self, AnyIterator_Base& it)
+{
+    // `IteratorImpl::base` is called directly, so that the comparison
+    // dispatches only once.
+    return *static_cast<const Iterator*>(IteratorImpl::base(it)) ==
+        static_cast<const AnySentinel_Impl&>(self).d_sentinel;
+}
+
+} // close namespace sample::detail
+
+#endif // SAMPLE_ANYSENTINEL_BASE
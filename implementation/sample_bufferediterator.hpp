@@ -0,0 +1,382 @@
+#ifndef SAMPLE_BUFFEREDITERATOR
+#define SAMPLE_BUFFEREDITERATOR
+
+#include <sample_anyiterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace sample {
+namespace detail {
+
+constexpr std::size_t BUFFERED_ITERATOR_BYTES = 256ul;
+constexpr std::size_t MAX_BUFFERED_ITERATOR_COUNT = 64ul;
+
+template <typename ValueType>
+constexpr std::size_t bufferedIteratorCapacity = std::clamp(
+    BUFFERED_ITERATOR_BYTES / sizeof(ValueType), std::size_t{1},
+    MAX_BUFFERED_ITERATOR_COUNT);
+    // The number of elements of `ValueType` held by a buffered iterator.
+    // This is smaller than the batches read by the algorithms, since the
+    // buffer is part of the iterator and so is copied with it.
+
+} // close namespace detail
+
+template <typename AnyIterator,
+          std::size_t Capacity = detail::bufferedIteratorCapacity<
+              std::remove_cv_t<typename AnyIterator::value_type>>>
+struct buffered_input_iterator {
+    // A `buffered_input_iterator` reads ahead from an input `AnyIterator`
+    // into a local array, refilling it with a single dispatch to the
+    // underlying iterator per `Capacity` elements, so that dereferencing and
+    // incrementing it are plain loads in the common case.  This makes
+    // element-wise algorithms such as `std::copy` and `std::transform` over
+    // erased iterators cheaper without changing the algorithm called.
+    //
+    // Like `std::istream_iterator`, a `buffered_input_iterator` reads its
+    // first elements on construction and is compared only against the end
+    // iterator, which is default constructed.  It is a single pass input
+    // iterator whatever the category of `AnyIterator`, and elements are
+    // copied into the buffer, so `reference` is a reference to the buffered
+    // copy rather than to the underlying element.
+
+    // TYPES
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::remove_cv_t<typename AnyIterator::value_type>;
+    using difference_type = typename AnyIterator::difference_type;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    // CREATORS
+    buffered_input_iterator() = default;
+        // Construct the end iterator.
+
+    buffered_input_iterator(AnyIterator first, AnyIterator last);
+        // Construct a `buffered_input_iterator` reading the elements in the
+        // range `[first, last)`, and read the first of them.
+        //
+        // The behaviour is undefined unless `first` and `last` hold
+        // underlying iterators of the same type.
+
+    // ACCESSORS
+    reference operator*() const noexcept;
+        // Returns a reference to the current element.  The behaviour is
+        // undefined if `*this` is the end iterator.
+
+    pointer operator->() const noexcept;
+        // Returns the address of the current element.  The behaviour is
+        // undefined if `*this` is the end iterator.
+
+    bool operator==(const buffered_input_iterator& rhs) const noexcept;
+        // Returns whether `*this` and `rhs` have both reached the end of
+        // their ranges.
+
+    // MANIPULATORS
+    buffered_input_iterator& operator++();
+        // Advances to the next element, refilling the buffer from the
+        // underlying iterator if it has been consumed, and returns a
+        // reference to `*this`.
+
+    buffered_input_iterator operator++(int);
+        // Creates a copy of `*this`, then advances `*this` to the next
+        // element and returns the copy.
+
+private:
+    // PRIVATE MANIPULATORS
+    void refill();
+        // Reads up to `Capacity` elements from the underlying iterator into
+        // the buffer with a single dispatch.
+
+private:
+    // DATA
+    std::optional<AnyIterator>          d_first;      // next unread element
+    std::optional<AnyIterator>          d_last;       // end of the range
+    std::array<value_type, Capacity>    d_buffer{};
+    std::size_t                         d_position = 0;
+    std::size_t                         d_count = 0;  // 0 when at the end
+};
+
+template <typename AnyIterator,
+          std::size_t Capacity = detail::bufferedIteratorCapacity<
+              std::remove_cv_t<typename AnyIterator::value_type>>>
+struct buffered_output_iterator {
+    // A `buffered_output_iterator` collects the values assigned through it
+    // in a local array and writes them to an output `AnyIterator` with a
+    // single dispatch per `Capacity` elements, using `write_n`, so that
+    // assigning through it is a plain store in the common case.
+    //
+    // Values reach the underlying iterator when the buffer is full, on
+    // `flush`, and on destruction.  Copying a `buffered_output_iterator`
+    // flushes the source first, so that a value is never buffered by two
+    // iterators, and copies then write through their own copies of the
+    // underlying iterator.  Since a destructor cannot report failure, an
+    // exception thrown by the underlying iterator while flushing on
+    // destruction terminates the program; call `flush` beforehand where
+    // writing may throw.
+
+    // TYPES
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using reference = void;
+    using pointer = void;
+
+    // CREATORS
+    buffered_output_iterator(AnyIterator it);
+        // Construct a `buffered_output_iterator` writing through `it`.
+
+    buffered_output_iterator(const buffered_output_iterator& other);
+        // Flush `other`, then construct a `buffered_output_iterator` writing
+        // through a copy of its underlying iterator.
+
+    buffered_output_iterator(buffered_output_iterator&& other) noexcept(
+        std::is_nothrow_move_constructible_v<AnyIterator> &&
+        std::is_nothrow_move_constructible_v<
+            typename AnyIterator::value_type>);
+        // Construct a `buffered_output_iterator` taking over the underlying
+        // iterator and the buffered values of `other`, which is left with an
+        // empty buffer.
+
+    ~buffered_output_iterator();
+        // Flush, then destroy the `buffered_output_iterator`.
+
+    // MANIPULATORS
+    buffered_output_iterator& operator=(const buffered_output_iterator& rhs);
+    buffered_output_iterator& operator=(buffered_output_iterator&& rhs);
+        // Flush `*this`, then assign as on construction.
+
+    buffered_output_iterator& operator*() noexcept;
+    buffered_output_iterator& operator++() noexcept;
+    buffered_output_iterator& operator++(int) noexcept;
+        // Performs a `no-op`, returning a reference to `*this`.
+
+    buffered_output_iterator& operator=(
+        const typename AnyIterator::value_type& value);
+    buffered_output_iterator& operator=(
+        typename AnyIterator::value_type&& value);
+        // Appends `value` to the buffer, flushing the buffer first if it is
+        // full, and returns a reference to `*this`.
+
+    void flush();
+        // Writes the buffered values through the underlying iterator with a
+        // single dispatch, and empties the buffer.
+
+private:
+    // PRIVATE TYPES
+    using ValueType = std::remove_cv_t<typename AnyIterator::value_type>;
+
+    // PRIVATE CLASS METHODS
+    static const AnyIterator& flushed(const buffered_output_iterator& other);
+        // Flushes `other` and returns its underlying iterator.  Flushing
+        // does not change the observable state of `other`.
+
+private:
+    // DATA
+    AnyIterator                         d_it;
+    std::array<ValueType, Capacity>     d_buffer{};
+    std::size_t                         d_count = 0;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// ---------------------------------------------------------------------------
+//      buffered_input_iterator
+// ---------------------------------------------------------------------------
+// CREATORS
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_input_iterator<AnyIterator, Capacity>::buffered_input_iterator(
+    AnyIterator first, AnyIterator last)
+    : d_first(std::in_place, std::move(first))
+    , d_last(std::in_place, std::move(last))
+{
+    refill();
+}
+
+// ACCESSORS
+template <typename AnyIterator, std::size_t Capacity>
+inline typename buffered_input_iterator<AnyIterator, Capacity>::reference
+    buffered_input_iterator<AnyIterator, Capacity>::operator*() const noexcept
+{
+    return d_buffer[d_position];
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline typename buffered_input_iterator<AnyIterator, Capacity>::pointer
+    buffered_input_iterator<AnyIterator, Capacity>::operator->() const
+    noexcept
+{
+    return &d_buffer[d_position];
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline bool buffered_input_iterator<AnyIterator, Capacity>::operator==(
+    const buffered_input_iterator& rhs) const noexcept
+{
+    return (d_count == 0) == (rhs.d_count == 0);
+}
+
+// MANIPULATORS
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_input_iterator<AnyIterator, Capacity>&
+    buffered_input_iterator<AnyIterator, Capacity>::operator++()
+{
+    if (++d_position == d_count) {
+        refill();
+    }
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_input_iterator<AnyIterator, Capacity>
+    buffered_input_iterator<AnyIterator, Capacity>::operator++(int)
+{
+    auto tmp{*this};
+    ++*this;
+    return tmp;
+}
+
+// PRIVATE MANIPULATORS
+template <typename AnyIterator, std::size_t Capacity>
+inline void buffered_input_iterator<AnyIterator, Capacity>::refill()
+{
+    d_count = d_first->read(d_buffer.data(), Capacity, *d_last);
+    d_position = 0;
+}
+
+// ---------------------------------------------------------------------------
+//      buffered_output_iterator
+// ---------------------------------------------------------------------------
+// CREATORS
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>::
+    buffered_output_iterator(AnyIterator it)
+    : d_it(std::move(it))
+{}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>::
+    buffered_output_iterator(const buffered_output_iterator& other)
+    : d_it(flushed(other))
+{}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>::
+    buffered_output_iterator(buffered_output_iterator&& other) noexcept(
+        std::is_nothrow_move_constructible_v<AnyIterator> &&
+        std::is_nothrow_move_constructible_v<
+            typename AnyIterator::value_type>)
+    : d_it(std::move(other.d_it))
+    , d_count(std::exchange(other.d_count, 0))
+{
+    std::move(other.d_buffer.begin(), other.d_buffer.begin() + d_count,
+              d_buffer.begin());
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>::
+    ~buffered_output_iterator()
+{
+    flush();
+}
+
+// MANIPULATORS
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator=(
+        const buffered_output_iterator& rhs)
+{
+    if (this != &rhs) {
+        flush();
+        d_it = flushed(rhs);
+    }
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator=(
+        buffered_output_iterator&& rhs)
+{
+    if (this != &rhs) {
+        flush();
+        d_it = std::move(rhs.d_it);
+        d_count = std::exchange(rhs.d_count, 0);
+        std::move(rhs.d_buffer.begin(), rhs.d_buffer.begin() + d_count,
+                  d_buffer.begin());
+    }
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator*() noexcept
+{
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator++() noexcept
+{
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator++(int) noexcept
+{
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator=(
+        const typename AnyIterator::value_type& value)
+{
+    if (d_count == Capacity) {
+        flush();
+    }
+    d_buffer[d_count++] = value;
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline buffered_output_iterator<AnyIterator, Capacity>&
+    buffered_output_iterator<AnyIterator, Capacity>::operator=(
+        typename AnyIterator::value_type&& value)
+{
+    if (d_count == Capacity) {
+        flush();
+    }
+    d_buffer[d_count++] = std::move(value);
+    return *this;
+}
+
+template <typename AnyIterator, std::size_t Capacity>
+inline void buffered_output_iterator<AnyIterator, Capacity>::flush()
+{
+    if (d_count != 0) {
+        d_it.write_n(d_buffer.data(), d_count);
+        d_count = 0;
+    }
+}
+
+// PRIVATE CLASS METHODS
+template <typename AnyIterator, std::size_t Capacity>
+inline const AnyIterator&
+    buffered_output_iterator<AnyIterator, Capacity>::flushed(
+        const buffered_output_iterator& other)
+{
+    const_cast<buffered_output_iterator&>(other).flush();
+    return other.d_it;
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_BUFFEREDITERATOR
@@ -0,0 +1,637 @@
+#ifndef SAMPLE_GENERATOR
+#define SAMPLE_GENERATOR
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace sample {
+namespace detail {
+
+class Generator_PromiseBase {
+    // This class provides the parts of the promise types of `generator` and
+    // `batch_generator` that do not depend on what is yielded: coroutines
+    // start suspended, keep their frame alive after finishing so that the
+    // iterator can observe it, capture the exception that ended them, if
+    // any, and may not `co_await`.
+
+public:
+    // MANIPULATORS
+    std::suspend_always initial_suspend() const noexcept;
+        // Suspend the coroutine before its body runs.
+
+    std::suspend_always final_suspend() const noexcept;
+        // Suspend the coroutine once its body has finished.
+
+    void return_void() const noexcept;
+        // Do nothing; a generator returns no value.
+
+    void unhandled_exception() noexcept;
+        // Capture the exception exiting the body of the coroutine.
+
+    template <typename Awaitable>
+    void await_transform(Awaitable&&) = delete;
+        // Disallow `co_await` in the body of a generator, which could
+        // otherwise suspend without yielding a value.
+
+    void rethrowIfFailed();
+        // Rethrow the exception that exited the body of the coroutine, if
+        // any, clearing it.
+
+private:
+    // DATA
+    std::exception_ptr d_exception;
+};
+
+} // close namespace detail
+
+template <typename T>
+class generator {
+    // A `generator` owns a coroutine producing a sequence of `T` with
+    // `co_yield`, and provides a single pass input iterator over it, which
+    // may be held by an `any_input_iterator<std::remove_cv_t<T>, T&>`.  The
+    // coroutine is resumed directly by the increment of the iterator, which
+    // holds only the handle of the coroutine and so is stored inline by any
+    // `any_iterator` allowing inline storage.
+    //
+    // Values are yielded by reference: the iterator refers to the object
+    // given to `co_yield`, which lives in the coroutine frame, or to the
+    // temporary materialized there for a prvalue, until the coroutine is
+    // resumed.  Nothing is copied, so `T` need not be copyable.  A
+    // `generator<const T>` accepts `const` lvalues, which a `generator<T>`
+    // rejects.
+    //
+    // An exception exiting the coroutine is rethrown by the `begin` or
+    // increment that resumed it, which then leaves the iterator at the end.
+    // The coroutine may not `co_await`.  Destroying the `generator`
+    // destroys the coroutine frame, and with it the locals of a coroutine
+    // that has not finished, invalidating its iterators.
+
+public:
+    // TYPES
+    using value_type = std::remove_cv_t<T>;
+    using reference = T&;
+    using pointer = T*;
+
+    class promise_type : public detail::Generator_PromiseBase {
+        // The promise of a coroutine returning a `generator`.
+
+    public:
+        // MANIPULATORS
+        generator get_return_object() noexcept;
+            // Returns the `generator` owning this coroutine.
+
+        std::suspend_always yield_value(T& value) noexcept;
+            // Make `value` the current element and suspend the coroutine.
+
+        std::suspend_always yield_value(value_type&& value) noexcept;
+            // Make the temporary `value`, which lives until the coroutine
+            // is resumed, the current element and suspend the coroutine.
+
+        // ACCESSORS
+        T* value() const noexcept;
+            // Returns the address of the current element.
+
+    private:
+        // DATA
+        T *d_value = nullptr;
+    };
+
+    class iterator {
+        // A single pass input iterator over the elements yielded by a
+        // `generator`.  Copies of an iterator share the coroutine, so that
+        // incrementing one advances all of them.
+
+    public:
+        // TYPES
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using pointer = T*;
+
+        // CREATORS
+        iterator() = default;
+            // Construct the end iterator.
+
+        // ACCESSORS
+        reference operator*() const noexcept;
+            // Returns a reference to the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        pointer operator->() const noexcept;
+            // Returns the address of the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        bool operator==(const iterator& rhs) const noexcept;
+            // Returns whether `*this` and `rhs` are both at the end, or both
+            // not at the end.
+
+        // MANIPULATORS
+        iterator& operator++();
+            // Resume the coroutine until it yields the next element or
+            // finishes, rethrowing any exception exiting it, and return a
+            // reference to `*this`.  The behaviour is undefined if `*this`
+            // is at the end.
+
+        void operator++(int);
+            // Equivalent to `++*this`.  As the element referred to before
+            // is gone once the coroutine resumes, no copy is returned.
+
+    private:
+        // PRIVATE CREATORS
+        explicit iterator(
+            std::coroutine_handle<promise_type> coroutine) noexcept;
+            // Construct an iterator at the current element of `coroutine`.
+
+        // PRIVATE ACCESSORS
+        bool atEnd() const noexcept;
+            // Returns whether the coroutine has finished.
+
+        // FRIENDS
+        friend class generator;
+
+    private:
+        // DATA
+        std::coroutine_handle<promise_type> d_coroutine;
+    };
+
+    // CREATORS
+    generator() = default;
+        // Construct a `generator` with no coroutine, whose range is empty.
+
+    generator(generator&& other) noexcept;
+        // Construct a `generator` owning the coroutine of `other`, leaving
+        // `other` without a coroutine.
+
+    ~generator();
+        // Destroy the coroutine, if any.
+
+    // MANIPULATORS
+    generator& operator=(generator other) noexcept;
+        // Destroy the coroutine of `*this`, if any, and take that of
+        // `other`.
+
+    iterator begin();
+        // Resume the coroutine until it yields its first element or
+        // finishes, and return an iterator at that element.  The behaviour
+        // is undefined if `begin` has already been called.
+
+    iterator end() noexcept;
+        // Returns the end iterator.
+
+private:
+    // PRIVATE CREATORS
+    explicit generator(std::coroutine_handle<promise_type> coroutine)
+        noexcept;
+        // Construct a `generator` owning `coroutine`.
+
+private:
+    // DATA
+    std::coroutine_handle<promise_type> d_coroutine;
+};
+
+template <typename T>
+class batch_generator {
+    // A `batch_generator` owns a coroutine producing a sequence of `T` in
+    // batches, each yielded as a `std::span<T>` over elements the coroutine
+    // keeps alive until it is resumed, and provides a single pass input
+    // iterator over the elements of the batches, which may be held by an
+    // `any_input_iterator<std::remove_cv_t<T>, T&>`.  The iterator steps
+    // through a batch with plain pointer increments and resumes the
+    // coroutine only once it is consumed, amortizing the cost of the resume
+    // over the batch.  It holds the handle of the coroutine and two
+    // pointers, and so is stored inline by any `any_iterator` allowing
+    // inline storage.
+    //
+    // Empty batches are skipped.  Elements are not copied, and exceptions,
+    // `co_await` and the lifetime of the coroutine are handled as by
+    // `generator`.
+
+public:
+    // TYPES
+    using value_type = std::remove_cv_t<T>;
+    using reference = T&;
+    using pointer = T*;
+
+    class promise_type : public detail::Generator_PromiseBase {
+        // The promise of a coroutine returning a `batch_generator`.
+
+    public:
+        // MANIPULATORS
+        batch_generator get_return_object() noexcept;
+            // Returns the `batch_generator` owning this coroutine.
+
+        std::suspend_always yield_value(std::span<T> batch) noexcept;
+            // Make `batch` the current batch and suspend the coroutine.
+
+        // ACCESSORS
+        std::span<T> batch() const noexcept;
+            // Returns the current batch.
+
+    private:
+        // DATA
+        std::span<T> d_batch;
+    };
+
+    class iterator {
+        // A single pass input iterator over the elements of the batches
+        // yielded by a `batch_generator`.  Copies of an iterator share the
+        // coroutine; once one of them moves to the next batch, the others
+        // are invalidated.
+
+    public:
+        // TYPES
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using pointer = T*;
+
+        // CREATORS
+        iterator() = default;
+            // Construct the end iterator.
+
+        // ACCESSORS
+        reference operator*() const noexcept;
+            // Returns a reference to the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        pointer operator->() const noexcept;
+            // Returns the address of the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        bool operator==(const iterator& rhs) const noexcept;
+            // Returns whether `*this` and `rhs` are at the same element, or
+            // both at the end.
+
+        // MANIPULATORS
+        iterator& operator++();
+            // Advance to the next element of the current batch or, once it
+            // is consumed, resume the coroutine until it yields a non-empty
+            // batch or finishes, rethrowing any exception exiting it, and
+            // return a reference to `*this`.  The behaviour is undefined if
+            // `*this` is at the end.
+
+        void operator++(int);
+            // Equivalent to `++*this`.
+
+    private:
+        // PRIVATE CREATORS
+        explicit iterator(
+            std::coroutine_handle<promise_type> coroutine) noexcept;
+            // Construct an iterator on `coroutine`, at the end until
+            // `nextBatch` is called.
+
+        // PRIVATE MANIPULATORS
+        void nextBatch();
+            // Resume the coroutine until it yields a non-empty batch, and
+            // move to its first element, or until it finishes, and move to
+            // the end.
+
+        // FRIENDS
+        friend class batch_generator;
+
+    private:
+        // DATA
+        std::coroutine_handle<promise_type>  d_coroutine;
+        T                                   *d_current = nullptr;
+        T                                   *d_last = nullptr;  // of batch
+    };
+
+    // CREATORS
+    batch_generator() = default;
+        // Construct a `batch_generator` with no coroutine, whose range is
+        // empty.
+
+    batch_generator(batch_generator&& other) noexcept;
+        // Construct a `batch_generator` owning the coroutine of `other`,
+        // leaving `other` without a coroutine.
+
+    ~batch_generator();
+        // Destroy the coroutine, if any.
+
+    // MANIPULATORS
+    batch_generator& operator=(batch_generator other) noexcept;
+        // Destroy the coroutine of `*this`, if any, and take that of
+        // `other`.
+
+    iterator begin();
+        // Resume the coroutine until it yields its first non-empty batch or
+        // finishes, and return an iterator at the first element of that
+        // batch.  The behaviour is undefined if `begin` has already been
+        // called.
+
+    iterator end() noexcept;
+        // Returns the end iterator.
+
+private:
+    // PRIVATE CREATORS
+    explicit batch_generator(
+        std::coroutine_handle<promise_type> coroutine) noexcept;
+        // Construct a `batch_generator` owning `coroutine`.
+
+private:
+    // DATA
+    std::coroutine_handle<promise_type> d_coroutine;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+// Generator_PromiseBase
+inline std::suspend_always
+Generator_PromiseBase::initial_suspend() const noexcept
+{
+    return {};
+}
+
+inline std::suspend_always
+Generator_PromiseBase::final_suspend() const noexcept
+{
+    return {};
+}
+
+inline void Generator_PromiseBase::return_void() const noexcept
+{}
+
+inline void Generator_PromiseBase::unhandled_exception() noexcept
+{
+    d_exception = std::current_exception();
+}
+
+inline void Generator_PromiseBase::rethrowIfFailed()
+{
+    if (d_exception) {
+        std::rethrow_exception(std::exchange(d_exception, nullptr));
+    }
+}
+
+} // close namespace detail
+
+// generator::promise_type
+template <typename T>
+inline generator<T>
+generator<T>::promise_type::get_return_object() noexcept
+{
+    return generator(
+        std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+template <typename T>
+inline std::suspend_always
+generator<T>::promise_type::yield_value(T& value) noexcept
+{
+    d_value = std::addressof(value);
+    return {};
+}
+
+template <typename T>
+inline std::suspend_always
+generator<T>::promise_type::yield_value(value_type&& value) noexcept
+{
+    d_value = std::addressof(value);
+    return {};
+}
+
+template <typename T>
+inline T* generator<T>::promise_type::value() const noexcept
+{
+    return d_value;
+}
+
+// generator::iterator
+template <typename T>
+inline generator<T>::iterator::iterator(
+    std::coroutine_handle<promise_type> coroutine) noexcept
+    : d_coroutine(coroutine)
+{}
+
+template <typename T>
+inline typename generator<T>::iterator::reference
+generator<T>::iterator::operator*() const noexcept
+{
+    return *d_coroutine.promise().value();
+}
+
+template <typename T>
+inline typename generator<T>::iterator::pointer
+generator<T>::iterator::operator->() const noexcept
+{
+    return d_coroutine.promise().value();
+}
+
+template <typename T>
+inline bool
+generator<T>::iterator::operator==(const iterator& rhs) const noexcept
+{
+    return atEnd() == rhs.atEnd();
+}
+
+template <typename T>
+inline typename generator<T>::iterator&
+generator<T>::iterator::operator++()
+{
+    d_coroutine.resume();
+    if (d_coroutine.done()) {
+        d_coroutine.promise().rethrowIfFailed();
+    }
+    return *this;
+}
+
+template <typename T>
+inline void generator<T>::iterator::operator++(int)
+{
+    ++*this;
+}
+
+template <typename T>
+inline bool generator<T>::iterator::atEnd() const noexcept
+{
+    return !d_coroutine || d_coroutine.done();
+}
+
+// generator
+template <typename T>
+inline generator<T>::generator(
+    std::coroutine_handle<promise_type> coroutine) noexcept
+    : d_coroutine(coroutine)
+{}
+
+template <typename T>
+inline generator<T>::generator(generator&& other) noexcept
+    : d_coroutine(std::exchange(other.d_coroutine, nullptr))
+{}
+
+template <typename T>
+inline generator<T>::~generator()
+{
+    if (d_coroutine) {
+        d_coroutine.destroy();
+    }
+}
+
+template <typename T>
+inline generator<T>& generator<T>::operator=(generator other) noexcept
+{
+    std::swap(d_coroutine, other.d_coroutine);
+    return *this;
+}
+
+template <typename T>
+inline typename generator<T>::iterator generator<T>::begin()
+{
+    iterator it(d_coroutine);
+    if (d_coroutine) {
+        ++it;
+    }
+    return it;
+}
+
+template <typename T>
+inline typename generator<T>::iterator generator<T>::end() noexcept
+{
+    return iterator();
+}
+
+// batch_generator::promise_type
+template <typename T>
+inline batch_generator<T>
+batch_generator<T>::promise_type::get_return_object() noexcept
+{
+    return batch_generator(
+        std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+template <typename T>
+inline std::suspend_always
+batch_generator<T>::promise_type::yield_value(std::span<T> batch) noexcept
+{
+    d_batch = batch;
+    return {};
+}
+
+template <typename T>
+inline std::span<T> batch_generator<T>::promise_type::batch() const noexcept
+{
+    return d_batch;
+}
+
+// batch_generator::iterator
+template <typename T>
+inline batch_generator<T>::iterator::iterator(
+    std::coroutine_handle<promise_type> coroutine) noexcept
+    : d_coroutine(coroutine)
+{}
+
+template <typename T>
+inline typename batch_generator<T>::iterator::reference
+batch_generator<T>::iterator::operator*() const noexcept
+{
+    return *d_current;
+}
+
+template <typename T>
+inline typename batch_generator<T>::iterator::pointer
+batch_generator<T>::iterator::operator->() const noexcept
+{
+    return d_current;
+}
+
+template <typename T>
+inline bool
+batch_generator<T>::iterator::operator==(const iterator& rhs) const noexcept
+{
+    return d_current == rhs.d_current;
+}
+
+template <typename T>
+inline typename batch_generator<T>::iterator&
+batch_generator<T>::iterator::operator++()
+{
+    if (++d_current == d_last) {
+        nextBatch();
+    }
+    return *this;
+}
+
+template <typename T>
+inline void batch_generator<T>::iterator::operator++(int)
+{
+    ++*this;
+}
+
+template <typename T>
+inline void batch_generator<T>::iterator::nextBatch()
+{
+    for (;;) {
+        d_coroutine.resume();
+        if (d_coroutine.done()) {
+            d_current = d_last = nullptr;
+            d_coroutine.promise().rethrowIfFailed();
+            return;
+        }
+        const std::span<T> batch = d_coroutine.promise().batch();
+        if (!batch.empty()) {
+            d_current = batch.data();
+            d_last = batch.data() + batch.size();
+            return;
+        }
+    }
+}
+
+// batch_generator
+template <typename T>
+inline batch_generator<T>::batch_generator(
+    std::coroutine_handle<promise_type> coroutine) noexcept
+    : d_coroutine(coroutine)
+{}
+
+template <typename T>
+inline batch_generator<T>::batch_generator(batch_generator&& other) noexcept
+    : d_coroutine(std::exchange(other.d_coroutine, nullptr))
+{}
+
+template <typename T>
+inline batch_generator<T>::~batch_generator()
+{
+    if (d_coroutine) {
+        d_coroutine.destroy();
+    }
+}
+
+template <typename T>
+inline batch_generator<T>&
+batch_generator<T>::operator=(batch_generator other) noexcept
+{
+    std::swap(d_coroutine, other.d_coroutine);
+    return *this;
+}
+
+template <typename T>
+inline typename batch_generator<T>::iterator batch_generator<T>::begin()
+{
+    iterator it(d_coroutine);
+    if (d_coroutine) {
+        it.nextBatch();
+    }
+    return it;
+}
+
+template <typename T>
+inline typename batch_generator<T>::iterator batch_generator<T>::end()
+    noexcept
+{
+    return iterator();
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_GENERATOR
@@ -0,0 +1,161 @@
+#ifndef SAMPLE_INLINEFIT
+#define SAMPLE_INLINEFIT
+
+#include <sample_anyiterator.hpp>
+#include <sample_smallbuffer.hpp>
+#include <sample_typetoken.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace sample {
+
+template <typename It, typename AnyIterator>
+struct inline_fit {
+    // This class describes, at compile time, how an `AnyIterator`, an
+    // `any_iterator` of any storage policy, holds an `It` it is constructed
+    // from: the object it stores, which is `It` itself or, for a contiguous
+    // iterator, its address, and whether that object is held within the
+    // inline buffer or on the heap.  The decision is that made by the
+    // constructors of `AnyIterator`, so the two cannot disagree.
+
+    static_assert(std::is_constructible_v<AnyIterator, It>,
+                  "AnyIterator cannot hold It");
+
+private:
+    // PRIVATE TYPES
+    using Buffer = typename AnyIterator::BufferType;
+    using Stored = typename AnyIterator::template ImplType<It>;
+
+public:
+    // CLASS DATA
+    static constexpr type_token type = type_token::of<It>();
+        // The type of the underlying iterator.
+
+    static constexpr std::size_t size = sizeof(It);
+    static constexpr std::size_t alignment = alignof(It);
+
+    static constexpr bool contiguous =
+        AnyIterator::template is_contiguous_source_v<It>;
+        // Whether only the address of the iterator is stored, so that most
+        // operations are performed without dispatching.
+
+    static constexpr std::size_t stored_size = sizeof(Stored);
+        // The size of the object stored, which holds the iterator, or its
+        // address if `contiguous`.
+
+    static constexpr std::size_t buffer_size = Buffer::capacity();
+        // The size of the inline buffer of `AnyIterator`.
+
+    static constexpr bool is_inline =
+        Buffer::template holdsInline<Stored>();
+        // Whether the stored object is held in the inline buffer, so that
+        // construction, copies and moves do not allocate.
+
+    static constexpr std::size_t unused_bytes =
+        is_inline ? buffer_size - stored_size : buffer_size;
+        // The bytes of the inline buffer left unused, which are all of them
+        // if the stored object is held on the heap.
+
+    static constexpr std::size_t heap_bytes =
+        Buffer::template heapBytes<Stored>();
+        // The bytes of each block allocated to hold the stored object on
+        // the heap, including the header in front of it, or zero if it is
+        // held inline.
+};
+
+template <typename It, typename AnyIterator>
+struct fits_inline : std::bool_constant<inline_fit<It, AnyIterator>::is_inline>
+{};
+    // Trait detecting whether an `AnyIterator` constructed from an `It`
+    // holds it within its inline buffer, so that neither it nor its copies
+    // allocate.  To catch an iterator outgrowing the buffer at compile time
+    // rather than in a profile, write
+    // `static_assert(sample::fits_inline_v<It, AnyIterator>)`.
+
+template <typename It, typename AnyIterator>
+inline constexpr bool fits_inline_v = fits_inline<It, AnyIterator>::value;
+
+struct inline_fit_row {
+    // The description of one iterator type in a `sizing_report`, as given
+    // by `inline_fit`.
+
+    // DATA
+    std::string_view d_type;
+    std::size_t      d_size;
+    std::size_t      d_alignment;
+    std::size_t      d_storedSize;
+    std::size_t      d_unusedBytes;
+    std::size_t      d_heapBytes;
+    bool             d_contiguous;
+    bool             d_inline;
+};
+
+template <typename AnyIterator, typename... Its>
+struct sizing_report {
+    // This class describes, at compile time, how an `AnyIterator` holds each
+    // of `Its`, for example every adaptor stack of a pipeline, so that a
+    // build can assert they all fit inline, and print a table of their
+    // sizes, alignments, unused buffer bytes and storage.
+
+    // CLASS DATA
+    static constexpr std::array<inline_fit_row, sizeof...(Its)> rows = {{
+        { inline_fit<Its, AnyIterator>::type.name(),
+          inline_fit<Its, AnyIterator>::size,
+          inline_fit<Its, AnyIterator>::alignment,
+          inline_fit<Its, AnyIterator>::stored_size,
+          inline_fit<Its, AnyIterator>::unused_bytes,
+          inline_fit<Its, AnyIterator>::heap_bytes,
+          inline_fit<Its, AnyIterator>::contiguous,
+          inline_fit<Its, AnyIterator>::is_inline }... }};
+        // The description of each of `Its`, in order.
+
+    static constexpr std::size_t buffer_size =
+        AnyIterator::BufferType::capacity();
+        // The size of the inline buffer of `AnyIterator`.
+
+    static constexpr bool all_inline =
+        (fits_inline_v<Its, AnyIterator> && ...);
+        // Whether every one of `Its` is held inline.
+
+    // CLASS METHODS
+    static void print(std::ostream& stream);
+        // Write a table of `rows` to `stream`, with a line per iterator
+        // type, preceded by the size of the inline buffer.
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+template <typename AnyIterator, typename... Its>
+inline void sizing_report<AnyIterator, Its...>::print(std::ostream& stream)
+{
+    std::size_t width = 4;
+    for (const inline_fit_row& row : rows) {
+        width = std::max(width, row.d_type.size());
+    }
+
+    stream << "Inline buffer of " << buffer_size << " bytes\n"
+           << std::left << std::setw(static_cast<int>(width)) << "Type"
+           << std::right << std::setw(7) << "Size" << std::setw(7) << "Align"
+           << std::setw(8) << "Stored" << std::setw(8) << "Unused"
+           << std::setw(6) << "Heap" << "  Storage\n";
+    for (const inline_fit_row& row : rows) {
+        stream << std::left << std::setw(static_cast<int>(width))
+               << row.d_type << std::right << std::setw(7) << row.d_size
+               << std::setw(7) << row.d_alignment << std::setw(8)
+               << row.d_storedSize << std::setw(8) << row.d_unusedBytes
+               << std::setw(6) << row.d_heapBytes << "  "
+               << (row.d_inline ? "inline" : "heap")
+               << (row.d_contiguous ? ", contiguous" : "") << '\n';
+    }
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_INLINEFIT
@@ -0,0 +1,202 @@
+#ifndef SAMPLE_ITERATORPOOL
+#define SAMPLE_ITERATORPOOL
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace sample {
+
+struct iterator_pool_statistics {
+    // The activity of the iterator pool on a single thread.
+
+    // DATA
+    std::size_t hits = 0;      // allocations served from a freelist
+    std::size_t misses = 0;    // allocations passed to `operator new`
+    std::size_t recycled = 0;  // deallocations kept on a freelist
+    std::size_t released = 0;  // deallocations passed to `operator delete`
+};
+
+std::pmr::memory_resource* iterator_pool_resource() noexcept;
+    // Return a memory resource which serves small blocks from freelists
+    // local to the calling thread, sorted into power of two size classes,
+    // and forwards other requests to `std::pmr::new_delete_resource()`.  A
+    // block may be returned on any thread, joining that thread's freelist,
+    // and each freelist holds a bounded number of blocks, all of which are
+    // released when its thread exits.
+    //
+    // If `SAMPLE_ANYITERATOR_POOL` is defined, iterators which an
+    // `any_iterator` holds on the heap are allocated from this resource
+    // unless another is given, so that repeatedly copying such iterators
+    // does not reach the global allocator.
+
+iterator_pool_statistics iterator_pool_stats() noexcept;
+    // Return the activity of the iterator pool on the calling thread.
+
+namespace detail {
+
+constexpr std::size_t POOL_MIN_BLOCK_SIZE = 32ul;
+constexpr std::size_t POOL_SIZE_CLASSES = 5ul;
+    // Pooled blocks are of 32, 64, 128, 256 or 512 bytes.
+
+constexpr std::size_t POOL_CACHE_LIMIT = 64ul;
+    // The most blocks a freelist holds before releasing them.
+
+struct IteratorPool_Block {
+    // This class overlays a block while it is on a freelist.
+
+    // DATA
+    IteratorPool_Block* d_next;
+};
+
+struct IteratorPool_Cache {
+    // This class holds the freelists of a single thread.  It is trivially
+    // destructible, so that blocks returned while its thread exits, after
+    // its freelists have been drained, can still be released.
+
+    // DATA
+    IteratorPool_Block*      d_heads[POOL_SIZE_CLASSES];
+    std::size_t              d_counts[POOL_SIZE_CLASSES];
+    iterator_pool_statistics d_stats;
+    bool                     d_draining;  // the thread is exiting
+    bool                     d_registered;  // drained at thread exit
+};
+
+inline thread_local IteratorPool_Cache t_poolCache{};
+
+struct IteratorPool_Drain {
+    // This class releases the freelists of its thread when destroyed.
+
+    // CREATORS
+    ~IteratorPool_Drain();
+};
+
+struct IteratorPool_Resource final : std::pmr::memory_resource {
+    // This class implements `iterator_pool_resource()`.  It holds no
+    // state, which lives in `t_poolCache` instead, so a single object
+    // serves every thread.
+
+private:
+    // PRIVATE CLASS METHODS
+    static std::size_t sizeClass(std::size_t bytes) noexcept;
+        // Return the index of the smallest size class holding `bytes`.
+
+    // PRIVATE MANIPULATORS
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override;
+
+    // PRIVATE ACCESSORS
+    bool do_is_equal(const std::pmr::memory_resource& other) const
+        noexcept override;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+inline IteratorPool_Drain::~IteratorPool_Drain()
+{
+    IteratorPool_Cache& cache = t_poolCache;
+    cache.d_draining = true;
+
+    for (std::size_t i = 0; i != POOL_SIZE_CLASSES; ++i) {
+        while (IteratorPool_Block* block = cache.d_heads[i]) {
+            cache.d_heads[i] = block->d_next;
+            ::operator delete(block, POOL_MIN_BLOCK_SIZE << i);
+            ++cache.d_stats.released;
+        }
+        cache.d_counts[i] = 0;
+    }
+}
+
+// PRIVATE CLASS METHODS
+inline std::size_t IteratorPool_Resource::sizeClass(std::size_t bytes)
+    noexcept
+{
+    std::size_t index = 0;
+    while ((POOL_MIN_BLOCK_SIZE << index) < bytes) {
+        ++index;
+    }
+    return index;
+}
+
+// PRIVATE MANIPULATORS
+inline void* IteratorPool_Resource::do_allocate(std::size_t bytes,
+    std::size_t alignment)
+{
+    if (bytes > (POOL_MIN_BLOCK_SIZE << (POOL_SIZE_CLASSES - 1)) ||
+        alignment > alignof(std::max_align_t)) {
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    IteratorPool_Cache& cache = t_poolCache;
+    const std::size_t index = sizeClass(bytes);
+    if (IteratorPool_Block* const block = cache.d_heads[index]) {
+        cache.d_heads[index] = block->d_next;
+        --cache.d_counts[index];
+        ++cache.d_stats.hits;
+        return block;
+    }
+
+    ++cache.d_stats.misses;
+    return ::operator new(POOL_MIN_BLOCK_SIZE << index);
+}
+
+inline void IteratorPool_Resource::do_deallocate(void* p, std::size_t bytes,
+    std::size_t alignment)
+{
+    if (bytes > (POOL_MIN_BLOCK_SIZE << (POOL_SIZE_CLASSES - 1)) ||
+        alignment > alignof(std::max_align_t)) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    IteratorPool_Cache& cache = t_poolCache;
+    const std::size_t index = sizeClass(bytes);
+    if (cache.d_draining || cache.d_counts[index] == POOL_CACHE_LIMIT) {
+        ::operator delete(p, POOL_MIN_BLOCK_SIZE << index);
+        ++cache.d_stats.released;
+        return;
+    }
+
+    if (!cache.d_registered) {
+        // Constructing the drain schedules its destruction at thread exit.
+        static thread_local IteratorPool_Drain drain;
+        cache.d_registered = true;
+    }
+
+    cache.d_heads[index] = ::new (p) IteratorPool_Block{cache.d_heads[index]};
+    ++cache.d_counts[index];
+    ++cache.d_stats.recycled;
+}
+
+// PRIVATE ACCESSORS
+inline bool IteratorPool_Resource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // close namespace detail
+
+// FREE FUNCTIONS
+inline std::pmr::memory_resource* iterator_pool_resource() noexcept
+{
+    // Never destroyed, so that iterators destroyed during static
+    // destruction may still return their blocks.
+    alignas(detail::IteratorPool_Resource) static std::byte
+        storage[sizeof(detail::IteratorPool_Resource)];
+    static detail::IteratorPool_Resource* const resource =
+        ::new ((void*)storage) detail::IteratorPool_Resource();
+    return resource;
+}
+
+inline iterator_pool_statistics iterator_pool_stats() noexcept
+{
+    return detail::t_poolCache.d_stats;
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_ITERATORPOOL
@@ -0,0 +1,258 @@
+#ifndef SAMPLE_MAPPEDRECORDS
+#define SAMPLE_MAPPEDRECORDS
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sample {
+
+enum class access_pattern {
+    // The order in which the records of a `mapped_records` are expected to
+    // be read, passed to the kernel with `madvise` so that it can read pages
+    // ahead, or not, and evict them accordingly.
+
+    normal,      // no particular order
+    sequential,  // in increasing order, each once: read ahead aggressively
+    random       // in no predictable order: do not read ahead
+};
+
+namespace detail {
+
+int madviseAdvice(access_pattern pattern) noexcept;
+    // Returns the `madvise` advice for `pattern`.
+
+} // close namespace detail
+
+template <typename T>
+class mapped_records {
+    // A `mapped_records` maps a file of fixed-size records of `T`, stored
+    // one after the other in the layout of `T` on this platform, read-only
+    // into memory with `mmap`.  Records are read in place, without copying,
+    // and pages are read from the file as they are first touched, so the
+    // size of the file costs neither memory nor startup time up front.
+    //
+    // The iterators are `const T*`, which an
+    // `any_random_access_iterator<const T>` holds as a raw pointer, so that
+    // erased iterators over the records dereference without dispatching and
+    // the algorithms of `sample_algorithm.hpp` run their contiguous
+    // kernels on them.
+    //
+    // `T` must be trivially copyable.  The file must not be truncated while
+    // it is mapped, which raises `SIGBUS` on access to the missing pages.
+    // This component is only available on POSIX systems.
+
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "records must be trivially copyable");
+
+public:
+    // TYPES
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const T&;
+    using const_pointer = const T*;
+    using const_iterator = const T*;
+    using iterator = const_iterator;
+
+    // CREATORS
+    mapped_records() noexcept = default;
+        // Construct a `mapped_records` with no records and no mapping.
+
+    explicit mapped_records(const std::filesystem::path& path,
+                            access_pattern pattern = access_pattern::normal);
+        // Map the records in the file at `path`, advising the kernel that
+        // they will be read in `pattern`.  Throw `std::system_error` if the
+        // file cannot be opened or mapped, and `std::invalid_argument` if
+        // its size is not a multiple of `sizeof(T)`.
+
+    mapped_records(mapped_records&& other) noexcept;
+        // Construct a `mapped_records` taking the mapping of `other`, which
+        // is left with no records.
+
+    ~mapped_records();
+        // Unmap the file, invalidating all iterators and references to the
+        // records.
+
+    // MANIPULATORS
+    mapped_records& operator=(mapped_records other) noexcept;
+        // Unmap the file mapped by `*this`, if any, and take the mapping of
+        // `other`.
+
+    // ACCESSORS
+    void advise(access_pattern pattern) const noexcept;
+        // Advise the kernel that the records will be read in `pattern` from
+        // now on.  As the advice is only a hint, failures are ignored.
+
+    const_iterator begin() const noexcept;
+        // Returns an iterator to the first record.
+
+    const_iterator end() const noexcept;
+        // Returns an iterator past the last record.
+
+    const T* data() const noexcept;
+        // Returns the address of the first record, or the null pointer if
+        // there are none.
+
+    const T& operator[](size_type index) const noexcept;
+        // Returns a reference to the record at `index`.  The behaviour is
+        // undefined unless `index < size()`.
+
+    size_type size() const noexcept;
+        // Returns the number of records.
+
+    bool empty() const noexcept;
+        // Returns whether there are no records.
+
+private:
+    // DATA
+    void      *d_mapping = nullptr;  // null if the file is empty
+    size_type  d_bytes = 0;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+inline int madviseAdvice(access_pattern pattern) noexcept
+{
+    switch (pattern) {
+      case access_pattern::sequential:
+        return MADV_SEQUENTIAL;
+      case access_pattern::random:
+        return MADV_RANDOM;
+      case access_pattern::normal:
+        break;
+    }
+    return MADV_NORMAL;
+}
+
+} // close namespace detail
+
+// CREATORS
+template <typename T>
+inline mapped_records<T>::mapped_records(const std::filesystem::path& path,
+                                         access_pattern pattern)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(),
+                                "open " + path.string());
+    }
+
+    struct ::stat status;
+    if (::fstat(fd, &status) == -1) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "fstat " + path.string());
+    }
+    const size_type bytes = static_cast<size_type>(status.st_size);
+    if (bytes % sizeof(T) != 0) {
+        ::close(fd);
+        throw std::invalid_argument(path.string() +
+                                    " does not hold whole records");
+    }
+
+    // An empty file cannot be mapped, and holds no records to map.
+    if (bytes != 0) {
+        void *mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(),
+                                    "mmap " + path.string());
+        }
+        d_mapping = mapping;
+        d_bytes = bytes;
+    }
+    ::close(fd);  // the mapping keeps the file open
+    advise(pattern);
+}
+
+template <typename T>
+inline mapped_records<T>::mapped_records(mapped_records&& other) noexcept
+    : d_mapping(std::exchange(other.d_mapping, nullptr))
+    , d_bytes(std::exchange(other.d_bytes, 0))
+{}
+
+template <typename T>
+inline mapped_records<T>::~mapped_records()
+{
+    if (d_mapping) {
+        ::munmap(d_mapping, d_bytes);
+    }
+}
+
+// MANIPULATORS
+template <typename T>
+inline mapped_records<T>&
+mapped_records<T>::operator=(mapped_records other) noexcept
+{
+    std::swap(d_mapping, other.d_mapping);
+    std::swap(d_bytes, other.d_bytes);
+    return *this;
+}
+
+// ACCESSORS
+template <typename T>
+inline void mapped_records<T>::advise(access_pattern pattern) const noexcept
+{
+    if (!d_mapping) {
+        return;
+    }
+    ::madvise(d_mapping, d_bytes, detail::madviseAdvice(pattern));
+}
+
+template <typename T>
+inline typename mapped_records<T>::const_iterator
+mapped_records<T>::begin() const noexcept
+{
+    return data();
+}
+
+template <typename T>
+inline typename mapped_records<T>::const_iterator
+mapped_records<T>::end() const noexcept
+{
+    return data() + size();
+}
+
+template <typename T>
+inline const T* mapped_records<T>::data() const noexcept
+{
+    return static_cast<const T*>(d_mapping);
+}
+
+template <typename T>
+inline const T& mapped_records<T>::operator[](size_type index) const noexcept
+{
+    return data()[index];
+}
+
+template <typename T>
+inline typename mapped_records<T>::size_type
+mapped_records<T>::size() const noexcept
+{
+    return d_bytes / sizeof(T);
+}
+
+template <typename T>
+inline bool mapped_records<T>::empty() const noexcept
+{
+    return d_bytes == 0;
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_MAPPEDRECORDS
@@ -0,0 +1,357 @@
+#ifndef SAMPLE_PARALLELALGORITHM
+#define SAMPLE_PARALLELALGORITHM
+
+#include <sample_algorithm.hpp>
+#include <sample_splitrange.hpp>
+#include <sample_threadpool.hpp>
+#include <sample_workstealingscheduler.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sample {
+namespace detail {
+
+constexpr std::size_t PARALLEL_MIN_CHUNK_SIZE = 2048ul;
+    // The fewest elements worth handing to another thread.
+
+template <typename RandomIt>
+std::size_t parallelChunkCount(const thread_pool& pool, RandomIt first,
+                               RandomIt last);
+    // Returns the number of chunks `[first, last)` is split into on `pool`.
+
+template <typename Difference>
+std::pair<Difference, Difference> parallelChunkBounds(Difference size,
+                                                      std::size_t chunks,
+                                                      std::size_t chunk);
+    // Returns the offsets of the first and one past the last elements of
+    // the chunk at index `chunk` of a range of `size` elements split into
+    // `chunks` chunks of sizes differing by at most one.
+
+template <typename InputIt, typename BinaryOperation>
+std::remove_cv_t<typename std::iterator_traits<InputIt>::value_type>
+parallelFoldChunk(InputIt first, InputIt last, BinaryOperation& op);
+    // Returns the result of folding the elements of the non-empty range
+    // `[first, last)` from the left over `op`.
+
+} // close namespace detail
+
+namespace parallel {
+
+// The algorithms in this namespace split a random access range into chunks
+// processed concurrently on the threads of a `thread_pool`,
+// `thread_pool::instance()` unless another is given.  `for_each` and
+// `transform` schedule chunks with a `work_stealing_scheduler`, whose chunk
+// sizes adapt to the time taken per element, so that ranges whose elements
+// vary in cost stay balanced.  They may be given a scheduler, whose cost
+// estimate then carries over from one call to the next; otherwise each call
+// makes its own, which starts from a chunk per thread.  `reduce` and
+// `inclusive_scan`, which combine the results of chunks in order, split the
+// range into one chunk per thread, and process ranges shorter than two
+// chunks of `detail::PARALLEL_MIN_CHUNK_SIZE` elements on the calling
+// thread.
+//
+// Each chunk is delimited by copies of `first` advanced to its bounds, so
+// that when the iterators are `any_iterator`s every thread steps its own
+// clone of the underlying iterator, and each chunk is processed by the
+// sequential algorithms of `sample_algorithm.hpp`, which visit the elements
+// of an erased chunk inside a single dispatch, or without any dispatch when
+// it is contiguous.
+//
+// If a call processing a chunk exits with an exception, the chunks not yet
+// started are skipped and one of the exceptions is rethrown once the others
+// have finished.
+
+template <typename RandomIt, typename UnaryFunction>
+void for_each(RandomIt first, RandomIt last, UnaryFunction f);
+template <typename RandomIt, typename UnaryFunction>
+void for_each(thread_pool& pool, RandomIt first, RandomIt last,
+              UnaryFunction f);
+template <typename RandomIt, typename UnaryFunction>
+void for_each(work_stealing_scheduler& scheduler, RandomIt first,
+              RandomIt last, UnaryFunction f);
+    // Applies `f` to each of the elements in the range `[first, last)`, in
+    // no particular order, as if by `std::for_each(std::execution::par,
+    // ...)`.  Each chunk is given its own copy of `f`.
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+RandomIt2 transform(RandomIt1 first, RandomIt1 last, RandomIt2 d_first,
+                    UnaryOperation op);
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+RandomIt2 transform(thread_pool& pool, RandomIt1 first, RandomIt1 last,
+                    RandomIt2 d_first, UnaryOperation op);
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+RandomIt2 transform(work_stealing_scheduler& scheduler, RandomIt1 first,
+                    RandomIt1 last, RandomIt2 d_first, UnaryOperation op);
+    // Writes the result of applying `op` to each of the elements in the
+    // range `[first, last)` to the range beginning at `d_first`, returning
+    // an iterator one past the last element written, as if by
+    // `std::transform(std::execution::par, ...)`.
+
+template <typename RandomIt, typename T>
+T reduce(RandomIt first, RandomIt last, T init);
+template <typename RandomIt, typename T, typename BinaryOperation>
+T reduce(RandomIt first, RandomIt last, T init, BinaryOperation op);
+template <typename RandomIt, typename T, typename BinaryOperation>
+T reduce(thread_pool& pool, RandomIt first, RandomIt last, T init,
+         BinaryOperation op);
+    // Returns the generalized sum of `init` and the elements in the range
+    // `[first, last)` over `op`, or `+` if `op` is not given, as if by
+    // `std::reduce(std::execution::par, ...)`.  Each chunk is folded from
+    // the left, with `sample::accumulate` and so with its vectorized
+    // kernels where they apply, and the chunk results are then folded into
+    // `init` in order, so the result is that of `std::accumulate` if `op`
+    // is associative.
+
+template <typename RandomIt1, typename RandomIt2>
+RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 d_first);
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation>
+RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 d_first,
+                         BinaryOperation op);
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation>
+RandomIt2 inclusive_scan(thread_pool& pool, RandomIt1 first, RandomIt1 last,
+                         RandomIt2 d_first, BinaryOperation op);
+    // Writes the inclusive prefix sums over `op`, or `+` if `op` is not
+    // given, of the elements in the range `[first, last)` to the range
+    // beginning at `d_first`, returning an iterator one past the last
+    // element written, as if by `std::inclusive_scan(std::execution::par,
+    // ...)`.  The sum of each chunk but the last is computed in a first
+    // pass, and each chunk is then scanned from the sum of those before it
+    // in a second, so `op` is applied about twice per element and must be
+    // associative.
+
+} // close namespace parallel
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+template <typename RandomIt>
+inline std::size_t parallelChunkCount(const thread_pool& pool,
+                                      RandomIt first, RandomIt last)
+{
+    const auto size = static_cast<std::size_t>(last - first);
+    return std::clamp(size / PARALLEL_MIN_CHUNK_SIZE, std::size_t{1},
+                      pool.concurrency());
+}
+
+template <typename Difference>
+inline std::pair<Difference, Difference>
+parallelChunkBounds(Difference size, std::size_t chunks, std::size_t chunk)
+{
+    const auto count = static_cast<Difference>(chunks);
+    const auto index = static_cast<Difference>(chunk);
+    const Difference quotient = size / count;
+    const Difference remainder = size % count;
+    const Difference begin = index * quotient + std::min(index, remainder);
+    return { begin, begin + quotient + (index < remainder ? 1 : 0) };
+}
+
+template <typename InputIt, typename BinaryOperation>
+inline std::remove_cv_t<typename std::iterator_traits<InputIt>::value_type>
+parallelFoldChunk(InputIt first, InputIt last, BinaryOperation& op)
+{
+    using ValueType = std::remove_cv_t<
+        typename std::iterator_traits<InputIt>::value_type>;
+
+    ValueType init = *first;
+    ++first;
+    if constexpr (std::is_same_v<BinaryOperation, std::plus<>> ||
+                  std::is_same_v<BinaryOperation, std::plus<ValueType>>) {
+        return sample::accumulate(std::move(first), std::move(last),
+                                  std::move(init));
+    } else {
+        return sample::accumulate(std::move(first), std::move(last),
+                                  std::move(init), op);
+    }
+}
+
+} // close namespace detail
+
+namespace parallel {
+
+template <typename RandomIt, typename UnaryFunction>
+inline void for_each(RandomIt first, RandomIt last, UnaryFunction f)
+{
+    parallel::for_each(thread_pool::instance(), std::move(first),
+                       std::move(last), std::move(f));
+}
+
+template <typename RandomIt, typename UnaryFunction>
+inline void for_each(thread_pool& pool, RandomIt first, RandomIt last,
+                     UnaryFunction f)
+{
+    work_stealing_scheduler scheduler(pool);
+    parallel::for_each(scheduler, std::move(first), std::move(last),
+                       std::move(f));
+}
+
+template <typename RandomIt, typename UnaryFunction>
+inline void for_each(work_stealing_scheduler& scheduler, RandomIt first,
+                     RandomIt last, UnaryFunction f)
+{
+    scheduler.run(
+        split_range<RandomIt>(std::move(first), std::move(last)),
+        [&f](const split_range<RandomIt>& chunk) {
+            sample::for_each(chunk.begin(), chunk.end(), f);
+        });
+}
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+inline RandomIt2 transform(RandomIt1 first, RandomIt1 last, RandomIt2 d_first,
+                           UnaryOperation op)
+{
+    return parallel::transform(thread_pool::instance(), std::move(first),
+                               std::move(last), std::move(d_first),
+                               std::move(op));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+inline RandomIt2 transform(thread_pool& pool, RandomIt1 first,
+                           RandomIt1 last, RandomIt2 d_first,
+                           UnaryOperation op)
+{
+    work_stealing_scheduler scheduler(pool);
+    return parallel::transform(scheduler, std::move(first), std::move(last),
+                               std::move(d_first), std::move(op));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation>
+inline RandomIt2 transform(work_stealing_scheduler& scheduler,
+                           RandomIt1 first, RandomIt1 last,
+                           RandomIt2 d_first, UnaryOperation op)
+{
+    const auto size = last - first;
+    scheduler.run(
+        split_range<RandomIt1>(std::move(first), std::move(last)),
+        [&](const split_range<RandomIt1>& chunk) {
+            sample::transform(chunk.begin(), chunk.end(),
+                              d_first + chunk.offset(), op);
+        });
+    return d_first + size;
+}
+
+template <typename RandomIt, typename T>
+inline T reduce(RandomIt first, RandomIt last, T init)
+{
+    return parallel::reduce(thread_pool::instance(), std::move(first),
+                            std::move(last), std::move(init), std::plus<>());
+}
+
+template <typename RandomIt, typename T, typename BinaryOperation>
+inline T reduce(RandomIt first, RandomIt last, T init, BinaryOperation op)
+{
+    return parallel::reduce(thread_pool::instance(), std::move(first),
+                            std::move(last), std::move(init), std::move(op));
+}
+
+template <typename RandomIt, typename T, typename BinaryOperation>
+inline T reduce(thread_pool& pool, RandomIt first, RandomIt last, T init,
+                BinaryOperation op)
+{
+    using ValueType = std::remove_cv_t<
+        typename std::iterator_traits<RandomIt>::value_type>;
+
+    const std::size_t chunks =
+        detail::parallelChunkCount(pool, first, last);
+    const auto size = last - first;
+    if (size == 0) {
+        return init;
+    }
+
+    std::vector<std::optional<ValueType>> partials(chunks);
+    pool.run(chunks, [&](std::size_t chunk) {
+        const auto [begin, end] =
+            detail::parallelChunkBounds(size, chunks, chunk);
+        partials[chunk].emplace(
+            detail::parallelFoldChunk(first + begin, first + end, op));
+    });
+
+    for (std::optional<ValueType>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+template <typename RandomIt1, typename RandomIt2>
+inline RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last,
+                                RandomIt2 d_first)
+{
+    return parallel::inclusive_scan(thread_pool::instance(), std::move(first),
+                                    std::move(last), std::move(d_first),
+                                    std::plus<>());
+}
+
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation>
+inline RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last,
+                                RandomIt2 d_first, BinaryOperation op)
+{
+    return parallel::inclusive_scan(thread_pool::instance(), std::move(first),
+                                    std::move(last), std::move(d_first),
+                                    std::move(op));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation>
+inline RandomIt2 inclusive_scan(thread_pool& pool, RandomIt1 first,
+                                RandomIt1 last, RandomIt2 d_first,
+                                BinaryOperation op)
+{
+    using ValueType = std::remove_cv_t<
+        typename std::iterator_traits<RandomIt1>::value_type>;
+
+    const std::size_t chunks =
+        detail::parallelChunkCount(pool, first, last);
+    const auto size = last - first;
+    if (size == 0) {
+        return d_first;
+    }
+
+    // The carry into each chunk is the sum of the chunks before it, and
+    // there is none into the first.
+    std::vector<std::optional<ValueType>> carries(chunks);
+    if (chunks > 1) {
+        pool.run(chunks - 1, [&](std::size_t chunk) {
+            const auto [begin, end] =
+                detail::parallelChunkBounds(size, chunks, chunk);
+            carries[chunk + 1].emplace(
+                detail::parallelFoldChunk(first + begin, first + end, op));
+        });
+        for (std::size_t chunk = 2; chunk != chunks; ++chunk) {
+            carries[chunk] = op(*carries[chunk - 1],
+                                std::move(*carries[chunk]));
+        }
+    }
+
+    pool.run(chunks, [&](std::size_t chunk) {
+        const auto [begin, end] =
+            detail::parallelChunkBounds(size, chunks, chunk);
+        RandomIt1 input = first + begin;
+        RandomIt2 output = d_first + begin;
+        std::optional<ValueType>& carry = carries[chunk];
+        if (!carry) {
+            carry.emplace(*input);
+            *output = *carry;
+            ++input;
+            ++output;
+        }
+        sample::transform(std::move(input), first + end, std::move(output),
+            [&](auto&& element) -> const ValueType& {
+                *carry = op(std::move(*carry),
+                            std::forward<decltype(element)>(element));
+                return *carry;
+            });
+    });
+    return d_first + size;
+}
+
+} // close namespace parallel
+} // close namespace sample
+
+#endif // SAMPLE_PARALLELALGORITHM
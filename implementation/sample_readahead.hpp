@@ -0,0 +1,411 @@
+#ifndef SAMPLE_READAHEAD
+#define SAMPLE_READAHEAD
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace sample {
+namespace detail {
+
+constexpr std::size_t READ_AHEAD_DEPTH = 256ul;
+    // The default number of elements a `read_ahead_range` reads ahead.
+
+constexpr std::size_t SPSC_RING_ALIGNMENT = 64ul;
+    // The alignment of the indices of an `SpscRing`, which is the size of a
+    // cache line on common processors, so that the producer and consumer do
+    // not write to the same line.
+
+constexpr int SPSC_RING_YIELDS = 64;
+    // The number of times a side of an `SpscRing` with nothing to do yields
+    // the processor before blocking, which lets the other side make more
+    // progress before being woken, rather than hand over every element.
+
+template <typename T>
+class SpscRing {
+    // This class is a bounded, lock-free queue of `T` between exactly one
+    // producer thread and one consumer thread.  Elements are constructed in
+    // place in a ring of slots by the producer and used in place, then
+    // destroyed, by the consumer.  Each side publishes its progress with a
+    // single store of its monotonic index, and a side with nothing to do
+    // waits for the index of the other to change, yielding and then
+    // blocking with `std::atomic::wait`.
+    //
+    // Either side may close the ring by setting the top bit of its own
+    // index: the producer once it has pushed its last element, after which
+    // the consumer sees the end once it has consumed the elements pushed,
+    // and the consumer when it will consume no more, after which pushes
+    // fail.
+
+public:
+    // CREATORS
+    explicit SpscRing(std::size_t depth);
+        // Construct an empty ring holding up to `depth` elements, rounded up
+        // to a power of two no smaller than one.
+
+    SpscRing(const SpscRing&) = delete;
+
+    // MANIPULATORS
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    template <typename... Args>
+    bool push(Args&&... args);
+        // Construct an element from `args` at the back of the ring, waiting
+        // while it is full, and return `true`, or return `false` if the
+        // consumer has closed the ring.  May only be called by the producer.
+
+    void close(std::exception_ptr error = nullptr) noexcept;
+        // Mark the end of the elements, which ended with `error` if it is
+        // not null.  May only be called by the producer, once.
+
+    T* front();
+        // Returns the address of the element at the front of the ring,
+        // waiting while it is empty, or the null pointer if the producer has
+        // closed the ring and every element has been popped, rethrowing the
+        // error it was closed with, if any.  May only be called by the
+        // consumer.
+
+    void pop() noexcept;
+        // Destroy the element at the front of the ring, freeing its slot.
+        // The behaviour is undefined unless `front` has returned a non-null
+        // pointer since the last `pop`.  May only be called by the consumer.
+
+    void cancel() noexcept;
+        // Close the ring from the consumer, making pending and later pushes
+        // return `false`.  May only be called by the consumer, once.
+
+private:
+    // PRIVATE CLASS METHODS
+    static void awaitChange(const std::atomic<std::size_t>& index,
+                            std::size_t value) noexcept;
+        // Return once `index` no longer holds `value`, yielding the
+        // processor a few times before blocking.
+
+    // CLASS DATA
+    static constexpr std::size_t CLOSED =
+        std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1);
+        // The bit of an index set when its side closed the ring.
+
+private:
+    // DATA
+    alignas(SPSC_RING_ALIGNMENT)
+    std::atomic<std::size_t>              d_head{0};  // written by producer
+
+    alignas(SPSC_RING_ALIGNMENT)
+    std::atomic<std::size_t>              d_tail{0};  // written by consumer
+    std::size_t                           d_headCache = 0;
+        // The last `d_head` seen by the consumer, so that it only reads the
+        // index of the producer when it runs out of elements.
+
+    alignas(SPSC_RING_ALIGNMENT)
+    std::size_t                           d_mask;
+    std::unique_ptr<std::optional<T>[]>   d_slots;
+    std::exception_ptr                    d_error;  // set before closing
+};
+
+} // close namespace detail
+
+template <typename ValueType>
+class read_ahead_range {
+    // A `read_ahead_range` reads the elements of an input range on a
+    // producer thread of its own, up to a given depth ahead of the consumer,
+    // into a lock-free ring, and provides a single pass input iterator over
+    // them, which may be held by an `any_input_iterator<ValueType>`.  A
+    // source that blocks or parses, such as a `std::istream_iterator`, so
+    // runs concurrently with the processing of the elements read.
+    //
+    // Each element is copied, or moved if the source yields rvalues, into
+    // the ring once, and the iterator refers to it there until incremented,
+    // so elements may be moved out of.  An exception thrown by the source
+    // is rethrown by the iterator once it has passed the elements read
+    // before it.
+    //
+    // Destroying the range stops the producer and waits for it, even if
+    // elements remain unread.  A producer waiting for room in the ring stops
+    // at once, but one blocked inside the source, say reading from a pipe,
+    // stops only once that read returns.
+
+public:
+    // TYPES
+    class iterator {
+        // A single pass input iterator over the elements of a
+        // `read_ahead_range`.  Incrementing any copy of an iterator
+        // invalidates the others.
+
+    public:
+        // TYPES
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ValueType;
+        using difference_type = std::ptrdiff_t;
+        using reference = ValueType&;
+        using pointer = ValueType*;
+
+        // CREATORS
+        iterator() = default;
+            // Construct the end iterator.
+
+        // ACCESSORS
+        reference operator*() const noexcept;
+            // Returns a reference to the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        pointer operator->() const noexcept;
+            // Returns the address of the current element.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        bool operator==(const iterator& rhs) const noexcept;
+            // Returns whether `*this` and `rhs` are at the same element, or
+            // both at the end.
+
+        // MANIPULATORS
+        iterator& operator++();
+            // Destroy the current element and wait for the next one to be
+            // read, rethrowing any exception the source threw in its place,
+            // then return a reference to `*this`.  The behaviour is
+            // undefined if `*this` is at the end.
+
+        void operator++(int);
+            // Equivalent to `++*this`.  As the current element is destroyed,
+            // no copy is returned.
+
+    private:
+        // PRIVATE CREATORS
+        explicit iterator(detail::SpscRing<ValueType>& ring);
+            // Construct an iterator at the front of `ring`, waiting for it
+            // to be read.
+
+        // FRIENDS
+        friend class read_ahead_range;
+
+    private:
+        // DATA
+        detail::SpscRing<ValueType> *d_ring = nullptr;
+        ValueType                   *d_current = nullptr;  // null at end
+    };
+
+    // CREATORS
+    template <typename InputIt>
+    read_ahead_range(InputIt first, InputIt last,
+                     std::size_t depth = detail::READ_AHEAD_DEPTH);
+        // Construct a `read_ahead_range` reading the elements in `[first,
+        // last)` on a new thread, at most `depth`, rounded up to a power of
+        // two, ahead of the consumer.  `first` and `last` are moved to, and
+        // only used by, that thread.
+
+    read_ahead_range(const read_ahead_range&) = delete;
+
+    ~read_ahead_range();
+        // Stop reading and join the producer thread.
+
+    // MANIPULATORS
+    read_ahead_range& operator=(const read_ahead_range&) = delete;
+
+    iterator begin();
+        // Wait for the first element to be read and return an iterator at
+        // it.  The behaviour is undefined if `begin` has already been
+        // called.
+
+    iterator end() noexcept;
+        // Returns the end iterator.
+
+private:
+    // DATA
+    detail::SpscRing<ValueType> d_ring;
+    std::thread                 d_producer;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+// SpscRing
+template <typename T>
+inline SpscRing<T>::SpscRing(std::size_t depth)
+    : d_mask(std::bit_ceil(std::max(depth, std::size_t{1})) - 1)
+    , d_slots(std::make_unique<std::optional<T>[]>(d_mask + 1))
+{}
+
+template <typename T>
+template <typename... Args>
+inline bool SpscRing<T>::push(Args&&... args)
+{
+    // The tail is read on every push, rather than cached as the head is by
+    // the consumer, so that the producer sees a `cancel` at once.
+    const std::size_t head = d_head.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::size_t tail = d_tail.load(std::memory_order_acquire);
+        if (tail & CLOSED) {
+            return false;
+        }
+        if (head - tail <= d_mask) {
+            break;
+        }
+        awaitChange(d_tail, tail);
+    }
+    d_slots[head & d_mask].emplace(std::forward<Args>(args)...);
+    d_head.store(head + 1, std::memory_order_release);
+    d_head.notify_one();
+    return true;
+}
+
+template <typename T>
+inline void SpscRing<T>::close(std::exception_ptr error) noexcept
+{
+    d_error = std::move(error);
+    d_head.fetch_or(CLOSED, std::memory_order_release);
+    d_head.notify_one();
+}
+
+template <typename T>
+inline T* SpscRing<T>::front()
+{
+    const std::size_t tail = d_tail.load(std::memory_order_relaxed);
+    while (d_headCache == tail) {
+        const std::size_t head = d_head.load(std::memory_order_acquire);
+        if ((head & ~CLOSED) != tail) {
+            d_headCache = head & ~CLOSED;
+        } else if (head & CLOSED) {
+            if (d_error) {
+                std::rethrow_exception(std::exchange(d_error, nullptr));
+            }
+            return nullptr;
+        } else {
+            awaitChange(d_head, head);
+        }
+    }
+    return &*d_slots[tail & d_mask];
+}
+
+template <typename T>
+inline void SpscRing<T>::pop() noexcept
+{
+    const std::size_t tail = d_tail.load(std::memory_order_relaxed);
+    d_slots[tail & d_mask].reset();
+    d_tail.store(tail + 1, std::memory_order_release);
+    d_tail.notify_one();
+}
+
+template <typename T>
+inline void SpscRing<T>::awaitChange(const std::atomic<std::size_t>& index,
+                                     std::size_t value) noexcept
+{
+    for (int i = 0; i != SPSC_RING_YIELDS; ++i) {
+        if (index.load(std::memory_order_acquire) != value) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    index.wait(value, std::memory_order_acquire);
+}
+
+template <typename T>
+inline void SpscRing<T>::cancel() noexcept
+{
+    d_tail.fetch_or(CLOSED, std::memory_order_release);
+    d_tail.notify_one();
+}
+
+} // close namespace detail
+
+// read_ahead_range::iterator
+template <typename ValueType>
+inline read_ahead_range<ValueType>::iterator::iterator(
+    detail::SpscRing<ValueType>& ring)
+    : d_ring(&ring)
+    , d_current(ring.front())
+{}
+
+template <typename ValueType>
+inline typename read_ahead_range<ValueType>::iterator::reference
+read_ahead_range<ValueType>::iterator::operator*() const noexcept
+{
+    return *d_current;
+}
+
+template <typename ValueType>
+inline typename read_ahead_range<ValueType>::iterator::pointer
+read_ahead_range<ValueType>::iterator::operator->() const noexcept
+{
+    return d_current;
+}
+
+template <typename ValueType>
+inline bool read_ahead_range<ValueType>::iterator::operator==(
+    const iterator& rhs) const noexcept
+{
+    return d_current == rhs.d_current;
+}
+
+template <typename ValueType>
+inline typename read_ahead_range<ValueType>::iterator&
+read_ahead_range<ValueType>::iterator::operator++()
+{
+    d_ring->pop();
+    d_current = nullptr;
+    d_current = d_ring->front();
+    return *this;
+}
+
+template <typename ValueType>
+inline void read_ahead_range<ValueType>::iterator::operator++(int)
+{
+    ++*this;
+}
+
+// read_ahead_range
+template <typename ValueType>
+template <typename InputIt>
+inline read_ahead_range<ValueType>::read_ahead_range(InputIt first,
+                                                     InputIt last,
+                                                     std::size_t depth)
+    : d_ring(depth)
+{
+    d_producer = std::thread(
+        [this, first = std::move(first), last = std::move(last)]() mutable {
+            try {
+                for (; first != last; ++first) {
+                    if (!d_ring.push(*first)) {
+                        return;
+                    }
+                }
+            } catch (...) {
+                d_ring.close(std::current_exception());
+                return;
+            }
+            d_ring.close();
+        });
+}
+
+template <typename ValueType>
+inline read_ahead_range<ValueType>::~read_ahead_range()
+{
+    d_ring.cancel();
+    d_producer.join();
+}
+
+template <typename ValueType>
+inline typename read_ahead_range<ValueType>::iterator
+read_ahead_range<ValueType>::begin()
+{
+    return iterator(d_ring);
+}
+
+template <typename ValueType>
+inline typename read_ahead_range<ValueType>::iterator
+read_ahead_range<ValueType>::end() noexcept
+{
+    return iterator();
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_READAHEAD
@@ -0,0 +1,565 @@
+#ifndef SAMPLE_REDUCTIONKERNELS
+#define SAMPLE_REDUCTIONKERNELS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SAMPLE_REDUCTIONKERNELS_X86 1
+#else
+#define SAMPLE_REDUCTIONKERNELS_X86 0
+#endif
+
+namespace sample {
+
+enum class simd_level {
+    // The instruction sets for which the reduction kernels used by the
+    // algorithms over contiguous arithmetic ranges are compiled.
+
+    scalar,  // portable loops, used where no other level is available
+    sse42,
+    avx2,
+    avx512
+};
+
+simd_level active_simd_level() noexcept;
+    // Returns the most capable `simd_level` supported by the processor, as
+    // detected on first use, whose kernels are used by the algorithms.
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_simd_arithmetic_v =
+    std::is_same_v<T, int> || std::is_same_v<T, std::int64_t> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+    // Whether reduction kernels are provided for ranges of `T`.
+
+template <typename T>
+struct ReductionKernels {
+    // A table of reduction kernels over contiguous arrays of `T`, compiled
+    // for one `simd_level`.  Floating point sums are computed in several
+    // interleaved partial sums, and so may round differently from a
+    // sequential sum, as with `std::reduce`.  Integer sums wrap on overflow.
+
+    // DATA
+    T (*sum)(const T* first, const T* last);
+        // Return the sum of the elements in `[first, last)`.
+
+    std::ptrdiff_t (*count)(const T* first, const T* last, T value);
+        // Return the number of elements in `[first, last)` equal to `value`.
+
+    const T* (*find)(const T* first, const T* last, T value);
+        // Return the first element in `[first, last)` equal to `value`, or
+        // `last` if there is none.
+
+    const T* (*minElement)(const T* first, const T* last);
+    const T* (*maxElement)(const T* first, const T* last);
+        // Return the element that `std::min_element`, respectively
+        // `std::max_element`, would return for `[first, last)`.
+};
+
+template <typename T>
+const ReductionKernels<T>& reductionKernels() noexcept;
+    // Return the kernels for `T` compiled for `active_simd_level()`.
+
+template <typename T>
+const ReductionKernels<T>& reductionKernels(simd_level level) noexcept;
+    // Return the kernels for `T` compiled for `level`, or for the most
+    // capable level below it for which kernels are compiled.  The behaviour
+    // of calling them is undefined if the processor does not support
+    // `level`.
+
+template <typename T>
+using ReductionLane = typename std::conditional_t<std::is_integral_v<T>,
+    std::make_unsigned<T>, std::type_identity<T>>::type;
+    // The type in which sums of `T` are accumulated, so that integer sums
+    // wrap rather than overflow.
+
+// ===========================================================================
+//      SCALAR KERNELS
+// ===========================================================================
+template <typename T>
+struct ScalarKernels {
+    // CLASS METHODS
+    static T sum(const T* first, const T* last);
+    static std::ptrdiff_t count(const T* first, const T* last, T value);
+    static const T* find(const T* first, const T* last, T value);
+    static const T* minElement(const T* first, const T* last);
+    static const T* maxElement(const T* first, const T* last);
+
+    // CLASS DATA
+    static constexpr ReductionKernels<T> kernels = {
+        &ScalarKernels::sum,
+        &ScalarKernels::count,
+        &ScalarKernels::find,
+        &ScalarKernels::minElement,
+        &ScalarKernels::maxElement
+    };
+};
+
+#if SAMPLE_REDUCTIONKERNELS_X86
+// ===========================================================================
+//      VECTOR KERNELS
+// ===========================================================================
+// The vector kernels are written with the GCC vector extensions, as loops
+// over two vectors of `VectorBytes` per iteration, and are inlined into
+// functions compiled for each instruction set, which choose `VectorBytes`.
+
+template <typename T, std::size_t VectorBytes>
+using Vector [[gnu::vector_size(VectorBytes)]] = T;
+
+template <typename T>
+using MaskLane = std::conditional_t<sizeof(T) == 8, std::uint64_t,
+                                    std::uint32_t>;
+    // An unsigned integer of the same width as `T`, as the lanes of the
+    // all ones or all zeros result of comparing `Vector`s of `T`.
+
+template <typename V, typename T>
+[[gnu::always_inline]] inline void loadVector(V* result, const T* address)
+{
+    std::memcpy(result, address, sizeof *result);
+}
+
+template <typename Words>
+[[gnu::always_inline]] inline bool anyLane(const Words& words) noexcept
+{
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i != sizeof(Words) / 8; ++i) {
+        bits |= words[i];
+    }
+    return bits != 0;
+}
+
+template <typename T, std::size_t VectorBytes>
+[[gnu::always_inline]] inline T sumVectors(const T* first, const T* last)
+{
+    using Lane = ReductionLane<T>;
+    using V = Vector<Lane, VectorBytes>;
+    constexpr std::ptrdiff_t lanes = VectorBytes / sizeof(T);
+
+    V partial0 = {};
+    V partial1 = {};
+    for (; last - first >= 2 * lanes; first += 2 * lanes) {
+        V addend0;
+        V addend1;
+        loadVector(&addend0, first);
+        loadVector(&addend1, first + lanes);
+        partial0 += addend0;
+        partial1 += addend1;
+    }
+    partial0 += partial1;
+
+    Lane total{};
+    for (std::ptrdiff_t i = 0; i != lanes; ++i) {
+        total += partial0[i];
+    }
+    for (; first != last; ++first) {
+        total += static_cast<Lane>(*first);
+    }
+    return static_cast<T>(total);
+}
+
+template <typename T, std::size_t VectorBytes>
+[[gnu::always_inline]] inline std::ptrdiff_t countVectors(const T* first,
+                                                          const T* last,
+                                                          T value)
+{
+    using V = Vector<T, VectorBytes>;
+    using Counts = Vector<MaskLane<T>, VectorBytes>;
+    constexpr std::ptrdiff_t lanes = VectorBytes / sizeof(T);
+
+    // Each matching lane of a mask is all ones, so subtracting the masks
+    // counts the matches.
+    const V splat = V{} + value;
+    Counts partial = {};
+    for (; last - first >= 2 * lanes; first += 2 * lanes) {
+        V block0;
+        V block1;
+        loadVector(&block0, first);
+        loadVector(&block1, first + lanes);
+        partial -= reinterpret_cast<Counts>(block0 == splat);
+        partial -= reinterpret_cast<Counts>(block1 == splat);
+    }
+
+    std::ptrdiff_t total = 0;
+    for (std::ptrdiff_t i = 0; i != lanes; ++i) {
+        total += static_cast<std::ptrdiff_t>(partial[i]);
+    }
+    for (; first != last; ++first) {
+        total += *first == value;
+    }
+    return total;
+}
+
+template <typename T, std::size_t VectorBytes>
+[[gnu::always_inline]] inline const T* findVectors(const T* first,
+                                                   const T* last,
+                                                   T value)
+{
+    using V = Vector<T, VectorBytes>;
+    using Words = Vector<std::uint64_t, VectorBytes>;
+    constexpr std::ptrdiff_t lanes = VectorBytes / sizeof(T);
+
+    // Skip whole blocks not containing `value`, then locate it within the
+    // block, or the remainder, element by element.  Each comparison is
+    // converted to integers before combining them, as combining the
+    // results of comparisons in functions not compiled for AVX-512 does not
+    // yield its mask registers when inlined into ones that are.
+    const V splat = V{} + value;
+    for (; last - first >= 2 * lanes; first += 2 * lanes) {
+        V block0;
+        V block1;
+        loadVector(&block0, first);
+        loadVector(&block1, first + lanes);
+        if (anyLane(reinterpret_cast<Words>(block0 == splat) |
+                    reinterpret_cast<Words>(block1 == splat))) {
+            break;
+        }
+    }
+    for (; first != last && !(*first == value); ++first) {
+    }
+    return first;
+}
+
+template <typename T, std::size_t VectorBytes, bool IsMax>
+[[gnu::always_inline]] inline const T* extremeElementVectors(const T* first,
+                                                             const T* last)
+{
+    using V = Vector<T, VectorBytes>;
+    constexpr std::ptrdiff_t lanes = VectorBytes / sizeof(T);
+
+    // `std::min_element` and `std::max_element` never replace an initial
+    // NaN, and never select a later one, so the extreme value is found with
+    // selections keeping the current value on unordered comparisons, and
+    // then the first element equal to it is returned.
+    if (first == last || !(*first == *first)) {
+        return first;
+    }
+
+    const T* const begin = first;
+    V partial0 = V{} + *first;
+    V partial1 = partial0;
+    for (; last - first >= 2 * lanes; first += 2 * lanes) {
+        V candidate0;
+        V candidate1;
+        loadVector(&candidate0, first);
+        loadVector(&candidate1, first + lanes);
+        if constexpr (IsMax) {
+            partial0 = partial0 < candidate0 ? candidate0 : partial0;
+            partial1 = partial1 < candidate1 ? candidate1 : partial1;
+        } else {
+            partial0 = candidate0 < partial0 ? candidate0 : partial0;
+            partial1 = candidate1 < partial1 ? candidate1 : partial1;
+        }
+    }
+
+    T extreme = *begin;
+    const auto select = [&extreme](T candidate) {
+        if (IsMax ? extreme < candidate : candidate < extreme) {
+            extreme = candidate;
+        }
+    };
+    for (std::ptrdiff_t i = 0; i != lanes; ++i) {
+        select(partial0[i]);
+        select(partial1[i]);
+    }
+    for (; first != last; ++first) {
+        select(*first);
+    }
+    return findVectors<T, VectorBytes>(begin, last, extreme);
+}
+
+template <typename T>
+struct Sse42Kernels {
+    // CLASS METHODS
+    [[gnu::target("sse4.2")]]
+    static T sum(const T* first, const T* last);
+    [[gnu::target("sse4.2")]]
+    static std::ptrdiff_t count(const T* first, const T* last, T value);
+    [[gnu::target("sse4.2")]]
+    static const T* find(const T* first, const T* last, T value);
+    [[gnu::target("sse4.2")]]
+    static const T* minElement(const T* first, const T* last);
+    [[gnu::target("sse4.2")]]
+    static const T* maxElement(const T* first, const T* last);
+
+    // CLASS DATA
+    static constexpr ReductionKernels<T> kernels = {
+        &Sse42Kernels::sum,
+        &Sse42Kernels::count,
+        &Sse42Kernels::find,
+        &Sse42Kernels::minElement,
+        &Sse42Kernels::maxElement
+    };
+};
+
+template <typename T>
+struct Avx2Kernels {
+    // CLASS METHODS
+    [[gnu::target("avx2")]]
+    static T sum(const T* first, const T* last);
+    [[gnu::target("avx2")]]
+    static std::ptrdiff_t count(const T* first, const T* last, T value);
+    [[gnu::target("avx2")]]
+    static const T* find(const T* first, const T* last, T value);
+    [[gnu::target("avx2")]]
+    static const T* minElement(const T* first, const T* last);
+    [[gnu::target("avx2")]]
+    static const T* maxElement(const T* first, const T* last);
+
+    // CLASS DATA
+    static constexpr ReductionKernels<T> kernels = {
+        &Avx2Kernels::sum,
+        &Avx2Kernels::count,
+        &Avx2Kernels::find,
+        &Avx2Kernels::minElement,
+        &Avx2Kernels::maxElement
+    };
+};
+
+template <typename T>
+struct Avx512Kernels {
+    // CLASS METHODS
+    [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq")]]
+    static T sum(const T* first, const T* last);
+    [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq")]]
+    static std::ptrdiff_t count(const T* first, const T* last, T value);
+    [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq")]]
+    static const T* find(const T* first, const T* last, T value);
+    [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq")]]
+    static const T* minElement(const T* first, const T* last);
+    [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq")]]
+    static const T* maxElement(const T* first, const T* last);
+
+    // CLASS DATA
+    static constexpr ReductionKernels<T> kernels = {
+        &Avx512Kernels::sum,
+        &Avx512Kernels::count,
+        &Avx512Kernels::find,
+        &Avx512Kernels::minElement,
+        &Avx512Kernels::maxElement
+    };
+};
+#endif
+
+simd_level detectSimdLevel() noexcept;
+    // Return the most capable `simd_level` supported by the processor.
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// ScalarKernels
+template <typename T>
+inline T ScalarKernels<T>::sum(const T* first, const T* last)
+{
+    ReductionLane<T> total{};
+    for (; first != last; ++first) {
+        total += static_cast<ReductionLane<T>>(*first);
+    }
+    return static_cast<T>(total);
+}
+
+template <typename T>
+inline std::ptrdiff_t ScalarKernels<T>::count(const T* first, const T* last,
+                                              T value)
+{
+    std::ptrdiff_t total = 0;
+    for (; first != last; ++first) {
+        total += *first == value;
+    }
+    return total;
+}
+
+template <typename T>
+inline const T* ScalarKernels<T>::find(const T* first, const T* last,
+                                       T value)
+{
+    for (; first != last && !(*first == value); ++first) {
+    }
+    return first;
+}
+
+template <typename T>
+inline const T* ScalarKernels<T>::minElement(const T* first, const T* last)
+{
+    const T* result = first;
+    for (; first != last; ++first) {
+        if (*first < *result) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+inline const T* ScalarKernels<T>::maxElement(const T* first, const T* last)
+{
+    const T* result = first;
+    for (; first != last; ++first) {
+        if (*result < *first) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+#if SAMPLE_REDUCTIONKERNELS_X86
+// Sse42Kernels
+template <typename T>
+inline T Sse42Kernels<T>::sum(const T* first, const T* last)
+{
+    return sumVectors<T, 16>(first, last);
+}
+
+template <typename T>
+inline std::ptrdiff_t Sse42Kernels<T>::count(const T* first, const T* last,
+                                             T value)
+{
+    return countVectors<T, 16>(first, last, value);
+}
+
+template <typename T>
+inline const T* Sse42Kernels<T>::find(const T* first, const T* last,
+                                      T value)
+{
+    return findVectors<T, 16>(first, last, value);
+}
+
+template <typename T>
+inline const T* Sse42Kernels<T>::minElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 16, false>(first, last);
+}
+
+template <typename T>
+inline const T* Sse42Kernels<T>::maxElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 16, true>(first, last);
+}
+
+// Avx2Kernels
+template <typename T>
+inline T Avx2Kernels<T>::sum(const T* first, const T* last)
+{
+    return sumVectors<T, 32>(first, last);
+}
+
+template <typename T>
+inline std::ptrdiff_t Avx2Kernels<T>::count(const T* first, const T* last,
+                                            T value)
+{
+    return countVectors<T, 32>(first, last, value);
+}
+
+template <typename T>
+inline const T* Avx2Kernels<T>::find(const T* first, const T* last, T value)
+{
+    return findVectors<T, 32>(first, last, value);
+}
+
+template <typename T>
+inline const T* Avx2Kernels<T>::minElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 32, false>(first, last);
+}
+
+template <typename T>
+inline const T* Avx2Kernels<T>::maxElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 32, true>(first, last);
+}
+
+// Avx512Kernels
+template <typename T>
+inline T Avx512Kernels<T>::sum(const T* first, const T* last)
+{
+    return sumVectors<T, 64>(first, last);
+}
+
+template <typename T>
+inline std::ptrdiff_t Avx512Kernels<T>::count(const T* first,
+                                              const T* last, T value)
+{
+    return countVectors<T, 64>(first, last, value);
+}
+
+template <typename T>
+inline const T* Avx512Kernels<T>::find(const T* first, const T* last,
+                                       T value)
+{
+    return findVectors<T, 64>(first, last, value);
+}
+
+template <typename T>
+inline const T* Avx512Kernels<T>::minElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 64, false>(first, last);
+}
+
+template <typename T>
+inline const T* Avx512Kernels<T>::maxElement(const T* first, const T* last)
+{
+    return extremeElementVectors<T, 64, true>(first, last);
+}
+#endif
+
+// FREE FUNCTIONS
+inline simd_level detectSimdLevel() noexcept
+{
+#if SAMPLE_REDUCTIONKERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq")) {
+        return simd_level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return simd_level::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return simd_level::sse42;
+    }
+#endif
+    return simd_level::scalar;
+}
+
+template <typename T>
+inline const ReductionKernels<T>& reductionKernels(simd_level level) noexcept
+{
+    switch (level) {
+#if SAMPLE_REDUCTIONKERNELS_X86
+      case simd_level::avx512:
+        return Avx512Kernels<T>::kernels;
+      case simd_level::avx2:
+        return Avx2Kernels<T>::kernels;
+      case simd_level::sse42:
+        return Sse42Kernels<T>::kernels;
+#endif
+      default:
+        return ScalarKernels<T>::kernels;
+    }
+}
+
+template <typename T>
+inline const ReductionKernels<T>& reductionKernels() noexcept
+{
+    static const ReductionKernels<T>& kernels =
+        reductionKernels<T>(active_simd_level());
+    return kernels;
+}
+
+} // close namespace detail
+
+inline simd_level active_simd_level() noexcept
+{
+    static const simd_level level = detail::detectSimdLevel();
+    return level;
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_REDUCTIONKERNELS
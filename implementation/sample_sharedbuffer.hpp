@@ -0,0 +1,513 @@
+#ifndef SAMPLE_SHAREDBUFFER
+#define SAMPLE_SHAREDBUFFER
+
+#include <sample_smallbuffer.hpp>
+#include <sample_stats.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sample::detail {
+
+template <typename BaseType, std::size_t BufferSize = DEFAULT_BUFFER_SIZE,
+          bool ThreadSafe = true>
+struct SharedBuffer;
+    // A `SharedBuffer` stores objects derived from `BaseType` as does a
+    // `SmallBuffer` which may allocate: within `BufferSize` bytes of inline
+    // storage when they fit, and on the heap otherwise.  Copies of a buffer
+    // holding an object on the heap share that object, only incrementing
+    // the count of its owners in the header of its block, and it is copied
+    // when an owner which is not the only one calls `unshare` before
+    // modifying it.  The count is atomic if `ThreadSafe` is `true`, so that
+    // buffers sharing an object may be copied, modified and destroyed on
+    // different threads, and a plain integer otherwise.
+    //
+    // Objects held inline are copied eagerly, as by a `SmallBuffer`.  The
+    // held object must only be modified through the reference returned by
+    // `unshare`, never through `operator*` or `operator->`.  A
+    // `SharedBuffer` which has been moved from may only be destroyed or
+    // assigned to.
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+void swap(SharedBuffer<BaseType, BufferSize, ThreadSafe>& lhs,
+          SharedBuffer<BaseType, BufferSize, ThreadSafe>& rhs) noexcept;
+
+template <bool ThreadSafe>
+struct SharedHeapHeader {
+    // This class is placed in front of every object which a `SharedBuffer`
+    // holds on the heap, in place of a `HeapHeader`.
+
+    // TYPES
+    using Count = std::conditional_t<ThreadSafe, std::atomic<std::size_t>,
+        std::size_t>;
+
+    // DATA
+    std::pmr::memory_resource* d_resource;   // the resource of the block
+    Count                      d_owners{1};  // the buffers sharing the object
+};
+
+template <typename BaseType, bool ThreadSafe>
+struct SharedBuffer_Lifecycle : SmallBuffer_Lifecycle<BaseType> {
+    // This class extends the operations managing the lifetime of an object
+    // with those needed to share it when it is held on the heap.  Copies
+    // made by `clone` onto the heap start with a single owner.
+
+    // DATA
+    SharedHeapHeader<ThreadSafe>& (*header)(const BaseType* object) noexcept;
+        // Return the header of the block holding `object`, which must be
+        // held on the heap, or null if the object is a `staticObject`,
+        // which is held without a block and never shared.
+};
+
+template <typename BaseType, typename T, bool ThreadSafe>
+SharedHeapHeader<ThreadSafe>& sharedHeader(const BaseType* object) noexcept;
+
+template <typename BaseType, typename T, bool ThreadSafe>
+inline constexpr SharedBuffer_Lifecycle<BaseType, ThreadSafe>
+    sharedLifecycle = {
+    lifecycle<BaseType, T, SharedHeapHeader<ThreadSafe>>,
+    &sharedHeader<BaseType, T, ThreadSafe>
+};
+    // The lifecycle table shared by all `SharedBuffer`s holding a `T`.
+
+template <typename BaseType, typename T, bool ThreadSafe>
+inline constexpr SharedBuffer_Lifecycle<BaseType, ThreadSafe>
+    sharedStaticLifecycle = {
+    staticLifecycle<BaseType, T>,
+    nullptr
+};
+    // The lifecycle table shared by all `SharedBuffer`s holding
+    // `staticObject<T>`.
+
+template <bool ThreadSafe>
+void acquireShare(SharedHeapHeader<ThreadSafe>& header) noexcept;
+    // Add an owner to the object following `header`.
+
+template <bool ThreadSafe>
+bool releaseShare(SharedHeapHeader<ThreadSafe>& header) noexcept;
+    // Remove an owner from the object following `header`, and return
+    // whether it was the last.
+
+template <bool ThreadSafe>
+bool isShared(const SharedHeapHeader<ThreadSafe>& header) noexcept;
+    // Return whether the object following `header` has other owners than
+    // the calling one.
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+struct is_buffer_convertible<SharedBuffer<BaseType, BufferSize, ThreadSafe>,
+                             SharedBuffer<BaseType, BufferSize, ThreadSafe>>
+    : std::true_type {};
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+struct SharedBuffer {
+    // CREATORS
+    SharedBuffer(const SharedBuffer& rhs);
+    SharedBuffer(SharedBuffer&& rhs) noexcept;
+    template <typename T, typename... Args>
+    SharedBuffer(std::in_place_type_t<T>, Args&&... args);
+    template <typename T, typename... Args>
+    SharedBuffer(std::allocator_arg_t, std::pmr::memory_resource* resource,
+                 std::in_place_type_t<T>, Args&&... args);
+    template <typename T>
+    explicit SharedBuffer(InPlaceStatic<T>) noexcept;
+        // Hold a default constructed `T`, which must be empty and trivially
+        // default constructible, within the inline storage if it fits, and
+        // otherwise by referring to `staticObject<T>`, so that neither this
+        // buffer nor its copies allocate.
+    ~SharedBuffer();
+
+    // CLASS METHODS
+    template <typename T>
+    static constexpr bool holdsInline() noexcept;
+        // Return whether a `T` constructed in a `SharedBuffer` of this type
+        // is held within its inline storage, rather than shared on the
+        // heap.
+
+    static constexpr std::size_t capacity() noexcept;
+        // Return the size of the inline storage, `BufferSize`.
+
+    template <typename T>
+    static constexpr std::size_t heapBytes() noexcept;
+        // Return the bytes allocated to hold a `T` on the heap, including
+        // the header in front of it, or zero if it is held inline.
+
+    // ACCESSORS
+    BaseType& operator*() const noexcept;
+    BaseType* operator->() const noexcept;
+
+    bool isShared() const noexcept;
+        // Return whether the held object is shared with another buffer.
+
+    // MANIPULATORS
+    SharedBuffer& operator=(const SharedBuffer& rhs);
+    SharedBuffer& operator=(SharedBuffer&& rhs) noexcept;
+
+    void swap(SharedBuffer& other) noexcept;
+
+    BaseType& unshare();
+        // Return the held object, so that it may be modified, first
+        // replacing it with a copy of its own if it is shared with another
+        // buffer.  Throws if that copy throws, leaving `*this` unchanged.
+
+private:
+    // PRIVATE TYPES
+    struct Absent {};
+        // An empty placeholder for the storage of a buffer of no size.
+
+    using BufferType = std::conditional_t<BufferSize == 0, Absent,
+        std::aligned_storage_t<BufferSize, BUFFER_ALIGNMENT>>;
+    using Header = SharedHeapHeader<ThreadSafe>;
+    using Lifecycle = SharedBuffer_Lifecycle<BaseType, ThreadSafe>;
+
+private:
+    // PRIVATE ACCESSORS
+    bool isInline() const noexcept;
+        // Return whether the held object lives within `d_storage`, rather
+        // than on the heap.
+
+    bool isCounted() const noexcept;
+        // Return whether the held object lives in a block on the heap,
+        // with a count of its owners, rather than inline or as a
+        // `staticObject`.
+
+    std::byte* storage() const noexcept;
+        // Return the address of `d_storage`.
+
+    // PRIVATE MANIPULATORS
+    void moveFrom(SharedBuffer& rhs) noexcept;
+        // Take the object held by `rhs`, taking ownership of its share if
+        // it is on the heap.  The behaviour is undefined if `*this` holds
+        // an object.
+
+    void destroy() noexcept;
+        // Destroy the held object if it is inline, and otherwise give up
+        // its share, destroying it and releasing its memory if that was
+        // the last.
+
+private:
+    // DATA
+    const Lifecycle*                 d_lifecycle;
+    [[no_unique_address]] BufferType d_storage;
+    BaseType*                        d_object;  // null if moved from
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// FREE FUNCTIONS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+void swap(SharedBuffer<BaseType, BufferSize, ThreadSafe>& lhs,
+          SharedBuffer<BaseType, BufferSize, ThreadSafe>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+template <typename BaseType, typename T, bool ThreadSafe>
+SharedHeapHeader<ThreadSafe>& sharedHeader(const BaseType* object) noexcept
+{
+    return heapHeader<SharedHeapHeader<ThreadSafe>>(
+        static_cast<const T*>(object));
+}
+
+template <bool ThreadSafe>
+inline void acquireShare(SharedHeapHeader<ThreadSafe>& header) noexcept
+{
+    if constexpr (ThreadSafe) {
+        // A new owner is made from an existing one, which keeps the object
+        // alive, so nothing need be ordered with the increment.
+        header.d_owners.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        ++header.d_owners;
+    }
+}
+
+template <bool ThreadSafe>
+inline bool releaseShare(SharedHeapHeader<ThreadSafe>& header) noexcept
+{
+    if constexpr (ThreadSafe) {
+        return header.d_owners.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    } else {
+        return --header.d_owners == 0;
+    }
+}
+
+template <bool ThreadSafe>
+inline bool isShared(const SharedHeapHeader<ThreadSafe>& header) noexcept
+{
+    if constexpr (ThreadSafe) {
+        // Acquire the releases of former owners, so that their reads of the
+        // object happen before the caller modifies it.
+        return header.d_owners.load(std::memory_order_acquire) != 1;
+    } else {
+        return header.d_owners != 1;
+    }
+}
+
+// CREATORS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+template <typename T, typename... Args>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::SharedBuffer(
+    std::in_place_type_t<T>, Args&&... args)
+    : SharedBuffer(std::allocator_arg, nullptr, std::in_place_type<T>,
+                   std::forward<Args>(args)...)
+{}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+template <typename T, typename... Args>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::SharedBuffer(
+    std::allocator_arg_t, std::pmr::memory_resource* resource,
+    std::in_place_type_t<T>, Args&&... args)
+    : d_lifecycle(&sharedLifecycle<BaseType, std::decay_t<T>, ThreadSafe>)
+{
+    using decayed_type = std::decay_t<T>;
+    static_assert(std::is_base_of_v<BaseType, decayed_type>);
+
+    if constexpr (holdsInline<decayed_type>()) {
+        d_object = new ((void*)storage()) decayed_type(
+            std::forward<Args>(args)...);
+    } else {
+        d_object = heapConstruct<decayed_type, Header>(resource,
+            std::forward<Args>(args)...);
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+template <typename T>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::SharedBuffer(
+    InPlaceStatic<T>) noexcept
+    : d_lifecycle(holdsInline<T>()
+        ? &sharedLifecycle<BaseType, T, ThreadSafe>
+        : &sharedStaticLifecycle<BaseType, T, ThreadSafe>)
+{
+    static_assert(std::is_base_of_v<BaseType, T>);
+    static_assert(std::is_empty_v<T> &&
+                  std::is_trivially_default_constructible_v<T>);
+
+    if constexpr (holdsInline<T>()) {
+        d_object = new ((void*)storage()) T();
+    } else {
+        d_object = &staticObject<T>;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::SharedBuffer(
+    const SharedBuffer& rhs)
+    : d_lifecycle(rhs.d_lifecycle)
+{
+    if (!rhs.d_object) {
+        d_object = nullptr;
+        return;
+    }
+    statsCount(d_lifecycle->type, stats_counter::clone);
+
+    if (rhs.isCounted()) {
+        acquireShare(d_lifecycle->header(rhs.d_object));
+        d_object = rhs.d_object;
+        return;
+    }
+
+    if (rhs.isInline() && d_lifecycle->trivial) {
+        std::memcpy(storage(), rhs.storage(), BufferSize);
+        d_object = reinterpret_cast<BaseType*>(storage() +
+            (reinterpret_cast<std::byte*>(rhs.d_object) - rhs.storage()));
+        return;
+    }
+
+    d_object = d_lifecycle->clone(rhs.d_object, nullptr, storage(),
+                                  BufferSize);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::SharedBuffer(
+    SharedBuffer&& rhs) noexcept
+{
+    moveFrom(rhs);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>::~SharedBuffer()
+{
+    destroy();
+}
+
+// CLASS METHODS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+template <typename T>
+inline constexpr bool SharedBuffer<BaseType, BufferSize, ThreadSafe>::
+    holdsInline() noexcept
+{
+    return fitsInline<T>(BufferSize);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline constexpr std::size_t SharedBuffer<BaseType, BufferSize, ThreadSafe>::
+    capacity() noexcept
+{
+    return BufferSize;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+template <typename T>
+inline constexpr std::size_t SharedBuffer<BaseType, BufferSize, ThreadSafe>::
+    heapBytes() noexcept
+{
+    return holdsInline<T>() ? 0 : heapSize<T, Header>;
+}
+
+// ACCESSORS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline BaseType& SharedBuffer<BaseType, BufferSize, ThreadSafe>::operator*()
+    const noexcept
+{
+    return *d_object;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline BaseType* SharedBuffer<BaseType, BufferSize, ThreadSafe>::operator->()
+    const noexcept
+{
+    return d_object;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline bool SharedBuffer<BaseType, BufferSize, ThreadSafe>::isShared()
+    const noexcept
+{
+    return d_object && isCounted() &&
+        detail::isShared(d_lifecycle->header(d_object));
+}
+
+// MANIPULATORS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>&
+    SharedBuffer<BaseType, BufferSize, ThreadSafe>::operator=(
+        const SharedBuffer& rhs)
+{
+    SharedBuffer tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline SharedBuffer<BaseType, BufferSize, ThreadSafe>&
+    SharedBuffer<BaseType, BufferSize, ThreadSafe>::operator=(
+        SharedBuffer&& rhs) noexcept
+{
+    if (this != &rhs) {
+        destroy();
+        moveFrom(rhs);
+    }
+    return *this;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline void SharedBuffer<BaseType, BufferSize, ThreadSafe>::swap(
+    SharedBuffer& other) noexcept
+{
+    if (!isInline() && !other.isInline()) {
+        std::swap(d_lifecycle, other.d_lifecycle);
+        std::swap(d_object, other.d_object);
+        return;
+    }
+
+    SharedBuffer tmp(std::move(*this));
+    destroy();
+    moveFrom(other);
+    other.destroy();
+    other.moveFrom(tmp);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline BaseType& SharedBuffer<BaseType, BufferSize, ThreadSafe>::unshare()
+{
+    if (isCounted() && detail::isShared(d_lifecycle->header(d_object))) {
+        BaseType* const copy = d_lifecycle->clone(d_object,
+            d_lifecycle->resource(d_object), storage(), 0);
+        destroy();
+        d_object = copy;
+    }
+    return *d_object;
+}
+
+// PRIVATE ACCESSORS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline bool SharedBuffer<BaseType, BufferSize, ThreadSafe>::isInline()
+    const noexcept
+{
+    if constexpr (BufferSize == 0) {
+        return false;
+    } else {
+        const std::uintptr_t object =
+            reinterpret_cast<std::uintptr_t>(d_object);
+        const std::uintptr_t first
+            = reinterpret_cast<std::uintptr_t>(storage());
+        return object >= first && object < first + BufferSize;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline bool SharedBuffer<BaseType, BufferSize, ThreadSafe>::isCounted()
+    const noexcept
+{
+    return !isInline() && d_lifecycle->header;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline std::byte* SharedBuffer<BaseType, BufferSize, ThreadSafe>::storage()
+    const noexcept
+{
+    return reinterpret_cast<std::byte*>(
+        const_cast<BufferType*>(std::addressof(d_storage)));
+}
+
+// PRIVATE MANIPULATORS
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline void SharedBuffer<BaseType, BufferSize, ThreadSafe>::moveFrom(
+    SharedBuffer& rhs) noexcept
+{
+    d_lifecycle = rhs.d_lifecycle;
+    statsCount(d_lifecycle->type, stats_counter::move);
+
+    if (!rhs.isInline()) {
+        d_object = std::exchange(rhs.d_object, nullptr);
+        return;
+    }
+
+    if (d_lifecycle->trivial) {
+        std::memcpy(storage(), rhs.storage(), BufferSize);
+        d_object = reinterpret_cast<BaseType*>(storage() +
+            (reinterpret_cast<std::byte*>(rhs.d_object) - rhs.storage()));
+        return;
+    }
+
+    d_object = d_lifecycle->move(rhs.d_object, nullptr, storage(),
+                                 BufferSize);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+inline void SharedBuffer<BaseType, BufferSize, ThreadSafe>::destroy() noexcept
+{
+    if (!d_object) {
+        return;
+    }
+
+    if (isInline()) {
+        if (!d_lifecycle->trivial) {
+            d_lifecycle->destroy(d_object, true);
+        }
+    } else if (isCounted() && releaseShare(d_lifecycle->header(d_object))) {
+        d_lifecycle->destroy(d_object, false);
+    }
+}
+
+} // close namespace sample::detail
+
+#endif // SAMPLE_SHAREDBUFFER
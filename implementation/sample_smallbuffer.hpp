@@ -1,8 +1,16 @@
 #ifndef SAMPLE_SMALLBUFFER_HPP
 #define SAMPLE_SMALLBUFFER_HPP
 
+#include <sample_iteratorpool.hpp>
+#include <sample_stats.hpp>
+#include <sample_typetoken.hpp>
+
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
 #include <new>
 #include <utility>
 #include <type_traits>
@@ -11,241 +19,801 @@ namespace sample::detail {
 
 constexpr std::size_t DEFAULT_BUFFER_SIZE = 64ul;
 
-template <typename BaseType, std::size_t BufferSize = DEFAULT_BUFFER_SIZE>
+constexpr std::size_t BUFFER_ALIGNMENT = alignof(void*);
+    // The alignment of the storage of a `SmallBuffer`.  Objects which are
+    // more strictly aligned are never held inline.
+
+template <typename BaseType, std::size_t BufferSize = DEFAULT_BUFFER_SIZE,
+          bool HeapAllowed = true>
 struct SmallBuffer;
+    // A `SmallBuffer` stores objects derived from `BaseType` within
+    // `BufferSize` bytes of inline storage, falling back to the heap for
+    // objects that do not fit if `HeapAllowed` is `true`.  A `BufferSize` of
+    // zero stores every object on the heap, and a `HeapAllowed` of `false`
+    // rejects, at compile time, any object that does not fit.
+    //
+    // Objects on the heap are allocated from a `std::pmr::memory_resource`,
+    // recorded in a header in front of the object, so that copies of the
+    // object are allocated from the same resource.  A buffer which may hold
+    // objects both inline and on the heap also records the resource it was
+    // given, so that an inline object which spills to the heap when copied
+    // or moved into a smaller buffer is allocated from it too, and passes
+    // it on to its copies.  A buffer which never allocates records no
+    // resource, and objects spilling from it, like those given no resource,
+    // use the default resource, which is `iterator_pool_resource()` if
+    // `SAMPLE_ANYITERATOR_POOL` is defined, and
+    // `std::pmr::get_default_resource()` otherwise.
+    //
+    // Only objects which are nothrow move constructible are held inline, so
+    // that moving a `SmallBuffer` never throws: an object on the heap is
+    // moved by taking ownership of its address, and an inline object which
+    // is trivially copyable is moved by copying its bytes.  A `SmallBuffer`
+    // which has been moved from may only be destroyed or assigned to.
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+void swap(SmallBuffer<BaseType, BufferSize, HeapAllowed>& lhs,
+          SmallBuffer<BaseType, BufferSize, HeapAllowed>& rhs) noexcept;
+
+template <typename BaseType>
+struct SmallBuffer_Lifecycle {
+    // This class holds the operations needed to manage the lifetime of an
+    // object stored in a `SmallBuffer`.  Exactly one table exists for each
+    // stored type, so a `SmallBuffer` need only hold a pointer to it.
+
+    // DATA
+    BaseType* (*clone)(const BaseType* original,
+                       std::pmr::memory_resource* resource,
+                       std::byte* targetBuffer, std::size_t bufferSize);
+        // Copy construct the object at `original` into `targetBuffer` if it
+        // fits within `bufferSize` bytes, or onto the heap otherwise,
+        // allocating from `resource`, or from the default resource if it is
+        // null, and return the address of the copy.
+
+    BaseType* (*move)(BaseType* original, std::pmr::memory_resource* resource,
+                      std::byte* targetBuffer, std::size_t bufferSize);
+        // Move construct the object at `original` into `targetBuffer` if it
+        // fits within `bufferSize` bytes, or onto the heap otherwise,
+        // allocating from `resource`, or from the default resource if it is
+        // null, and return the address of the new object.
+
+    void (*destroy)(BaseType* object, bool isInline) noexcept;
+        // Destroy the object at `object`, also releasing its memory unless
+        // `isInline` is `true`.
+
+    std::pmr::memory_resource* (*resource)(const BaseType* object) noexcept;
+        // Return the memory resource of the block holding `object`, which
+        // must be held on the heap, or null if it holds none.
+
+    bool trivial;
+        // Whether the stored type is trivially copyable, in which case an
+        // inline object may be copied or relocated by copying its bytes and
+        // needs no destruction.
+
+    type_token type;
+        // The type under which copies and moves of the stored object are
+        // counted if `SAMPLE_ANYITERATOR_STATS` is defined.
+};
+
+template <typename T>
+constexpr bool fitsInline(std::size_t bufferSize) noexcept;
+    // Return whether a `T` is held within `bufferSize` bytes of inline
+    // storage, rather than on the heap.
+
+struct HeapHeader {
+    // This class is placed in front of every object which a `SmallBuffer`
+    // holds on the heap.  Other headers, which must likewise begin with the
+    // resource of the block and be constructible from it alone, may be used
+    // in its place by buffers needing to record more about the block.
+
+    // DATA
+    std::pmr::memory_resource* d_resource;  // the resource of the block
+};
+
+template <typename T, typename Header = HeapHeader, typename... Args>
+T* heapConstruct(std::pmr::memory_resource* resource, Args&&... args);
+    // Allocate a block from `resource`, or from the default resource of a
+    // `SmallBuffer` if `resource` is null, holding a `Header` followed by a
+    // `T` constructed from `args`, and return the address of the `T`.
+
+template <typename Header = HeapHeader, typename T>
+Header& heapHeader(const T* object) noexcept;
+    // Return the header of the block holding `object`, which must have been
+    // created by `heapConstruct` with the same `Header`.
+
+template <typename Header = HeapHeader, typename T>
+void heapDestroy(T* object) noexcept;
+    // Destroy `object`, which must have been created by `heapConstruct`
+    // with the same `Header`, and return its block to its memory resource.
+
+template <typename BaseType, typename T, typename Header = HeapHeader>
+BaseType* cloner(const BaseType* original,
+                 std::pmr::memory_resource* resource,
+                 std::byte* targetBuffer, std::size_t bufferSize);
+
+template <typename BaseType, typename T, typename Header = HeapHeader>
+BaseType* mover(BaseType* original, std::pmr::memory_resource* resource,
+                std::byte* targetBuffer, std::size_t bufferSize);
+
+template <typename BaseType, typename T, typename Header = HeapHeader>
+void deleter(BaseType* obj, bool isInline) noexcept;
+
+template <typename BaseType, typename T, typename Header = HeapHeader>
+std::pmr::memory_resource* heapResource(const BaseType* obj) noexcept;
+
+template <typename BaseType, typename T, typename Header = HeapHeader>
+inline constexpr SmallBuffer_Lifecycle<BaseType> lifecycle = {
+    &cloner<BaseType, T, Header>,
+    &mover<BaseType, T, Header>,
+    &deleter<BaseType, T, Header>,
+    &heapResource<BaseType, T, Header>,
+    std::is_trivially_copyable_v<T>,
+    stats_type<T>::value
+};
+    // The lifecycle table shared by all `SmallBuffer`s holding a `T`, or by
+    // all buffers holding a `T` behind a `Header` on the heap.
+
+template <typename T>
+struct InPlaceStatic {};
+    // A tag selecting the constructors of `SmallBuffer` and `SharedBuffer`
+    // which hold an object of the empty type `T` without allocating.
+
+template <typename T>
+inline constexpr InPlaceStatic<T> inPlaceStatic{};
+
+template <typename T>
+inline T staticObject{};
+    // The instance of the empty type `T` held by every buffer which cannot
+    // hold a `T` inline, which is never modified, copied or destroyed.
+
+template <typename BaseType, typename T>
+BaseType* staticCloner(const BaseType* original,
+                       std::pmr::memory_resource* resource,
+                       std::byte* targetBuffer, std::size_t bufferSize);
+
+template <typename BaseType, typename T>
+BaseType* staticMover(BaseType* original, std::pmr::memory_resource* resource,
+                      std::byte* targetBuffer, std::size_t bufferSize);
+
+template <typename BaseType, typename T>
+void staticDeleter(BaseType* obj, bool isInline) noexcept;
 
-template <typename BaseType, std::size_t BufferSize>
-void swap(SmallBuffer<BaseType, BufferSize>& lhs, 
-          SmallBuffer<BaseType, BufferSize>& rhs);
+template <typename BaseType, typename T>
+std::pmr::memory_resource* staticResource(const BaseType* obj) noexcept;
 
-template <typename BaseType, std::size_t BufferSize>
+template <typename BaseType, typename T>
+inline constexpr SmallBuffer_Lifecycle<BaseType> staticLifecycle = {
+    &staticCloner<BaseType, T>,
+    &staticMover<BaseType, T>,
+    &staticDeleter<BaseType, T>,
+    &staticResource<BaseType, T>,
+    false,
+    stats_type<T>::value
+};
+    // The lifecycle table shared by all buffers holding `staticObject<T>`,
+    // whose copies and moves refer to the same instance.
+
+template <typename From, typename To>
+struct is_buffer_convertible : std::false_type {};
+    // Trait detecting whether any object held by a `SmallBuffer` of type
+    // `From` can be copied or moved into a `SmallBuffer` of type `To`.  This
+    // is always so if `To` may allocate, and otherwise only if `From` is at
+    // most as large and never allocates either.
+
+template <typename BaseType, std::size_t FromSize, bool FromHeapAllowed,
+          std::size_t ToSize, bool ToHeapAllowed>
+struct is_buffer_convertible<SmallBuffer<BaseType, FromSize, FromHeapAllowed>,
+                             SmallBuffer<BaseType, ToSize, ToHeapAllowed>>
+    : std::bool_constant<ToHeapAllowed ||
+        (!FromHeapAllowed && FromSize <= ToSize)> {};
+
+template <typename From, typename To>
+constexpr bool is_buffer_convertible_v = is_buffer_convertible<From, To>::value;
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
 struct SmallBuffer {
     // CREATORS
     SmallBuffer(const SmallBuffer& rhs);
-    SmallBuffer(SmallBuffer&& rhs);
+    SmallBuffer(SmallBuffer&& rhs) noexcept;
     template <typename T, typename... Args>
     SmallBuffer(std::in_place_type_t<T>, Args&&... args);
-    template <typename OtherBase, std::size_t OtherBufferSize,
-              typename = std::enable_if_t<std::is_base_of_v<BaseType, OtherBase>>>
-    SmallBuffer(const SmallBuffer<OtherBase, OtherBufferSize>& rhs);
-    template <typename OtherBase, std::size_t OtherBufferSize,
-              typename = std::enable_if_t<std::is_base_of_v<BaseType, OtherBase>>>
-    SmallBuffer(SmallBuffer<OtherBase, OtherBufferSize>&& rhs);
+    template <typename T, typename... Args>
+    SmallBuffer(std::allocator_arg_t, std::pmr::memory_resource* resource,
+                std::in_place_type_t<T>, Args&&... args);
+    template <typename T>
+    explicit SmallBuffer(InPlaceStatic<T>) noexcept;
+        // Hold a default constructed `T`, which must be empty and trivially
+        // default constructible, within the inline storage if it fits, and
+        // otherwise by referring to `staticObject<T>`, so that neither this
+        // buffer nor its copies allocate.
+    template <std::size_t OtherBufferSize, bool OtherHeapAllowed,
+              typename = std::enable_if_t<is_buffer_convertible_v<
+                SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>,
+                SmallBuffer>>>
+    SmallBuffer(const SmallBuffer<BaseType, OtherBufferSize,
+                                  OtherHeapAllowed>& rhs);
+    template <std::size_t OtherBufferSize, bool OtherHeapAllowed,
+              typename = std::enable_if_t<is_buffer_convertible_v<
+                SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>,
+                SmallBuffer>>>
+    SmallBuffer(SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>&& rhs);
     ~SmallBuffer();
 
+    // CLASS METHODS
+    template <typename T>
+    static constexpr bool holdsInline() noexcept;
+        // Return whether a `T` constructed in a `SmallBuffer` of this type
+        // is held within its inline storage, rather than on the heap.  If
+        // not, and `HeapAllowed` is `false`, constructing it is ill-formed.
+
+    static constexpr std::size_t capacity() noexcept;
+        // Return the size of the inline storage, `BufferSize`.
+
+    template <typename T>
+    static constexpr std::size_t heapBytes() noexcept;
+        // Return the bytes allocated to hold a `T` on the heap, including
+        // the header in front of it, or zero if it is held inline.
+
     // ACCESSORS
     BaseType& operator*() const noexcept;
     BaseType* operator->() const noexcept;
 
     // MANIPULATORS
-    void swap(SmallBuffer& other);
+    SmallBuffer& operator=(const SmallBuffer& rhs);
+    SmallBuffer& operator=(SmallBuffer&& rhs) noexcept;
+
+    void swap(SmallBuffer& other) noexcept;
+
+    BaseType& unshare() noexcept;
+        // Return the held object, so that it may be modified.  A
+        // `SmallBuffer` never shares its object, so this is `**this`.
 
 private:
     // PRIVATE TYPES
-    using BufferType = std::aligned_storage_t<BufferSize, alignof(BaseType)>;
-    using CloneFunc = BaseType*(*)(const BaseType*, std::byte*, std::size_t);
-    using MoveFunc = BaseType*(*)(BaseType*&, std::byte*, std::size_t);
-    using DeleteFunc = void(*)(BaseType*);
+    template <int>
+    struct Absent {};
+        // An empty placeholder for members not needed by this kind of
+        // buffer.
+
+    using BufferType = std::conditional_t<BufferSize == 0, Absent<0>,
+        std::aligned_storage_t<BufferSize, BUFFER_ALIGNMENT>>;
+    using ObjectPointer = std::conditional_t<HeapAllowed, BaseType*,
+        Absent<1>>;
+    using ResourcePointer = std::conditional_t<HeapAllowed && BufferSize != 0,
+        std::pmr::memory_resource*, Absent<2>>;
+    using Lifecycle = SmallBuffer_Lifecycle<BaseType>;
 
 private:
     // FRIENDS
-    template <typename OtherBase, std::size_t OtherSize>
-    friend class SmallBuffer;
+    template <typename OtherBase, std::size_t OtherSize, bool OtherHeapAllowed>
+    friend struct SmallBuffer;
+
+private:
+    // PRIVATE ACCESSORS
+    BaseType* object() const noexcept;
+        // Return the address of the held object, or the null pointer if
+        // `*this` has been moved from.
+
+    bool isInline() const noexcept;
+        // Return whether the held object lives within `d_storage`, rather
+        // than on the heap.
+
+    std::pmr::memory_resource* resource() const noexcept;
+        // Return the memory resource from which copies of the held object
+        // spilling to the heap are allocated: that of its block if it is on
+        // the heap, and otherwise the one recorded in `d_resource`, or null
+        // for the default resource.
+
+    std::byte* storage() const noexcept;
+        // Return the address of `d_storage`.
+
+    // PRIVATE MANIPULATORS
+    void setObject(BaseType* object) noexcept;
+        // Record `object`, which must be held in `d_storage` unless
+        // `HeapAllowed` is `true`, as the held object.
+
+    void setResource(std::pmr::memory_resource* resource) noexcept;
+        // Record `resource` as that of the held object, if this kind of
+        // buffer records one.
+
+    template <std::size_t OtherBufferSize, bool OtherHeapAllowed>
+    void moveFrom(SmallBuffer<BaseType, OtherBufferSize,
+                              OtherHeapAllowed>& rhs);
+        // Take the object held by `rhs`, taking ownership of its address if
+        // it is on the heap and `*this` may allocate.  The behaviour is
+        // undefined if `*this` holds an object.
+
+    void destroy() noexcept;
+        // Destroy the held object, releasing its memory if it is on the
+        // heap.
 
 private:
     // DATA
-    CloneFunc   d_cloner;
-    MoveFunc    d_mover;
-    DeleteFunc  d_deleter;
-    BufferType  d_storage;
-    BaseType*   d_type;
+    const Lifecycle*                      d_lifecycle;
+    [[no_unique_address]] BufferType      d_storage;
+    [[no_unique_address]] ObjectPointer   d_type;  // only if `HeapAllowed`
+    [[no_unique_address]] ResourcePointer d_resource{};
+        // only if objects may be held both inline and on the heap
 };
 
 // ===========================================================================
 //      INLINE DEFINITIONS
 // ===========================================================================
 // FREE FUNCTIONS
-template <typename BaseType, std::size_t BufferSize>
-void swap(SmallBuffer<BaseType, BufferSize>& lhs,
-          SmallBuffer<BaseType, BufferSize>& rhs)
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+void swap(SmallBuffer<BaseType, BufferSize, HeapAllowed>& lhs,
+          SmallBuffer<BaseType, BufferSize, HeapAllowed>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
 template <typename T>
-constexpr std::byte* nextAlignedAddress(std::byte* address) noexcept
+inline constexpr bool fitsInline(std::size_t bufferSize) noexcept
 {
-    const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(address);
-    if (auto offset = value % alignof(T); offset) {
-        return address + (alignof(T) - offset);
-    } 
-    return address;
+    return sizeof(T) <= bufferSize && alignof(T) <= BUFFER_ALIGNMENT &&
+        std::is_nothrow_move_constructible_v<T>;
 }
 
-template <typename BaseType, typename T>
-BaseType* cloner(const BaseType* original, std::byte* targetBuffer, 
-                 std::size_t bufferSize)
+template <typename T, typename Header = HeapHeader>
+constexpr std::size_t heapAlignment
+    = alignof(T) > alignof(Header) ? alignof(T) : alignof(Header);
+    // The alignment of a block holding a `T` on the heap.
+
+template <typename T, typename Header = HeapHeader>
+constexpr std::size_t heapOffset
+    = (sizeof(Header) + heapAlignment<T, Header> - 1)
+    / heapAlignment<T, Header> * heapAlignment<T, Header>;
+    // The offset of the `T` within a block holding it on the heap.
+
+template <typename T, typename Header = HeapHeader>
+constexpr std::size_t heapSize = heapOffset<T, Header> + sizeof(T);
+    // The size of a block holding a `T` on the heap.
+
+template <typename T, typename Header, typename... Args>
+T* heapConstruct(std::pmr::memory_resource* resource, Args&&... args)
+{
+    if (!resource) {
+#ifdef SAMPLE_ANYITERATOR_POOL
+        resource = iterator_pool_resource();
+#else
+        resource = std::pmr::get_default_resource();
+#endif
+    }
+
+    std::byte* const block = static_cast<std::byte*>(resource->allocate(
+        heapSize<T, Header>, heapAlignment<T, Header>));
+    new ((void*)block) Header{resource};
+    statsCount(stats_type<T>::value, stats_counter::spill);
+    statsCount(stats_type<T>::value, stats_counter::heap_bytes,
+               heapSize<T, Header>);
+
+    try {
+        return new ((void*)(block + heapOffset<T, Header>))
+            T(std::forward<Args>(args)...);
+    } catch (...) {
+        std::launder(reinterpret_cast<Header*>(block))->~Header();
+        resource->deallocate(block, heapSize<T, Header>,
+            heapAlignment<T, Header>);
+        throw;
+    }
+}
+
+template <typename Header, typename T>
+Header& heapHeader(const T* object) noexcept
+{
+    std::byte* const address = const_cast<std::byte*>(
+        reinterpret_cast<const std::byte*>(object));
+    return *std::launder(reinterpret_cast<Header*>(
+        address - heapOffset<T, Header>));
+}
+
+template <typename Header, typename T>
+void heapDestroy(T* object) noexcept
+{
+    Header& header = heapHeader<Header>(object);
+    std::pmr::memory_resource* const resource = header.d_resource;
+
+    object->~T();
+    header.~Header();
+    resource->deallocate(&header, heapSize<T, Header>,
+        heapAlignment<T, Header>);
+}
+
+template <typename BaseType, typename T, typename Header>
+BaseType* cloner(const BaseType* original,
+                 std::pmr::memory_resource* resource,
+                 std::byte* targetBuffer, std::size_t bufferSize)
 {
     static_assert(std::is_base_of_v<BaseType, T>);
     const T* const cast_original = static_cast<const T*>(original);
 
-    std::byte* const alignedTarget = nextAlignedAddress<T>(targetBuffer);
-    const std::ptrdiff_t offset = alignedTarget - targetBuffer;
-    bufferSize -= offset;
-
-    if (bufferSize >= sizeof(T)) {
-        new ((void*)alignedTarget) T(*cast_original);
-        return reinterpret_cast<BaseType*>(alignedTarget);
+    if (fitsInline<T>(bufferSize)) {
+        return new ((void*)targetBuffer) T(*cast_original);
     } else {
-        return new T(*cast_original);
+        return heapConstruct<T, Header>(resource, *cast_original);
     }
 }
 
-template <typename BaseType, typename T, bool NeedsNullify>
-BaseType* mover(BaseType*& original, std::byte* targetBuffer, 
-                std::size_t bufferSize)
+template <typename BaseType, typename T, typename Header>
+BaseType* mover(BaseType* original, std::pmr::memory_resource* resource,
+                std::byte* targetBuffer, std::size_t bufferSize)
 {
     static_assert(std::is_base_of_v<BaseType, T>);
     T* const cast_original = static_cast<T*>(original);
 
-    std::byte* const alignedTarget = nextAlignedAddress<T>(targetBuffer);
-    const std::ptrdiff_t offset = alignedTarget - targetBuffer;
-    bufferSize -= offset;
-
-    if (bufferSize >= sizeof(T)) {
-        new ((void*)alignedTarget) T(std::move(*cast_original));
-        return reinterpret_cast<BaseType*>(alignedTarget);
+    if (!fitsInline<T>(bufferSize)) {
+        return heapConstruct<T, Header>(resource, std::move(*cast_original));
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memcpy(targetBuffer, cast_original, sizeof(T));
+        return std::launder(reinterpret_cast<T*>(targetBuffer));
     } else {
-        return new T(std::move(*cast_original));
+        return new ((void*)targetBuffer) T(std::move(*cast_original));
     }
+}
 
-    if constexpr (NeedsNullify) {
-        original = nullptr;
-    }
+template <typename BaseType, typename T, typename Header>
+std::pmr::memory_resource* heapResource(const BaseType* obj) noexcept
+{
+    return heapHeader<Header>(static_cast<const T*>(obj)).d_resource;
 }
 
-template <typename BaseType, typename T, bool NeedsDelete>
-void deleter(BaseType* obj)
+template <typename BaseType, typename T>
+BaseType* staticCloner(const BaseType* original, std::pmr::memory_resource*,
+                       std::byte*, std::size_t)
 {
-    if constexpr (NeedsDelete) {
-        delete obj;
-    } else {
+    return const_cast<BaseType*>(original);
+}
+
+template <typename BaseType, typename T>
+BaseType* staticMover(BaseType* original, std::pmr::memory_resource*,
+                      std::byte*, std::size_t)
+{
+    return original;
+}
+
+template <typename BaseType, typename T>
+void staticDeleter(BaseType*, bool) noexcept
+{}
+
+template <typename BaseType, typename T>
+std::pmr::memory_resource* staticResource(const BaseType*) noexcept
+{
+    return nullptr;
+}
+
+template <typename BaseType, typename T, typename Header>
+void deleter(BaseType* obj, bool isInline) noexcept
+{
+    if (isInline) {
         static_cast<T*>(obj)->~T();
+    } else {
+        heapDestroy<Header>(static_cast<T*>(obj));
     }
 }
 
 // CREATORS
-template <typename BaseType, std::size_t BufferSize>
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
 template <typename T, typename... Args>
-inline SmallBuffer<BaseType, BufferSize>::SmallBuffer(std::in_place_type_t<T>, 
-    Args&&... args)
-    : d_cloner(&cloner<BaseType, std::decay_t<T>>)
-    , d_mover(&mover<BaseType, std::decay_t<T>, false>)
-    , d_deleter(&deleter<BaseType, std::decay_t<T>, false>)
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    std::in_place_type_t<T>, Args&&... args)
+    : SmallBuffer(std::allocator_arg, nullptr, std::in_place_type<T>,
+                  std::forward<Args>(args)...)
+{}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <typename T, typename... Args>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    std::allocator_arg_t, std::pmr::memory_resource* resource,
+    std::in_place_type_t<T>, Args&&... args)
+    : d_lifecycle(&lifecycle<BaseType, std::decay_t<T>>)
 {
     using decayed_type = std::decay_t<T>;
     static_assert(std::is_base_of_v<BaseType, decayed_type>);
+    static_assert(HeapAllowed || holdsInline<decayed_type>(),
+        "The object does not fit in a buffer which never allocates, is "
+        "over-aligned, or may throw when moved");
+
+    setResource(resource);
+    if constexpr (holdsInline<decayed_type>()) {
+        setObject(new ((void*)storage()) decayed_type(
+            std::forward<Args>(args)...));
+    } else {
+        setObject(heapConstruct<decayed_type>(resource,
+            std::forward<Args>(args)...));
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <typename T>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    InPlaceStatic<T>) noexcept
+    : d_lifecycle(holdsInline<T>() ? &lifecycle<BaseType, T>
+                                   : &staticLifecycle<BaseType, T>)
+{
+    static_assert(std::is_base_of_v<BaseType, T>);
+    static_assert(std::is_empty_v<T> &&
+                  std::is_trivially_default_constructible_v<T>);
+
+    if constexpr (holdsInline<T>()) {
+        setObject(new ((void*)storage()) T());
+    } else {
+        static_assert(HeapAllowed,
+            "The object does not fit in a buffer which never allocates");
+        setObject(&staticObject<T>);
+    }
+}
 
-    std::byte* const storageAddress 
-        = reinterpret_cast<std::byte*>(std::addressof(d_storage));
-    std::byte* const address 
-        = nextAlignedAddress<decayed_type>(
-            reinterpret_cast<std::byte*>(storageAddress));
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    const SmallBuffer& rhs)
+    : d_lifecycle(rhs.d_lifecycle)
+{
+    if constexpr (HeapAllowed) {
+        if (!rhs.d_type) {
+            d_type = nullptr;
+            return;
+        }
+    }
+    statsCount(d_lifecycle->type, stats_counter::clone);
+    setResource(rhs.resource());
 
-    if (BufferSize - (address - storageAddress) < sizeof(T)) {
-        d_type = new decayed_type(std::forward<Args>(args)...);
-        d_mover = &mover<BaseType, decayed_type, true>;
-        d_deleter = &deleter<BaseType, decayed_type, true>;
+    if (rhs.isInline() && d_lifecycle->trivial) {
+        std::memcpy(storage(), rhs.storage(), BufferSize);
+        setObject(reinterpret_cast<BaseType*>(storage() +
+            (reinterpret_cast<std::byte*>(rhs.object()) - rhs.storage())));
         return;
     }
 
-    new ((void*)address) decayed_type(std::forward<Args>(args)...);
-    d_type = reinterpret_cast<BaseType*>(address);
+    setObject(d_lifecycle->clone(rhs.object(), rhs.resource(), storage(),
+        BufferSize));
 }
 
-template <typename BaseType, std::size_t BufferSize>
-inline SmallBuffer<BaseType, BufferSize>::SmallBuffer(const SmallBuffer& rhs)
-    : d_cloner(rhs.d_cloner)
-    , d_mover(rhs.d_mover)
-    , d_deleter(rhs.d_deleter)
-    , d_type(d_cloner(rhs.d_type,
-        reinterpret_cast<std::byte*>(std::addressof(d_storage)), BufferSize))
-{}
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <std::size_t OtherBufferSize, bool OtherHeapAllowed, typename>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    const SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>& rhs)
+    : d_lifecycle(rhs.d_lifecycle)
+{
+    statsCount(d_lifecycle->type, stats_counter::clone);
+    setResource(rhs.resource());
+    setObject(d_lifecycle->clone(rhs.object(), rhs.resource(), storage(),
+        BufferSize));
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    SmallBuffer&& rhs) noexcept
+{
+    moveFrom(rhs);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <std::size_t OtherBufferSize, bool OtherHeapAllowed, typename>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::SmallBuffer(
+    SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>&& rhs)
+{
+    moveFrom(rhs);
+}
 
-template <typename BaseType, std::size_t BufferSize>
-template <typename OtherBase, std::size_t OtherBufferSize, typename>
-inline SmallBuffer<BaseType, BufferSize>::SmallBuffer(
-    const SmallBuffer<OtherBase, OtherBufferSize>& rhs)
-    : d_cloner(rhs.d_cloner)
-    , d_mover(rhs.d_mover)
-    , d_deleter(rhs.d_deleter)
-    , d_type(d_cloner(rhs.d_type, 
-        reinterpret_cast<std::byte*>(std::addressof(d_storage)), BufferSize))
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>::~SmallBuffer()
 {
-    // TODO: need to set deleter appropriately
+    destroy();
 }
 
-template <typename BaseType, std::size_t BufferSize>
-inline SmallBuffer<BaseType, BufferSize>::SmallBuffer(SmallBuffer&& rhs)
-    : d_cloner(rhs.d_cloner)
-    , d_mover(rhs.d_mover)
-    , d_deleter(rhs.d_deleter)
-    , d_type(d_mover(rhs.d_type, 
-        reinterpret_cast<std::byte*>(std::addressof(d_storage)), BufferSize))
+// CLASS METHODS
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <typename T>
+inline constexpr bool SmallBuffer<BaseType, BufferSize, HeapAllowed>::
+    holdsInline() noexcept
 {
-    // TODO: Need to set deleter appropriately.
+    return fitsInline<T>(BufferSize);
 }
 
-template <typename BaseType, std::size_t BufferSize>
-template <typename OtherBase, std::size_t OtherBufferSize, typename>
-inline SmallBuffer<BaseType, BufferSize>::SmallBuffer(
-    SmallBuffer<OtherBase, OtherBufferSize>&& rhs)
-    : d_cloner(rhs.d_cloner)
-    , d_mover(rhs.d_mover)
-    , d_deleter(rhs.d_deleter)
-    , d_type(d_mover(rhs.d_type, 
-        reinterpret_cast<std::byte*>(std::addressof(d_storage)), BufferSize))
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline constexpr std::size_t SmallBuffer<BaseType, BufferSize, HeapAllowed>::
+    capacity() noexcept
 {
-    // TODO: Need to set deleter appropriately.
+    return BufferSize;
 }
 
-template <typename BaseType, std::size_t BufferSize>
-inline SmallBuffer<BaseType, BufferSize>::~SmallBuffer()
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <typename T>
+inline constexpr std::size_t SmallBuffer<BaseType, BufferSize, HeapAllowed>::
+    heapBytes() noexcept
 {
-    d_deleter(d_type);
+    return holdsInline<T>() ? 0 : heapSize<T>;
 }
 
 // ACCESSORS
-template <typename BaseType, std::size_t BufferSize>
-inline BaseType& SmallBuffer<BaseType, BufferSize>::operator*() const noexcept
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline BaseType& SmallBuffer<BaseType, BufferSize, HeapAllowed>::operator*()
+    const noexcept
 {
-    return *d_type;
+    return *object();
 }
 
-template <typename BaseType, std::size_t BufferSize>
-inline BaseType* SmallBuffer<BaseType, BufferSize>::operator->() const noexcept
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline BaseType* SmallBuffer<BaseType, BufferSize, HeapAllowed>::operator->()
+    const noexcept
 {
-    return d_type;
+    return object();
 }
 
 // MANIPULATORS
-template <typename BaseType, std::size_t BufferSize>
-inline void SmallBuffer<BaseType, BufferSize>::swap(SmallBuffer& other)
-{
-    auto tmp{std::move(*this)};
-    d_cloner = other.d_cloner;
-    d_mover = other.d_mover;
-    d_deleter = other.d_deleter;
-    d_type = d_mover(other.d_type, 
-        reinterpret_cast<std::byte*>(std::addressof(d_storage)), BufferSize);
-    
-    other.d_cloner = tmp.d_cloner;
-    other.d_mover = tmp.d_mover;
-    other.d_deleter = tmp.d_deleter;
-    other.d_type = other.d_mover(tmp.d_type,
-        reinterpret_cast<std::byte*>(std::addressof(other.d_storage)), 
-        BufferSize);
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>&
+    SmallBuffer<BaseType, BufferSize, HeapAllowed>::operator=(
+        const SmallBuffer& rhs)
+{
+    SmallBuffer tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline SmallBuffer<BaseType, BufferSize, HeapAllowed>&
+    SmallBuffer<BaseType, BufferSize, HeapAllowed>::operator=(
+        SmallBuffer&& rhs) noexcept
+{
+    if (this != &rhs) {
+        destroy();
+        moveFrom(rhs);
+    }
+    return *this;
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline void SmallBuffer<BaseType, BufferSize, HeapAllowed>::swap(
+    SmallBuffer& other) noexcept
+{
+    if constexpr (HeapAllowed) {
+        if (!isInline() && !other.isInline()) {
+            std::swap(d_lifecycle, other.d_lifecycle);
+            std::swap(d_type, other.d_type);
+            std::swap(d_resource, other.d_resource);
+            return;
+        }
+    }
+
+    SmallBuffer tmp(std::move(*this));
+    destroy();
+    moveFrom(other);
+    other.destroy();
+    other.moveFrom(tmp);
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline BaseType& SmallBuffer<BaseType, BufferSize, HeapAllowed>::unshare()
+    noexcept
+{
+    return *object();
 }
+
+// PRIVATE ACCESSORS
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline BaseType* SmallBuffer<BaseType, BufferSize, HeapAllowed>::object()
+    const noexcept
+{
+    if constexpr (HeapAllowed) {
+        return d_type;
+    } else {
+        return std::launder(reinterpret_cast<BaseType*>(storage()));
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline bool SmallBuffer<BaseType, BufferSize, HeapAllowed>::isInline()
+    const noexcept
+{
+    if constexpr (!HeapAllowed) {
+        return true;
+    } else if constexpr (BufferSize == 0) {
+        return false;
+    } else {
+        const std::uintptr_t object = reinterpret_cast<std::uintptr_t>(d_type);
+        const std::uintptr_t first
+            = reinterpret_cast<std::uintptr_t>(storage());
+        return object >= first && object < first + BufferSize;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline std::pmr::memory_resource*
+    SmallBuffer<BaseType, BufferSize, HeapAllowed>::resource() const noexcept
+{
+    if constexpr (HeapAllowed) {
+        if (d_type && !isInline()) {
+            return d_lifecycle->resource(d_type);
+        }
+    }
+    if constexpr (std::is_same_v<ResourcePointer,
+                                 std::pmr::memory_resource*>) {
+        return d_resource;
+    } else {
+        return nullptr;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline std::byte* SmallBuffer<BaseType, BufferSize, HeapAllowed>::storage()
+    const noexcept
+{
+    return reinterpret_cast<std::byte*>(
+        const_cast<BufferType*>(std::addressof(d_storage)));
+}
+
+// PRIVATE MANIPULATORS
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline void SmallBuffer<BaseType, BufferSize, HeapAllowed>::setObject(
+    BaseType* object) noexcept
+{
+    if constexpr (HeapAllowed) {
+        d_type = object;
+    } else {
+        // Without a stored pointer the object is found at the start of the
+        // storage, so the base must be its first subobject.
+        assert(static_cast<void*>(object) == storage());
+        (void)object;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline void SmallBuffer<BaseType, BufferSize, HeapAllowed>::setResource(
+    std::pmr::memory_resource* resource) noexcept
+{
+    if constexpr (std::is_same_v<ResourcePointer,
+                                 std::pmr::memory_resource*>) {
+        d_resource = resource;
+    } else {
+        (void)resource;
+    }
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+template <std::size_t OtherBufferSize, bool OtherHeapAllowed>
+inline void SmallBuffer<BaseType, BufferSize, HeapAllowed>::moveFrom(
+    SmallBuffer<BaseType, OtherBufferSize, OtherHeapAllowed>& rhs)
+{
+    d_lifecycle = rhs.d_lifecycle;
+    statsCount(d_lifecycle->type, stats_counter::move);
+    std::pmr::memory_resource* const resource = rhs.resource();
+    setResource(resource);
+
+    if constexpr (HeapAllowed && OtherHeapAllowed) {
+        if (!rhs.isInline()) {
+            d_type = std::exchange(rhs.d_type, nullptr);
+            return;
+        }
+    }
+
+    if constexpr (OtherBufferSize == BufferSize) {
+        if (d_lifecycle->trivial) {
+            std::memcpy(storage(), rhs.storage(), BufferSize);
+            setObject(reinterpret_cast<BaseType*>(storage() +
+                (reinterpret_cast<std::byte*>(rhs.object()) - rhs.storage())));
+            return;
+        }
+    }
+
+    setObject(d_lifecycle->move(rhs.object(), resource, storage(),
+        BufferSize));
+}
+
+template <typename BaseType, std::size_t BufferSize, bool HeapAllowed>
+inline void SmallBuffer<BaseType, BufferSize, HeapAllowed>::destroy() noexcept
+{
+    if constexpr (HeapAllowed) {
+        if (!d_type) {
+            return;
+        }
+    }
+
+    const bool isInlineObject = isInline();
+    if (!isInlineObject || !d_lifecycle->trivial) {
+        d_lifecycle->destroy(object(), isInlineObject);
+    }
+}
+
 } // close namespace sample::detail
 
 #endif // SAMPLE_SMALLBUFFER_HPP
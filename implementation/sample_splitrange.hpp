@@ -0,0 +1,202 @@
+#ifndef SAMPLE_SPLITRANGE
+#define SAMPLE_SPLITRANGE
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sample {
+
+template <typename Iterator>
+class split_range {
+    // A `split_range` is a piece of a larger sized range, given by a pair of
+    // iterators into it, the number of elements between them and the offset
+    // of the first of them from the beginning of the larger range.  Pieces
+    // are produced by `split`, which steps iterators but never copies
+    // elements, and may be split again.
+
+public:
+    // TYPES
+    using iterator = Iterator;
+    using size_type = std::size_t;
+
+    // CREATORS
+    split_range(Iterator first, Iterator last);
+        // Construct a `split_range` over `[first, last)`, at offset zero.
+        // The behaviour is undefined unless `Iterator` is a random access
+        // iterator.
+
+    split_range(Iterator first, Iterator last, size_type size,
+                size_type offset = 0);
+        // Construct a `split_range` over the `size` elements of `[first,
+        // last)`, at `offset` in a larger range.
+
+    // ACCESSORS
+    const Iterator& begin() const noexcept;
+        // Returns an iterator to the first element of the range.
+
+    const Iterator& end() const noexcept;
+        // Returns an iterator past the last element of the range.
+
+    size_type size() const noexcept;
+        // Returns the number of elements in the range.
+
+    bool empty() const noexcept;
+        // Returns whether the range has no elements.
+
+    size_type offset() const noexcept;
+        // Returns the position of the first element in the range split.
+
+private:
+    // DATA
+    size_type d_size;
+    size_type d_offset;  // of `d_first` in the range split
+    Iterator  d_first;
+    Iterator  d_last;
+};
+
+template <typename Range>
+std::vector<split_range<typename Range::iterator>>
+split(const Range& range, std::size_t parts);
+    // Returns `parts` consecutive `split_range`s over the elements of
+    // `range`, each of whose sizes differ by at most one, some empty if
+    // `range` has fewer than `parts` elements.  The boundaries are found by
+    // advancing an iterator, in constant time per part if the iterators of
+    // `range` are random access, and otherwise by stepping through the
+    // range once.
+    //
+    // `Range` is a `split_range`, or an `any_range` whose size is known in
+    // constant time, as is any `any_range` over random access iterators,
+    // or a sized `any_range` over forward iterators.  The behaviour is
+    // undefined if `range` is an `any_range` that is not sized, or if
+    // `parts` is zero.
+
+template <typename Iterator>
+std::pair<split_range<Iterator>, split_range<Iterator>>
+bisect(const split_range<Iterator>& range);
+    // Returns the first and second halves of `range`, the first holding the
+    // middle element if it has an odd number of elements, as if by
+    // `split(range, 2)` but without allocating.
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+template <typename Iterator>
+inline split_range<Iterator>::split_range(Iterator first, Iterator last)
+    : d_size(static_cast<size_type>(last - first))
+    , d_offset(0)
+    , d_first(std::move(first))
+    , d_last(std::move(last))
+{}
+
+template <typename Iterator>
+inline split_range<Iterator>::split_range(Iterator first, Iterator last,
+                                          size_type size, size_type offset)
+    : d_size(size)
+    , d_offset(offset)
+    , d_first(std::move(first))
+    , d_last(std::move(last))
+{}
+
+// ACCESSORS
+template <typename Iterator>
+inline const Iterator& split_range<Iterator>::begin() const noexcept
+{
+    return d_first;
+}
+
+template <typename Iterator>
+inline const Iterator& split_range<Iterator>::end() const noexcept
+{
+    return d_last;
+}
+
+template <typename Iterator>
+inline typename split_range<Iterator>::size_type
+split_range<Iterator>::size() const noexcept
+{
+    return d_size;
+}
+
+template <typename Iterator>
+inline bool split_range<Iterator>::empty() const noexcept
+{
+    return d_size == 0;
+}
+
+template <typename Iterator>
+inline typename split_range<Iterator>::size_type
+split_range<Iterator>::offset() const noexcept
+{
+    return d_offset;
+}
+
+// FREE FUNCTIONS
+template <typename Range>
+inline std::vector<split_range<typename Range::iterator>>
+split(const Range& range, std::size_t parts)
+{
+    using Iterator = typename Range::iterator;
+    using Difference =
+        typename std::iterator_traits<Iterator>::difference_type;
+    constexpr bool isRandomAccess = std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterator>::iterator_category>;
+
+    std::size_t offset = 0;
+    if constexpr (std::is_same_v<Range, split_range<Iterator>>) {
+        offset = range.offset();
+    }
+
+    const std::size_t size = range.size();
+    const std::size_t quotient = size / parts;
+    const std::size_t remainder = size % parts;
+
+    std::vector<split_range<Iterator>> result;
+    result.reserve(parts);
+    const Iterator first = range.begin();
+    Iterator cursor = first;
+    std::size_t position = 0;
+    for (std::size_t part = 0; part != parts; ++part) {
+        const std::size_t count = quotient + (part < remainder ? 1 : 0);
+        Iterator next = cursor;
+        if constexpr (isRandomAccess) {
+            next = first + static_cast<Difference>(position + count);
+        } else if (part + 1 == parts) {
+            if constexpr (std::is_same_v<Range, split_range<Iterator>>) {
+                next = range.end();
+            } else {
+                next = range.last();
+            }
+        } else {
+            std::advance(next, static_cast<Difference>(count));
+        }
+        result.emplace_back(cursor, next, count, offset + position);
+        cursor = std::move(next);
+        position += count;
+    }
+    return result;
+}
+
+template <typename Iterator>
+inline std::pair<split_range<Iterator>, split_range<Iterator>>
+bisect(const split_range<Iterator>& range)
+{
+    using Difference =
+        typename std::iterator_traits<Iterator>::difference_type;
+
+    const std::size_t count = range.size() - range.size() / 2;
+    Iterator middle = std::next(range.begin(), static_cast<Difference>(count));
+    return {
+        split_range<Iterator>(range.begin(), middle, count, range.offset()),
+        split_range<Iterator>(middle, range.end(), range.size() - count,
+                              range.offset() + count)
+    };
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_SPLITRANGE
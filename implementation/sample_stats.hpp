@@ -0,0 +1,560 @@
+#ifndef SAMPLE_STATS
+#define SAMPLE_STATS
+
+#include <sample_typetoken.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sample {
+
+enum class stats_counter {
+    // The events counted for each type held by an `any_iterator` when
+    // `SAMPLE_ANYITERATOR_STATS` is defined.  The first are the operations
+    // dispatched to the underlying iterator through its table of
+    // operations, which excludes those performed inline on contiguous
+    // iterators held as a raw pointer.
+
+    dereference,  // `*it`
+    arrow,        // `it->`
+    subscript,    // `it[n]`
+    equal,        // `==` and `!=`, including with an `any_sentinel`
+    compare,      // `<`, `>`, `<=` and `>=`
+    distance,     // `it - other`
+    increment,    // `++it`, and `it++`
+    decrement,    // `--it`, and `it--`
+    advance,      // `+=`, `-=`, and `+` and `-` with an offset
+    assign,       // `*it = value` on an output iterator
+    write,        // `write_n`
+    reserve,      // `reserve_hint`
+    read,         // `read`
+    for_each,     // `for_each_until`
+
+    clone,        // a copy of the erased iterator, however it is stored
+    move,         // a move of the erased iterator, however it is stored
+    spill,        // an allocation holding the iterator on the heap
+    heap_bytes    // the bytes of those allocations
+};
+
+namespace detail {
+
+constexpr std::size_t STATS_COUNTER_COUNT =
+    static_cast<std::size_t>(stats_counter::heap_bytes) + 1;
+    // The number of enumerators of `stats_counter`.
+
+constexpr stats_counter LAST_DISPATCH_COUNTER = stats_counter::for_each;
+    // The last of the `stats_counter`s counting dispatches.
+
+#ifdef SAMPLE_ANYITERATOR_STATS
+constexpr bool STATS_ENABLED = true;
+#else
+constexpr bool STATS_ENABLED = false;
+#endif
+
+} // close namespace detail
+
+inline constexpr bool stats_enabled = detail::STATS_ENABLED;
+    // Whether `SAMPLE_ANYITERATOR_STATS` is defined, and so whether any
+    // events are counted.  The macro must be defined alike in every
+    // translation unit of a program.
+
+std::string_view to_string(stats_counter counter) noexcept;
+    // Returns the name of `counter`, as spelled by its enumerator.
+
+class type_stats {
+    // The counts of the events of one type held by `any_iterator`s, summed
+    // over all threads.
+
+public:
+    // CREATORS
+    explicit type_stats(type_token type) noexcept;
+        // Construct the statistics of `type`, with every count zero.
+
+    // MANIPULATORS
+    void add(stats_counter counter, std::uint64_t count) noexcept;
+        // Add `count` to the count of `counter`.
+
+    // ACCESSORS
+    type_token type() const noexcept;
+        // Returns the type counted, which is that of the underlying
+        // iterator.
+
+    std::uint64_t operator[](stats_counter counter) const noexcept;
+        // Returns the count of `counter`.
+
+    std::uint64_t dispatches() const noexcept;
+        // Returns the sum of the counts of the dispatched operations.
+
+private:
+    // DATA
+    type_token                                              d_type;
+    std::array<std::uint64_t, detail::STATS_COUNTER_COUNT>  d_counts{};
+};
+
+class stats_snapshot {
+    // A `stats_snapshot` holds the counts of the events of each type held
+    // by `any_iterator`s, taken from every thread by `sample::stats`, in the
+    // order of the names of the types.  Events that happen while the
+    // snapshot is taken may or may not be included.
+
+public:
+    // CREATORS
+    stats_snapshot() = default;
+        // Construct a snapshot with no types.
+
+    explicit stats_snapshot(std::vector<type_stats> types);
+        // Construct a snapshot of `types`, ordering them by name.
+
+    // ACCESSORS
+    const std::vector<type_stats>& types() const noexcept;
+        // Returns the statistics of each type with any events counted.
+
+    const type_stats *find(type_token type) const noexcept;
+        // Returns the statistics of `type`, or the null pointer if it has
+        // no events counted.
+
+    std::uint64_t total(stats_counter counter) const noexcept;
+        // Returns the sum of the counts of `counter` over every type.
+
+    void print(std::ostream& stream) const;
+        // Write a line to `stream` for each type, giving its name and the
+        // counters with non-zero counts as `name=count`.
+
+    void print_json(std::ostream& stream) const;
+        // Write the snapshot to `stream` as a JSON object, with a member
+        // `types` holding an array of objects, each with the `type` name
+        // and an object of the non-zero `counts` by counter name.
+
+private:
+    // DATA
+    std::vector<type_stats> d_types;
+};
+
+stats_snapshot stats();
+    // Returns the counts of the events of every type, from every thread,
+    // including those that have exited.  The snapshot is empty unless
+    // `stats_enabled` is `true`.
+
+namespace detail {
+
+struct StatsCounters {
+    // This class holds the counts of the events of one type on one thread.
+    // Only that thread writes them, so incrementing needs no atomic
+    // read-modify-write, but they are atomic so that other threads may read
+    // them while taking a snapshot.
+
+    // CREATORS
+    explicit StatsCounters(type_token type) noexcept : d_type(type) {}
+        // Construct the counters of `type`, with every count zero.
+
+    // DATA
+    type_token                                                  d_type;
+    std::array<std::atomic<std::uint64_t>, STATS_COUNTER_COUNT> d_counts{};
+};
+
+class StatsThread {
+    // This class holds the counters of the calling thread, in a
+    // thread-local instance registered with the `StatsRegistry` for the
+    // lifetime of the thread.
+
+public:
+    // CLASS METHODS
+    static StatsThread& current();
+        // Returns the counters of the calling thread, registering them on
+        // first use.
+
+    // CREATORS
+    StatsThread();
+    StatsThread(const StatsThread&) = delete;
+    ~StatsThread();
+        // Fold the counts into those of the exited threads.
+
+    // MANIPULATORS
+    StatsThread& operator=(const StatsThread&) = delete;
+
+    StatsCounters& countersOf(type_token type);
+        // Returns the counters of `type`, creating them if needed.  May
+        // only be called by the owning thread.
+
+    // ACCESSORS
+    template <typename Visitor>
+    void visit(Visitor&& visitor) const;
+        // Invoke `visitor` with each `StatsCounters` of this thread.
+
+private:
+    // DATA
+    mutable std::mutex                                    d_mutex;
+        // guards the addition of elements to `d_counters`
+    std::vector<std::unique_ptr<StatsCounters>>           d_counters;
+    std::unordered_map<type_token, StatsCounters*>        d_index;
+        // only used by the owning thread
+    StatsCounters                                        *d_last = nullptr;
+        // the counters found last, as consecutive events are usually of
+        // the same type
+};
+
+class StatsRegistry {
+    // This class tracks the `StatsThread` of every running thread, and the
+    // counts of the threads that have exited.
+
+public:
+    // CLASS METHODS
+    static StatsRegistry& instance();
+        // Returns the registry of the program.
+
+    // MANIPULATORS
+    void add(StatsThread& thread);
+        // Register `thread`.
+
+    void remove(StatsThread& thread);
+        // Unregister `thread`, keeping its counts.
+
+    // ACCESSORS
+    stats_snapshot snapshot() const;
+        // Returns the counts of the running and exited threads.
+
+private:
+    // PRIVATE CLASS METHODS
+    static void fold(std::unordered_map<type_token, type_stats>& totals,
+                     const StatsThread& thread);
+        // Add the counts of `thread` to `totals`, reading each with a
+        // relaxed load.
+
+private:
+    // DATA
+    mutable std::mutex                          d_mutex;
+    std::vector<StatsThread*>                   d_threads;
+    std::unordered_map<type_token, type_stats>  d_exited;
+};
+
+template <typename T, typename = void>
+struct stats_type {
+    // Metafunction yielding the token under which the events of a `T` held
+    // in a `SmallBuffer` are counted, which is that of the underlying
+    // iterator for the implementations held by `any_iterator`, and that of
+    // `T` itself otherwise.
+
+    static constexpr type_token value = type_token::of<T>();
+};
+
+template <typename T>
+struct stats_type<T, std::void_t<decltype(T::vtable.type)>> {
+    static constexpr type_token value = T::vtable.type;
+};
+
+void statsCount(type_token type, stats_counter counter,
+                std::uint64_t count = 1);
+    // Add `count` to the count of `counter` for `type` on the calling
+    // thread if `STATS_ENABLED` is `true`, and do nothing otherwise.
+
+void printJsonString(std::ostream& stream, std::string_view text);
+    // Write `text` to `stream` as a JSON string.
+
+} // close namespace detail
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+// StatsThread
+inline StatsThread& StatsThread::current()
+{
+    thread_local StatsThread thread;
+    return thread;
+}
+
+inline StatsThread::StatsThread()
+{
+    StatsRegistry::instance().add(*this);
+}
+
+inline StatsThread::~StatsThread()
+{
+    StatsRegistry::instance().remove(*this);
+}
+
+inline StatsCounters& StatsThread::countersOf(type_token type)
+{
+    if (d_last && d_last->d_type == type) {
+        return *d_last;
+    }
+
+    StatsCounters*& counters = d_index[type];
+    if (!counters) {
+        auto created = std::make_unique<StatsCounters>(type);
+        counters = created.get();
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        d_counters.push_back(std::move(created));
+    }
+    d_last = counters;
+    return *counters;
+}
+
+template <typename Visitor>
+inline void StatsThread::visit(Visitor&& visitor) const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    for (const std::unique_ptr<StatsCounters>& counters : d_counters) {
+        visitor(*counters);
+    }
+}
+
+// StatsRegistry
+inline StatsRegistry& StatsRegistry::instance()
+{
+    static StatsRegistry registry;
+    return registry;
+}
+
+inline void StatsRegistry::add(StatsThread& thread)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    d_threads.push_back(&thread);
+}
+
+inline void StatsRegistry::remove(StatsThread& thread)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    fold(d_exited, thread);
+    d_threads.erase(std::find(d_threads.begin(), d_threads.end(), &thread));
+}
+
+inline stats_snapshot StatsRegistry::snapshot() const
+{
+    std::unordered_map<type_token, type_stats> totals;
+    {
+        const std::lock_guard<std::mutex> lock(d_mutex);
+        totals = d_exited;
+        for (const StatsThread *thread : d_threads) {
+            fold(totals, *thread);
+        }
+    }
+
+    std::vector<type_stats> types;
+    types.reserve(totals.size());
+    for (const auto& entry : totals) {
+        types.push_back(entry.second);
+    }
+    return stats_snapshot(std::move(types));
+}
+
+inline void StatsRegistry::fold(
+    std::unordered_map<type_token, type_stats>& totals,
+    const StatsThread&                          thread)
+{
+    thread.visit([&totals](const StatsCounters& counters) {
+        type_stats& total = totals.try_emplace(counters.d_type,
+                                               counters.d_type).first->second;
+        for (std::size_t i = 0; i != STATS_COUNTER_COUNT; ++i) {
+            total.add(static_cast<stats_counter>(i),
+                      counters.d_counts[i].load(std::memory_order_relaxed));
+        }
+    });
+}
+
+// FREE FUNCTIONS
+inline void statsCount(type_token type, stats_counter counter,
+                       std::uint64_t count)
+{
+    if constexpr (STATS_ENABLED) {
+        std::atomic<std::uint64_t>& value = StatsThread::current()
+            .countersOf(type).d_counts[static_cast<std::size_t>(counter)];
+        value.store(value.load(std::memory_order_relaxed) + count,
+                    std::memory_order_relaxed);
+    } else {
+        (void)type;
+        (void)counter;
+        (void)count;
+    }
+}
+
+inline void printJsonString(std::ostream& stream, std::string_view text)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+    stream << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            stream << "\\u00" << HEX[(c >> 4) & 0xf] << HEX[c & 0xf];
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+} // close namespace detail
+
+// FREE FUNCTIONS
+inline std::string_view to_string(stats_counter counter) noexcept
+{
+    switch (counter) {
+      case stats_counter::dereference:
+        return "dereference";
+      case stats_counter::arrow:
+        return "arrow";
+      case stats_counter::subscript:
+        return "subscript";
+      case stats_counter::equal:
+        return "equal";
+      case stats_counter::compare:
+        return "compare";
+      case stats_counter::distance:
+        return "distance";
+      case stats_counter::increment:
+        return "increment";
+      case stats_counter::decrement:
+        return "decrement";
+      case stats_counter::advance:
+        return "advance";
+      case stats_counter::assign:
+        return "assign";
+      case stats_counter::write:
+        return "write";
+      case stats_counter::reserve:
+        return "reserve";
+      case stats_counter::read:
+        return "read";
+      case stats_counter::for_each:
+        return "for_each";
+      case stats_counter::clone:
+        return "clone";
+      case stats_counter::move:
+        return "move";
+      case stats_counter::spill:
+        return "spill";
+      case stats_counter::heap_bytes:
+        return "heap_bytes";
+    }
+    return "unknown";
+}
+
+inline stats_snapshot stats()
+{
+    if constexpr (stats_enabled) {
+        return detail::StatsRegistry::instance().snapshot();
+    } else {
+        return stats_snapshot();
+    }
+}
+
+// type_stats
+inline type_stats::type_stats(type_token type) noexcept
+    : d_type(type)
+{}
+
+inline void type_stats::add(stats_counter counter, std::uint64_t count)
+    noexcept
+{
+    d_counts[static_cast<std::size_t>(counter)] += count;
+}
+
+inline type_token type_stats::type() const noexcept
+{
+    return d_type;
+}
+
+inline std::uint64_t type_stats::operator[](stats_counter counter) const
+    noexcept
+{
+    return d_counts[static_cast<std::size_t>(counter)];
+}
+
+inline std::uint64_t type_stats::dispatches() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0;
+         i <= static_cast<std::size_t>(detail::LAST_DISPATCH_COUNTER); ++i) {
+        sum += d_counts[i];
+    }
+    return sum;
+}
+
+// stats_snapshot
+inline stats_snapshot::stats_snapshot(std::vector<type_stats> types)
+    : d_types(std::move(types))
+{
+    std::sort(d_types.begin(), d_types.end(),
+        [](const type_stats& lhs, const type_stats& rhs) {
+            return lhs.type().name() < rhs.type().name();
+        });
+}
+
+inline const std::vector<type_stats>& stats_snapshot::types() const noexcept
+{
+    return d_types;
+}
+
+inline const type_stats *stats_snapshot::find(type_token type) const noexcept
+{
+    for (const type_stats& entry : d_types) {
+        if (entry.type() == type) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+inline std::uint64_t stats_snapshot::total(stats_counter counter) const
+    noexcept
+{
+    std::uint64_t sum = 0;
+    for (const type_stats& entry : d_types) {
+        sum += entry[counter];
+    }
+    return sum;
+}
+
+inline void stats_snapshot::print(std::ostream& stream) const
+{
+    for (const type_stats& entry : d_types) {
+        stream << entry.type().name() << ':';
+        for (std::size_t i = 0; i != detail::STATS_COUNTER_COUNT; ++i) {
+            const stats_counter counter = static_cast<stats_counter>(i);
+            if (entry[counter] != 0) {
+                stream << ' ' << to_string(counter) << '=' << entry[counter];
+            }
+        }
+        stream << '\n';
+    }
+}
+
+inline void stats_snapshot::print_json(std::ostream& stream) const
+{
+    stream << "{\"types\": [";
+    const char *separator = "";
+    for (const type_stats& entry : d_types) {
+        stream << separator << "\n  {\"type\": ";
+        detail::printJsonString(stream, entry.type().name());
+        stream << ", \"counts\": {";
+        const char *countSeparator = "";
+        for (std::size_t i = 0; i != detail::STATS_COUNTER_COUNT; ++i) {
+            const stats_counter counter = static_cast<stats_counter>(i);
+            if (entry[counter] != 0) {
+                stream << countSeparator << '"' << to_string(counter)
+                       << "\": " << entry[counter];
+                countSeparator = ", ";
+            }
+        }
+        stream << "}}";
+        separator = ",";
+    }
+    stream << (d_types.empty() ? "]}\n" : "\n]}\n");
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_STATS
@@ -0,0 +1,98 @@
+#ifndef SAMPLE_STORAGEPOLICY
+#define SAMPLE_STORAGEPOLICY
+
+#include <sample_sharedbuffer.hpp>
+#include <sample_smallbuffer.hpp>
+
+#include <cstddef>
+
+namespace sample {
+
+template <std::size_t BufferSize>
+struct sbo_storage {};
+    // Storage policy holding the underlying iterator within `BufferSize`
+    // bytes inside the `any_iterator` when it fits, and on the heap
+    // otherwise.
+
+template <std::size_t BufferSize>
+struct inline_storage {};
+    // Storage policy always holding the underlying iterator within
+    // `BufferSize` bytes inside the `any_iterator`.  Constructing such an
+    // `any_iterator` from an iterator that does not fit, or whose alignment
+    // exceeds that of a pointer, is ill-formed.  Suited to pointer-sized
+    // iterators, for which `inline_storage<sizeof(void*)>` gives a handle of
+    // three pointers.
+
+struct heap_storage {};
+    // Storage policy always holding the underlying iterator on the heap,
+    // giving a handle of three pointers regardless of the size of the
+    // underlying iterator.
+
+template <std::size_t BufferSize = detail::DEFAULT_BUFFER_SIZE,
+          bool ThreadSafe = true>
+struct shared_storage {};
+    // Storage policy holding the underlying iterator within `BufferSize`
+    // bytes inside the `any_iterator` when it fits, as `sbo_storage` does,
+    // and otherwise on the heap, shared by the copies of the `any_iterator`
+    // until one of them is modified.  Copying then costs an increment of
+    // the count of copies sharing the iterator, which is atomic unless
+    // `ThreadSafe` is `false`, and the underlying iterator is copied only by
+    // the first operation modifying it in a copy, such as `++`, `--`, `+=`
+    // or a call to the non-`const` `target`.  Suited to large forward
+    // iterators passed to algorithms which copy them freely, such as
+    // `std::search` or `std::lower_bound`.  The other operations, `*`
+    // among them, must leave the underlying iterator unchanged, as they do
+    // for forward iterators.  Such an `any_iterator` converts only from
+    // those under the same policy.
+
+using default_storage = sbo_storage<detail::DEFAULT_BUFFER_SIZE>;
+
+namespace detail {
+
+template <typename BaseType, typename StoragePolicy>
+struct storage_buffer;
+    // Metafunction yielding the `SmallBuffer` which implements
+    // `StoragePolicy` for objects derived from `BaseType`.
+
+template <typename BaseType, std::size_t BufferSize>
+struct storage_buffer<BaseType, sbo_storage<BufferSize>> {
+    using type = SmallBuffer<BaseType, BufferSize, true>;
+};
+
+template <typename BaseType, std::size_t BufferSize>
+struct storage_buffer<BaseType, inline_storage<BufferSize>> {
+    using type = SmallBuffer<BaseType, BufferSize, false>;
+};
+
+template <typename BaseType>
+struct storage_buffer<BaseType, heap_storage> {
+    using type = SmallBuffer<BaseType, 0, true>;
+};
+
+template <typename BaseType, std::size_t BufferSize, bool ThreadSafe>
+struct storage_buffer<BaseType, shared_storage<BufferSize, ThreadSafe>> {
+    using type = SharedBuffer<BaseType, BufferSize, ThreadSafe>;
+};
+
+template <typename BaseType, typename StoragePolicy>
+using storage_buffer_t = typename storage_buffer<BaseType,
+    StoragePolicy>::type;
+
+struct StorageProbe;
+    // An arbitrary base type with which to compare storage policies.
+
+template <typename FromPolicy, typename ToPolicy>
+struct is_storage_convertible : is_buffer_convertible<
+    storage_buffer_t<StorageProbe, FromPolicy>,
+    storage_buffer_t<StorageProbe, ToPolicy>> {};
+    // Trait detecting whether every iterator held under `FromPolicy` can
+    // also be held under `ToPolicy`.
+
+template <typename FromPolicy, typename ToPolicy>
+constexpr bool is_storage_convertible_v =
+    is_storage_convertible<FromPolicy, ToPolicy>::value;
+
+} // close namespace detail
+} // close namespace sample
+
+#endif // SAMPLE_STORAGEPOLICY
@@ -0,0 +1,247 @@
+#ifndef SAMPLE_THREADPOOL
+#define SAMPLE_THREADPOOL
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sample {
+
+class thread_pool {
+    // A `thread_pool` runs fork-join jobs, each calling a function for every
+    // index in a range, on a fixed set of worker threads together with the
+    // thread starting the job, which returns once every call has returned.
+    //
+    // A pool runs one job at a time; jobs started concurrently from several
+    // threads are run one after the other.  A job started from within a job
+    // of the same pool, on one of its workers or on the thread that started
+    // the outer job, is run entirely on the calling thread, so that nested
+    // parallel algorithms cannot deadlock.
+
+public:
+    // CREATORS
+    explicit thread_pool(std::size_t workers = defaultWorkerCount());
+        // Construct a `thread_pool` with `workers` worker threads, which may
+        // be zero, in which case jobs run on the thread starting them.
+
+    thread_pool(const thread_pool&) = delete;
+
+    ~thread_pool();
+        // Stop and join the worker threads.  The behaviour is undefined if a
+        // job is running.
+
+    // MANIPULATORS
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    template <typename Function>
+    void run(std::size_t tasks, Function&& function);
+        // Call `function(i)` for each `i` in `[0, tasks)`, on the workers and
+        // the calling thread, and return once every call has returned.  If
+        // any call exits with an exception, the remaining indices are not
+        // started and one of the exceptions is rethrown.
+
+    // ACCESSORS
+    std::size_t concurrency() const noexcept;
+        // Returns the number of threads running a job, the workers and the
+        // thread starting it.
+
+    // CLASS METHODS
+    static thread_pool& instance();
+        // Returns a pool shared by the process, with a worker for each
+        // hardware thread but the calling one, created on first use.
+
+    static std::size_t defaultWorkerCount() noexcept;
+        // Returns the number of hardware threads less one, or zero if it is
+        // not known.
+
+private:
+    // PRIVATE TYPES
+    struct Job {
+        // DATA
+        void                   (*d_call)(void* function, std::size_t index);
+        void                    *d_function;
+        std::size_t              d_tasks;
+        std::atomic<std::size_t> d_next{0};     // next index to claim
+        std::mutex               d_errorMutex;
+        std::exception_ptr       d_error;
+    };
+
+    // PRIVATE CLASS METHODS
+    template <typename Function>
+    static void call(void* function, std::size_t index);
+        // Call the `Function` at `function` with `index`.
+
+    static void work(Job& job);
+        // Claim and run indices of `job` until none remain, recording the
+        // first exception thrown and then claiming all remaining indices.
+
+    static const thread_pool*& currentPool() noexcept;
+        // Returns a reference to the pool whose job the calling thread is
+        // running, or the null pointer.
+
+    // PRIVATE MANIPULATORS
+    void workerLoop();
+        // Run the jobs of this pool on a worker thread until it is stopped.
+
+private:
+    // DATA
+    std::mutex               d_runMutex;   // serialises concurrent jobs
+    std::mutex               d_mutex;      // guards the members below
+    std::condition_variable  d_wake;       // a job started or a stop
+    std::condition_variable  d_idle;       // a worker left a job
+    Job                     *d_job = nullptr;
+    std::size_t              d_generation = 0;  // jobs started
+    std::size_t              d_active = 0;  // workers inside `*d_job`
+    bool                     d_stop = false;
+    std::vector<std::thread> d_workers;
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+// CREATORS
+inline thread_pool::thread_pool(std::size_t workers)
+{
+    d_workers.reserve(workers);
+    for (std::size_t i = 0; i != workers; ++i) {
+        d_workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+inline thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_wake.notify_all();
+    for (std::thread& worker : d_workers) {
+        worker.join();
+    }
+}
+
+// MANIPULATORS
+template <typename Function>
+inline void thread_pool::run(std::size_t tasks, Function&& function)
+{
+    using Callable = std::remove_reference_t<Function>;
+
+    Job job;
+    job.d_call = &call<Callable>;
+    job.d_function = const_cast<void*>(
+        static_cast<const volatile void*>(std::addressof(function)));
+    job.d_tasks = tasks;
+
+    if (tasks <= 1 || d_workers.empty() || currentPool() == this) {
+        work(job);
+    } else {
+        std::lock_guard<std::mutex> runLock(d_runMutex);
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_job = &job;
+            ++d_generation;
+        }
+        d_wake.notify_all();
+
+        const thread_pool* const outer = currentPool();
+        currentPool() = this;
+        work(job);
+        currentPool() = outer;
+
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_job = nullptr;
+        d_idle.wait(lock, [this] { return d_active == 0; });
+    }
+
+    if (job.d_error) {
+        std::rethrow_exception(job.d_error);
+    }
+}
+
+inline void thread_pool::workerLoop()
+{
+    currentPool() = this;
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock(d_mutex);
+    for (;;) {
+        d_wake.wait(lock, [&] {
+            return d_stop || (d_job && d_generation != seen);
+        });
+        if (d_stop) {
+            return;
+        }
+        seen = d_generation;
+        Job& job = *d_job;
+        ++d_active;
+        lock.unlock();
+
+        work(job);
+
+        lock.lock();
+        if (--d_active == 0) {
+            d_idle.notify_all();
+        }
+    }
+}
+
+// ACCESSORS
+inline std::size_t thread_pool::concurrency() const noexcept
+{
+    return d_workers.size() + 1;
+}
+
+// CLASS METHODS
+template <typename Function>
+inline void thread_pool::call(void* function, std::size_t index)
+{
+    (*static_cast<Function*>(function))(index);
+}
+
+inline void thread_pool::work(Job& job)
+{
+    for (;;) {
+        const std::size_t index =
+            job.d_next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= job.d_tasks) {
+            return;
+        }
+        try {
+            job.d_call(job.d_function, index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.d_errorMutex);
+            if (!job.d_error) {
+                job.d_error = std::current_exception();
+            }
+            job.d_next.store(job.d_tasks, std::memory_order_relaxed);
+        }
+    }
+}
+
+inline const thread_pool*& thread_pool::currentPool() noexcept
+{
+    static thread_local const thread_pool* pool = nullptr;
+    return pool;
+}
+
+inline thread_pool& thread_pool::instance()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+inline std::size_t thread_pool::defaultWorkerCount() noexcept
+{
+    const unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 1 ? threads - 1 : 0;
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_THREADPOOL
@@ -0,0 +1,125 @@
+#ifndef SAMPLE_TYPETOKEN
+#define SAMPLE_TYPETOKEN
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace sample {
+namespace detail {
+
+template <typename T>
+constexpr std::string_view typeName() noexcept;
+    // Returns the name of `T` as spelled by the compiler, taken from the
+    // signature of this function.
+
+template <typename T>
+inline constexpr std::string_view typeTokenAnchor = typeName<T>();
+    // A variable whose address identifies `T`, and which holds its name.
+
+} // close namespace detail
+
+struct type_token {
+    // A `type_token` identifies a type without relying on RTTI, so that it
+    // is available when compiling with `-fno-rtti`.  Tokens are compared by
+    // address, and so are as cheap to compare as pointers.
+
+    // CLASS METHODS
+    template <typename T>
+    static constexpr type_token of() noexcept;
+        // Returns the token identifying `T`.
+
+    // ACCESSORS
+    constexpr bool operator==(const type_token& rhs) const noexcept;
+        // Returns whether `*this` and `rhs` identify the same type.
+
+    constexpr std::string_view name() const noexcept;
+        // Returns the name of the identified type, as spelled by the
+        // compiler.  The spelling is meant for diagnostics, and differs
+        // between compilers.
+
+private:
+    // FRIENDS
+    friend struct std::hash<type_token>;
+
+private:
+    // PRIVATE CREATORS
+    constexpr explicit type_token(const std::string_view* anchor) noexcept;
+
+private:
+    // DATA
+    const std::string_view* d_anchor;  // `typeTokenAnchor` for the type
+};
+
+} // close namespace sample
+
+template <>
+struct std::hash<sample::type_token> {
+    // Hashes `type_token`s, so that they may key unordered containers.
+
+    std::size_t operator()(const sample::type_token& token) const noexcept;
+};
+
+namespace sample {
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+template <typename T>
+inline constexpr std::string_view typeName() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const std::string_view signature = __FUNCSIG__;
+    const std::size_t first = signature.find("typeName<") + 9;
+    const std::size_t last = signature.rfind(">(void)");
+#else
+    // GCC spells `[with T = int; std::string_view = ...]`, and Clang
+    // `[T = int]`.
+    const std::string_view signature = __PRETTY_FUNCTION__;
+    const std::size_t first = signature.find("T = ") + 4;
+    std::size_t last = signature.find(';', first);
+    if (last == std::string_view::npos) {
+        last = signature.rfind(']');
+    }
+#endif
+    return signature.substr(first, last - first);
+}
+
+} // close namespace detail
+
+// CLASS METHODS
+template <typename T>
+inline constexpr type_token type_token::of() noexcept
+{
+    return type_token(&detail::typeTokenAnchor<T>);
+}
+
+// ACCESSORS
+inline constexpr bool type_token::operator==(const type_token& rhs) const
+    noexcept
+{
+    return d_anchor == rhs.d_anchor;
+}
+
+inline constexpr std::string_view type_token::name() const noexcept
+{
+    return *d_anchor;
+}
+
+// PRIVATE CREATORS
+inline constexpr type_token::type_token(const std::string_view* anchor)
+    noexcept
+    : d_anchor(anchor)
+{}
+
+} // close namespace sample
+
+inline std::size_t std::hash<sample::type_token>::operator()(
+    const sample::type_token& token) const noexcept
+{
+    return std::hash<const void*>()(token.d_anchor);
+}
+
+#endif // SAMPLE_TYPETOKEN
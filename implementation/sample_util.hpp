@@ -1,7 +1,9 @@
 #ifndef INCLUDED_SAMPLE_UTIL
 #define INCLUDED_SAMPLE_UTIL
 
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <type_traits>
 
 namespace sample::detail {
@@ -13,12 +15,13 @@ struct is_compatible_iterator : std::false_type {};
 template <template <typename...> class IteratorType,
           typename Category1, typename Category2,
           typename ValueType, typename Reference,
-          typename Pointer, typename DifferenceType>
+          typename Pointer, typename DifferenceType,
+          typename Storage1, typename Storage2>
 struct is_compatible_iterator<
     IteratorType<Category1, ValueType, Reference,
-        Pointer, DifferenceType>,
+        Pointer, DifferenceType, Storage1>,
     IteratorType<Category2, ValueType, Reference,
-        Pointer, DifferenceType>,
+        Pointer, DifferenceType, Storage2>,
     std::enable_if_t<
         std::is_base_of_v<Category1, Category2>
     >
@@ -28,6 +31,32 @@ template <typename Iterator1, typename Iterator2>
 constexpr bool is_compatible_iterator_v =
     is_compatible_iterator<Iterator1, Iterator2>::value;
 
+template <typename Iterator, typename Pointer, typename = void>
+struct is_contiguous_iterator_for : std::false_type {};
+    // Trait detecting whether `Iterator` is a contiguous iterator whose
+    // address, as obtained by `std::to_address`, is convertible to the raw
+    // pointer type `Pointer`, and whose elements are of the type `Pointer`
+    // points to, ignoring cv-qualifiers, so that stepping a `Pointer` steps
+    // over the same elements.  A pointer to a derived class converts to a
+    // pointer to its base, but not with the same stride.
+
+template <typename Iterator, typename Pointer>
+struct is_contiguous_iterator_for<Iterator, Pointer,
+    std::enable_if_t<
+        std::contiguous_iterator<Iterator> && std::is_pointer_v<Pointer>
+    >
+> : std::bool_constant<
+        std::is_convertible_v<
+            decltype(std::to_address(std::declval<const Iterator&>())),
+            Pointer> &&
+        std::is_same_v<std::remove_cv_t<std::iter_value_t<Iterator>>,
+                       std::remove_cv_t<std::remove_pointer_t<Pointer>>>
+    > {};
+
+template <typename Iterator, typename Pointer>
+constexpr bool is_contiguous_iterator_for_v =
+    is_contiguous_iterator_for<Iterator, Pointer>::value;
+
 template <class T, class U> 
   using apply_value_category_t = 
     std::conditional_t<std::is_lvalue_reference_v<T>,
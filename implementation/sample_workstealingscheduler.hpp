@@ -0,0 +1,263 @@
+#ifndef SAMPLE_WORKSTEALINGSCHEDULER
+#define SAMPLE_WORKSTEALINGSCHEDULER
+
+#include <sample_splitrange.hpp>
+#include <sample_threadpool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sample {
+namespace detail {
+
+constexpr std::chrono::nanoseconds WORK_STEALING_CHUNK_TIME{50000};
+    // The default time a `work_stealing_scheduler` aims to spend on each
+    // piece of a range, long enough to amortize splitting and stealing, and
+    // short enough for the pieces of a range to balance across threads.
+
+template <typename Task>
+class WorkStealingDeque {
+    // This class holds the tasks of one thread of a `work_stealing_scheduler`,
+    // which pushes and pops them at the back, most recently split first,
+    // while other threads steal from the front, where the largest pieces
+    // are.  It is guarded by a mutex, which is only contended while a task is
+    // being stolen, since each task stands for many elements.
+
+public:
+    // MANIPULATORS
+    void push(Task task);
+        // Add `task` at the back.
+
+    std::optional<Task> pop();
+        // Remove and return the task at the back, if any.
+
+    std::optional<Task> steal();
+        // Remove and return the task at the front, if any.
+
+private:
+    // DATA
+    std::mutex       d_mutex;
+    std::deque<Task> d_tasks;
+};
+
+} // close namespace detail
+
+class work_stealing_scheduler {
+    // A `work_stealing_scheduler` calls a function on disjoint pieces
+    // covering a sized range, on the threads of a `thread_pool`.  The range
+    // starts on the deque of one thread; each thread repeatedly takes a
+    // piece from its own deque, or steals one from another's, halves it with
+    // `bisect` until it is no larger than the current chunk size, pushing the
+    // second halves on its deque, and calls the function on what remains.
+    // Idle threads so take the largest pending pieces, and the range is
+    // only split as far as threads run out of work.
+    //
+    // The chunk size is chosen for each piece so that it takes about the
+    // target chunk time, from an estimate of the cost per element, a moving
+    // average of the times measured for the pieces processed.  It adapts as
+    // the cost varies across a range and is kept between runs, so a
+    // scheduler reused for similar work starts with a good chunk size.  Until
+    // a first piece has been timed, pieces are only split down to an equal
+    // share of the range per thread.
+
+public:
+    // CREATORS
+    explicit work_stealing_scheduler(
+        thread_pool& pool = thread_pool::instance(),
+        std::chrono::nanoseconds chunkTime = detail::WORK_STEALING_CHUNK_TIME);
+        // Construct a `work_stealing_scheduler` running on `pool` and aiming
+        // to spend `chunkTime` on each piece.
+
+    work_stealing_scheduler(const work_stealing_scheduler&) = delete;
+
+    // MANIPULATORS
+    work_stealing_scheduler& operator=(const work_stealing_scheduler&) =
+        delete;
+
+    template <typename Range, typename Function>
+    void run(const Range& range, Function&& function);
+        // Call `function` with each of a set of disjoint `split_range`s
+        // covering `range`, concurrently, and return once every call has
+        // returned.  If a call exits with an exception, no further pieces
+        // are started and one of the exceptions is rethrown.
+        //
+        // `Range` is a `split_range` or a sized range as accepted by
+        // `split`, and `function` is called concurrently from several
+        // threads.
+
+    // ACCESSORS
+    double element_cost() const noexcept;
+        // Returns the estimated time per element, in nanoseconds, or zero if
+        // no piece has been processed yet.
+
+    std::size_t chunk_size() const noexcept;
+        // Returns the number of elements in the pieces the function is
+        // currently called on, or one if the cost is not yet estimated, in
+        // which case `run` splits the range into a piece per thread.
+
+private:
+    // PRIVATE MANIPULATORS
+    void record(std::chrono::nanoseconds elapsed, std::size_t elements)
+        noexcept;
+        // Update the cost estimate with the time `elapsed` processing a piece
+        // of `elements` elements.
+
+private:
+    // DATA
+    thread_pool              *d_pool;
+    std::chrono::nanoseconds  d_chunkTime;
+    std::atomic<double>       d_elementCost{0.0};  // nanoseconds
+};
+
+// ===========================================================================
+//      INLINE DEFINITIONS
+// ===========================================================================
+namespace detail {
+
+// WorkStealingDeque
+template <typename Task>
+inline void WorkStealingDeque<Task>::push(Task task)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_tasks.push_back(std::move(task));
+}
+
+template <typename Task>
+inline std::optional<Task> WorkStealingDeque<Task>::pop()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_tasks.empty()) {
+        return std::nullopt;
+    }
+    std::optional<Task> task(std::move(d_tasks.back()));
+    d_tasks.pop_back();
+    return task;
+}
+
+template <typename Task>
+inline std::optional<Task> WorkStealingDeque<Task>::steal()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_tasks.empty()) {
+        return std::nullopt;
+    }
+    std::optional<Task> task(std::move(d_tasks.front()));
+    d_tasks.pop_front();
+    return task;
+}
+
+} // close namespace detail
+
+// CREATORS
+inline work_stealing_scheduler::work_stealing_scheduler(
+    thread_pool& pool, std::chrono::nanoseconds chunkTime)
+    : d_pool(&pool)
+    , d_chunkTime(chunkTime)
+{}
+
+// MANIPULATORS
+template <typename Range, typename Function>
+inline void work_stealing_scheduler::run(const Range& range,
+                                         Function&& function)
+{
+    using Iterator = typename Range::iterator;
+    using Piece = split_range<Iterator>;
+
+    std::optional<Piece> whole;
+    if constexpr (std::is_same_v<Range, Piece>) {
+        whole.emplace(range);
+    } else {
+        whole.emplace(range.begin(), range.last(), range.size());
+    }
+    if (whole->empty()) {
+        return;
+    }
+
+    const std::size_t threads = d_pool->concurrency();
+    const std::size_t share = std::max(whole->size() / threads,
+                                       std::size_t{1});
+    std::vector<detail::WorkStealingDeque<Piece>> deques(threads);
+    std::atomic<std::size_t> remaining{whole->size()};
+    deques.front().push(std::move(*whole));
+    std::atomic<bool> failed{false};
+
+    d_pool->run(threads, [&](std::size_t index) {
+        detail::WorkStealingDeque<Piece>& own = deques[index];
+        while (remaining.load(std::memory_order_acquire) != 0 &&
+               !failed.load(std::memory_order_relaxed)) {
+            std::optional<Piece> piece = own.pop();
+            for (std::size_t i = 1; !piece && i != threads; ++i) {
+                piece = deques[(index + i) % threads].steal();
+            }
+            if (!piece) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const std::size_t chunkSize = element_cost() > 0.0 ? chunk_size()
+                                                               : share;
+            while (piece->size() > chunkSize) {
+                auto halves = bisect(*piece);
+                own.push(std::move(halves.second));
+                *piece = std::move(halves.first);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                function(std::as_const(*piece));
+            } catch (...) {
+                failed.store(true, std::memory_order_relaxed);
+                throw;
+            }
+            record(std::chrono::steady_clock::now() - start, piece->size());
+            remaining.fetch_sub(piece->size(), std::memory_order_release);
+        }
+    });
+}
+
+inline void work_stealing_scheduler::record(std::chrono::nanoseconds elapsed,
+                                            std::size_t elements) noexcept
+{
+    // Concurrent updates may be lost, which only slows the average down.
+    const auto nanoseconds = std::max(elapsed.count(),
+                                      std::chrono::nanoseconds::rep{1});
+    const double sample = static_cast<double>(nanoseconds) /
+                          static_cast<double>(elements);
+    const double cost = d_elementCost.load(std::memory_order_relaxed);
+    d_elementCost.store(cost == 0.0 ? sample : cost + (sample - cost) / 4,
+                        std::memory_order_relaxed);
+}
+
+// ACCESSORS
+inline double work_stealing_scheduler::element_cost() const noexcept
+{
+    return d_elementCost.load(std::memory_order_relaxed);
+}
+
+inline std::size_t work_stealing_scheduler::chunk_size() const noexcept
+{
+    const double cost = element_cost();
+    if (cost <= 0.0) {
+        return 1;
+    }
+    const double elements = static_cast<double>(d_chunkTime.count()) / cost;
+    if (elements >= static_cast<double>(
+                        std::numeric_limits<std::size_t>::max() / 2)) {
+        return std::numeric_limits<std::size_t>::max() / 2;
+    }
+    return std::max(static_cast<std::size_t>(elements), std::size_t{1});
+}
+
+} // close namespace sample
+
+#endif // SAMPLE_WORKSTEALINGSCHEDULER
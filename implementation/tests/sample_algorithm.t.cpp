@@ -0,0 +1,523 @@
+#include <sample_algorithm.hpp>
+#include <tests/sample_testsupport.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+using sample::testsupport::CountingResource;
+
+struct Fixed {
+    // A value which cannot be assigned to.
+
+    // DATA
+    const int d_value;
+};
+
+template <typename Iterator, typename = void>
+struct HasRead : std::false_type {};
+    // Trait detecting whether `Iterator` has a `read` member.
+
+template <typename Iterator>
+struct HasRead<Iterator, std::void_t<decltype(std::declval<Iterator&>().read(
+    std::declval<typename Iterator::value_type*>(), 1u,
+    std::declval<const Iterator&>()))>> : std::true_type {};
+
+} // close anonymous namespace
+
+TEST(BulkReadTest, read_stops_at_last)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3, 4, 5};
+    sample::any_input_iterator<int> first(begin(v));
+    sample::any_input_iterator<int> last(end(v));
+    int output[4] = {};
+
+    // WHEN
+    const std::size_t firstRead = first.read(output, 4u, last);
+    const std::size_t secondRead = first.read(output + 1, 3u, last);
+    const std::size_t thirdRead = first.read(output, 4u, last);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(firstRead, Eq(4u));
+    EXPECT_THAT(secondRead, Eq(1u));
+    EXPECT_THAT(thirdRead, Eq(0u));
+    EXPECT_THAT(output, ElementsAre(1, 5, 3, 4));
+    EXPECT_THAT(first, Eq(last));
+}
+
+TEST(BulkReadTest, read_advances_bidirectional_iterator)
+{
+    // GIVEN
+    std::list<int> list{1, 2, 3, 4, 5};
+    sample::any_bidirectional_iterator<int> first(begin(list));
+    sample::any_bidirectional_iterator<int> last(end(list));
+    int output[2] = {};
+
+    // WHEN
+    const std::size_t count = first.read(output, 2u, last);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(count, Eq(2u));
+    EXPECT_THAT(output, ElementsAre(1, 2));
+    EXPECT_THAT(*first, Eq(3));
+}
+
+TEST(BulkReadTest, unavailable_for_non_assignable_value_type)
+{
+    // GIVEN
+    const std::vector<Fixed> v{{1}, {2}, {3}};
+    using Iterator = sample::any_forward_iterator<const Fixed>;
+    std::vector<int> output;
+
+    // WHEN
+    sample::transform(Iterator(begin(v)), Iterator(end(v)),
+                      std::back_inserter(output),
+                      [](const Fixed& f) { return f.d_value; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(HasRead<Iterator>::value, Eq(false));
+    EXPECT_THAT(HasRead<sample::any_forward_iterator<int>>::value, Eq(true));
+    EXPECT_THAT(sample::detail::is_bulk_readable_v<Iterator>, Eq(false));
+    EXPECT_THAT(output, ElementsAre(1, 2, 3));
+}
+
+TEST(CopyTest, copies_input_range_spanning_several_batches)
+{
+    // GIVEN
+    std::vector<int> input(1000u);
+    std::iota(begin(input), end(input), 0);
+    std::vector<int> output;
+
+    // WHEN
+    sample::copy(sample::any_input_iterator<int>(begin(input)),
+                 sample::any_input_iterator<int>(end(input)),
+                 std::back_inserter(output));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output, ContainerEq(input));
+}
+
+TEST(CopyTest, copies_from_stream_into_any_output_iterator)
+{
+    // GIVEN
+    std::stringstream s("Hello type erased World");
+    std::vector<std::string> output;
+
+    // WHEN
+    sample::copy(
+        sample::any_input_iterator<const std::string>(
+            std::istream_iterator<std::string>(s)),
+        sample::any_input_iterator<const std::string>(
+            std::istream_iterator<std::string>()),
+        sample::any_output_iterator<std::string>(std::back_inserter(output)));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output, ElementsAre("Hello", "type", "erased", "World"));
+}
+
+TEST(CopyTest, copies_empty_range)
+{
+    // GIVEN
+    std::vector<int> input;
+    std::vector<int> output;
+
+    // WHEN
+    sample::copy(sample::any_input_iterator<int>(begin(input)),
+                 sample::any_input_iterator<int>(end(input)),
+                 std::back_inserter(output));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output, SizeIs(0u));
+}
+
+TEST(TransformTest, transforms_input_range)
+{
+    // GIVEN
+    std::list<int> input(300u);
+    std::iota(begin(input), end(input), 0);
+    std::vector<int> output(input.size());
+
+    // WHEN
+    const auto last = sample::transform(
+        sample::any_input_iterator<int>(begin(input)),
+        sample::any_input_iterator<int>(end(input)),
+        begin(output), [](int i) { return 2 * i; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(last, Eq(end(output)));
+    EXPECT_THAT(output[0], Eq(0));
+    EXPECT_THAT(output[299], Eq(598));
+}
+
+TEST(TransformTest, op_may_modify_elements_through_reference)
+{
+    // GIVEN
+    std::list<int> input{1, 2, 3};
+    std::vector<int> output;
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    sample::transform(Iterator(begin(input)), Iterator(end(input)),
+                      std::back_inserter(output), [](int& i) { return ++i; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output, ElementsAre(2, 3, 4));
+    EXPECT_THAT(input, ElementsAre(2, 3, 4));
+}
+
+TEST(TransformTest, transforms_values_in_batches)
+{
+    // GIVEN
+    std::list<int> input(300u);
+    std::iota(begin(input), end(input), 0);
+    std::vector<int> output;
+    using Iterator = sample::any_input_iterator<int, int>;
+
+    // WHEN
+    sample::transform(Iterator(begin(input)), Iterator(end(input)),
+                      std::back_inserter(output),
+                      [](int&& i) { return i + 1; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output.size(), Eq(300u));
+    EXPECT_THAT(output[299], Eq(300));
+}
+
+TEST(FindTest, finds_in_contiguous_and_other_ranges)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    std::list<int> l{1, 2, 3};
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    Iterator inVector = sample::find(Iterator(begin(v)), Iterator(end(v)), 2);
+    Iterator inList = sample::find(Iterator(begin(l)), Iterator(end(l)), 3);
+    Iterator missing = sample::find(Iterator(begin(v)), Iterator(end(v)), 4);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(&*inVector, Eq(&v[1]));
+    EXPECT_THAT(&*inList, Eq(&l.back()));
+    EXPECT_THAT(missing == Iterator(end(v)), Eq(true));
+}
+
+TEST(EqualTest, compares_contiguous_and_other_ranges)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    std::vector<int> w{1, 2, 4};
+    std::list<int> l{1, 2, 3};
+    using Iterator = sample::any_input_iterator<int>;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sample::equal(Iterator(begin(v)), Iterator(end(v)),
+        Iterator(begin(l))), Eq(true));
+    EXPECT_THAT(sample::equal(Iterator(begin(v)), Iterator(end(v)),
+        Iterator(begin(w))), Eq(false));
+    EXPECT_THAT(sample::equal(Iterator(begin(l)), Iterator(end(l)),
+        Iterator(begin(v))), Eq(true));
+}
+
+TEST(ForEachTest, visits_contiguous_and_other_ranges)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    std::list<int> l{4, 5};
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    sample::for_each(Iterator(begin(v)), Iterator(end(v)), [](int& i) { ++i; });
+    auto sum = sample::for_each(Iterator(begin(l)), Iterator(end(l)),
+        [total = 0](int i) mutable { return total += i; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(v, ElementsAre(2, 3, 4));
+    EXPECT_THAT(sum(0), Eq(9));
+}
+
+TEST(CopyTest, copies_between_contiguous_ranges)
+{
+    // GIVEN
+    std::vector<int> input{1, 2, 3};
+    std::vector<int> output(4u);
+    using Iterator = sample::any_random_access_iterator<int>;
+
+    // WHEN
+    Iterator result = sample::copy(Iterator(begin(input)), Iterator(end(input)),
+        Iterator(begin(output)));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(output, ElementsAre(1, 2, 3, 0));
+    EXPECT_THAT(&*result, Eq(&output[3]));
+}
+
+TEST(BulkWriteTest, write_n_appends_through_underlying_iterator)
+{
+    // GIVEN
+    const int input[] = {1, 2, 3};
+    std::vector<int> v{0};
+    std::list<int> l;
+    std::ostringstream ss;
+
+    // WHEN
+    sample::any_output_iterator<int>(std::back_inserter(v)).write_n(input, 3u);
+    sample::any_output_iterator<int>(std::back_inserter(l))
+        .write_n(input, 2u).write_n(input + 2, 1u);
+    sample::any_output_iterator<int>(std::ostream_iterator<int>(ss, ","))
+        .write_n(input, 3u);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(v, ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(l, ElementsAre(1, 2, 3));
+    EXPECT_THAT(ss.str(), StrEq("1,2,3,"));
+}
+
+TEST(BulkWriteTest, reserve_hint_reserves_in_container)
+{
+    // GIVEN
+    std::vector<int> v{1};
+    std::list<int> l;
+
+    // WHEN
+    sample::any_output_iterator<int>(std::back_inserter(v)).reserve_hint(100u);
+    sample::any_output_iterator<int>(std::back_inserter(l)).reserve_hint(100u);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(v.capacity(), Ge(101u));
+    EXPECT_THAT(v, ElementsAre(1));
+    EXPECT_THAT(l.empty(), Eq(true));
+}
+
+TEST(CopyTest, copy_into_back_inserter_allocates_once)
+{
+    // GIVEN
+    std::vector<int> contiguous(1000);
+    std::iota(begin(contiguous), end(contiguous), 0);
+    std::deque<int> deque(begin(contiguous), end(contiguous));
+    using Iterator = sample::any_random_access_iterator<int>;
+    using OutputIterator = sample::any_output_iterator<int>;
+
+    CountingResource fromVector;
+    CountingResource fromDeque;
+    CountingResource fromAnyDeque;
+    std::pmr::vector<int> outputFromVector(&fromVector);
+    std::pmr::vector<int> outputFromDeque(&fromDeque);
+    std::pmr::vector<int> outputFromAnyDeque(&fromAnyDeque);
+
+    // WHEN
+    sample::copy(Iterator(begin(contiguous)), Iterator(end(contiguous)),
+        OutputIterator(std::back_inserter(outputFromVector)));
+    sample::copy(begin(deque), end(deque),
+        OutputIterator(std::back_inserter(outputFromDeque)));
+    sample::copy(Iterator(begin(deque)), Iterator(end(deque)),
+        OutputIterator(std::back_inserter(outputFromAnyDeque)));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(outputFromVector, ElementsAreArray(contiguous));
+    EXPECT_THAT(outputFromDeque, ElementsAreArray(contiguous));
+    EXPECT_THAT(outputFromAnyDeque, ElementsAreArray(contiguous));
+    EXPECT_THAT(fromVector.d_allocations, Eq(1));
+    EXPECT_THAT(fromDeque.d_allocations, Eq(1));
+    EXPECT_THAT(fromAnyDeque.d_allocations, Eq(1));
+}
+
+TEST(ForEachUntilTest, stops_at_element_visitor_accepts)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3, 4};
+    std::vector<int> v{1, 2, 3, 4};
+    using Iterator = sample::any_forward_iterator<int>;
+    Iterator listFirst(begin(l));
+    Iterator vectorFirst(begin(v));
+    std::vector<int> visited;
+    auto visitor = [&visited](int i) {
+        visited.push_back(i);
+        return i == 3;
+    };
+
+    // WHEN
+    const bool listFound = listFirst.for_each_until(Iterator(end(l)), visitor);
+    const bool vectorFound = vectorFirst.for_each_until(Iterator(end(v)),
+        visitor);
+    Iterator listEnd(end(l));
+    const bool notFound = listFirst.for_each_until(listEnd, [](int i) {
+        return i == 5;
+    });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(listFound, Eq(true));
+    EXPECT_THAT(vectorFound, Eq(true));
+    EXPECT_THAT(notFound, Eq(false));
+    EXPECT_THAT(listFirst, Eq(listEnd));
+    EXPECT_THAT(*vectorFirst, Eq(3));
+    EXPECT_THAT(visited, ElementsAre(1, 2, 3, 1, 2, 3));
+}
+
+TEST(FindIfTest, finds_in_erased_ranges)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3, 4};
+    std::vector<int> v{1, 2, 3, 4};
+    using Iterator = sample::any_input_iterator<int>;
+    auto isEven = [](int i) { return i % 2 == 0; };
+    auto isNegative = [](int i) { return i < 0; };
+
+    // WHEN
+    Iterator inList = sample::find_if(Iterator(begin(l)), Iterator(end(l)),
+        isEven);
+    Iterator inVector = sample::find_if(Iterator(begin(v)), Iterator(end(v)),
+        isEven);
+    Iterator missing = sample::find_if(Iterator(begin(l)), Iterator(end(l)),
+        isNegative);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*inList, Eq(2));
+    EXPECT_THAT(*inVector, Eq(2));
+    EXPECT_THAT(missing == Iterator(end(l)), Eq(true));
+    EXPECT_THAT(*sample::find_if(begin(v), end(v), isEven), Eq(2));
+}
+
+TEST(CountIfTest, counts_in_erased_ranges)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3, 4};
+    std::vector<int> v{1, 2, 3, 4, 6};
+    using Iterator = sample::any_forward_iterator<int>;
+    auto isEven = [](int i) { return i % 2 == 0; };
+
+    // WHEN
+    const auto inList = sample::count_if(Iterator(begin(l)), Iterator(end(l)),
+        isEven);
+    const auto inVector = sample::count_if(Iterator(begin(v)),
+        Iterator(end(v)), isEven);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(inList, Eq(2));
+    EXPECT_THAT(inVector, Eq(3));
+    EXPECT_THAT(sample::count_if(begin(l), end(l), isEven), Eq(2));
+}
+
+TEST(AccumulateTest, folds_erased_ranges)
+{
+    // GIVEN
+    std::istringstream ss("a b c");
+    std::list<int> l{1, 2, 3, 4};
+    using Iterator = sample::any_input_iterator<std::string,
+        const std::string&, const std::string*>;
+
+    // WHEN
+    const std::string joined = sample::accumulate(
+        Iterator(std::istream_iterator<std::string>(ss)),
+        Iterator(std::istream_iterator<std::string>()), std::string("-"));
+    const int product = sample::accumulate(
+        sample::any_bidirectional_iterator<int>(begin(l)),
+        sample::any_bidirectional_iterator<int>(end(l)), 1,
+        [](int lhs, int rhs) { return lhs * rhs; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(joined, StrEq("-abc"));
+    EXPECT_THAT(product, Eq(24));
+    EXPECT_THAT(sample::accumulate(begin(l), end(l), 0), Eq(10));
+}
+
+TEST(CountTest, counts_in_contiguous_and_other_ranges)
+{
+    // GIVEN
+    std::vector<double> v{1.0, 2.0, 1.0, 3.0, 1.0};
+    std::list<double> l(begin(v), end(v));
+    using Iterator = sample::any_forward_iterator<double>;
+
+    // WHEN
+    const auto inVector = sample::count(Iterator(begin(v)), Iterator(end(v)),
+        1.0);
+    const auto inList = sample::count(Iterator(begin(l)), Iterator(end(l)),
+        1.0);
+    const auto ofInt = sample::count(Iterator(begin(v)), Iterator(end(v)), 1);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(inVector, Eq(3));
+    EXPECT_THAT(inList, Eq(3));
+    EXPECT_THAT(ofInt, Eq(3));
+}
+
+TEST(AccumulateTest, sums_contiguous_arithmetic_ranges)
+{
+    // GIVEN
+    std::vector<std::int64_t> v(1000);
+    std::iota(begin(v), end(v), std::int64_t{1});
+    using Iterator = sample::any_random_access_iterator<std::int64_t>;
+
+    // WHEN
+    const std::int64_t sum = sample::accumulate(Iterator(begin(v)),
+        Iterator(end(v)), std::int64_t{10});
+    const double widened = sample::accumulate(Iterator(begin(v)),
+        Iterator(end(v)), 0.5);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sum, Eq(500510));
+    EXPECT_THAT(widened, DoubleEq(500500.5));
+}
+
+TEST(MinMaxElementTest, finds_extremes_in_contiguous_and_other_ranges)
+{
+    // GIVEN
+    std::vector<float> v(100);
+    std::iota(begin(v), end(v), -50.0f);
+    v[70] = -60.0f;
+    v[80] = -60.0f;
+    v[10] = 90.0f;
+    std::list<float> l(begin(v), end(v));
+    using Iterator = sample::any_forward_iterator<float>;
+
+    // WHEN
+    const Iterator minInVector = sample::min_element(Iterator(begin(v)),
+        Iterator(end(v)));
+    const Iterator maxInVector = sample::max_element(Iterator(begin(v)),
+        Iterator(end(v)));
+    const Iterator minInList = sample::min_element(Iterator(begin(l)),
+        Iterator(end(l)));
+    const Iterator empty = sample::max_element(Iterator(begin(v)),
+        Iterator(begin(v)));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(minInVector == Iterator(begin(v) + 70), Eq(true));
+    EXPECT_THAT(maxInVector == Iterator(begin(v) + 10), Eq(true));
+    EXPECT_THAT(minInList == Iterator(std::next(begin(l), 70)), Eq(true));
+    EXPECT_THAT(empty == Iterator(begin(v)), Eq(true));
+}
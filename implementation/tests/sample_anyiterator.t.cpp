@@ -1,13 +1,61 @@
 #include <sample_anyiterator.hpp>
+#include <tests/sample_testsupport.hpp>
 
+#include <algorithm>
+#include <deque>
 #include <sstream>
 #include <forward_list>
 #include <list>
+#include <memory_resource>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+namespace {
+
+using sample::testsupport::CountingResource;
+
+struct ArrayWriter {
+    // An output iterator writing to consecutive elements of an array.
+
+    // TYPES
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using reference = void;
+    using pointer = void;
+
+    // MANIPULATORS
+    int& operator*() const { return *d_position; }
+    ArrayWriter& operator++() { ++d_position; return *this; }
+    ArrayWriter operator++(int) { return ArrayWriter{d_position++}; }
+
+    // DATA
+    int *d_position;
+};
+
+struct Base {
+    // A class from which to derive `Derived`.
+
+    // DATA
+    int d_value;
+};
+
+struct Derived : Base {
+    // A class larger than its base.
+
+    // CREATORS
+    explicit Derived(int value) : Base{value} {}
+
+    // DATA
+    int d_extra = 0;
+};
+
+} // close anonymous namespace
+
 TEST(InputIteratorTest, constructible_from_input_iterator)
 {
     std::stringstream s("Hello");
@@ -58,6 +106,27 @@ TEST(OutputIteratorTest, iterator_works_as_expected)
     EXPECT_THAT(test2, StrEq(test));
 }
 
+TEST(OutputIteratorTest, postfix_increment_assigns_before_advancing)
+{
+    // GIVEN
+    int native[3] = {};
+    int erased[3] = {};
+    ArrayWriter direct{native};
+    sample::any_output_iterator<int> output(ArrayWriter{erased});
+
+    // WHEN
+    *direct++ = 1;
+    *direct++ = 2;
+    *output++ = 1;
+    *output++ = 2;
+    *output = 3;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(native, ElementsAre(1, 2, 0));
+    EXPECT_THAT(erased, ElementsAre(1, 2, 3));
+}
+
 TEST(ForwardIteratorTest, constructible_from_forward_iterator)
 {
     std::forward_list<int> list;
@@ -161,3 +230,456 @@ TEST(RandomAccessIteratorTest, user_defined_deduction_guide_works)
         sample::any_random_access_iterator<int, int&, int*>>),
         Eq(true));
 }
+
+TEST(RandomAccessIteratorTest, contiguous_iterator_stored_as_pointer)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3, 4, 5};
+
+    // WHEN
+    sample::any_random_access_iterator<int> first(begin(v));
+    sample::any_random_access_iterator<int> last(end(v));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*static_cast<int**>(first.base()), Eq(v.data()));
+    EXPECT_THAT(last - first, Eq(5));
+    EXPECT_THAT(first[3], Eq(4));
+    EXPECT_THAT(*++first, Eq(2));
+    EXPECT_THAT(first, Ne(last));
+}
+
+TEST(RandomAccessIteratorTest, contiguous_iterators_compare_with_pointers)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+
+    // WHEN
+    sample::any_random_access_iterator<int> first(begin(v));
+    sample::any_random_access_iterator<int> last(v.data() + v.size());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(last - first, Eq(3));
+    EXPECT_THAT(first + 3, Eq(last));
+}
+
+TEST(RandomAccessIteratorTest, derived_elements_not_stored_as_base_pointer)
+{
+    // GIVEN
+    std::vector<Derived> v{Derived(1), Derived(2), Derived(3)};
+    using Iterator = sample::any_random_access_iterator<Base>;
+
+    // WHEN
+    Iterator first(begin(v));
+    Iterator last(end(v));
+    Iterator pointer(v.data());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first.target<std::vector<Derived>::iterator>(), NotNull());
+    EXPECT_THAT(pointer.target<Derived*>(), NotNull());
+    EXPECT_THAT(last - first, Eq(3));
+    EXPECT_THAT(first[2].d_value, Eq(3));
+    EXPECT_THAT(std::count_if(first, last,
+        [](const Base& b) { return b.d_value > 0; }), Eq(3));
+}
+
+TEST(RandomAccessIteratorTest, non_contiguous_iterator_works_as_expected)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3, 4, 5};
+    sample::any_random_access_iterator<int> first(begin(d));
+    sample::any_random_access_iterator<int> last(end(d));
+
+    // WHEN
+    std::vector<int> v{first, last};
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*static_cast<std::deque<int>::iterator*>(first.base()), 
+        Eq(begin(d)));
+    EXPECT_THAT(last - first, Eq(5));
+    EXPECT_THAT(first[3], Eq(4));
+    EXPECT_THAT(v, ElementsAreArray(cbegin(d), cend(d)));
+}
+
+TEST(RandomAccessIteratorTest, conversion_shares_underlying_iterator)
+{
+    // GIVEN
+    std::deque<std::pair<int, int>> d{{1, 2}, {3, 4}};
+    sample::any_random_access_iterator<std::pair<int, int>> first(begin(d));
+
+    // WHEN
+    sample::any_bidirectional_iterator<std::pair<int, int>> weaker(first);
+    sample::any_bidirectional_iterator<std::pair<int, int>> last(
+        sample::any_random_access_iterator<std::pair<int, int>>(end(d)));
+
+    // THEN
+    using namespace ::testing;
+    using Underlying = std::deque<std::pair<int, int>>::iterator;
+    EXPECT_THAT(*static_cast<Underlying*>(weaker.base()), Eq(begin(d)));
+    EXPECT_THAT(weaker->second, Eq(2));
+    EXPECT_THAT((++weaker)->first, Eq(3));
+    EXPECT_THAT(++weaker, Eq(last));
+}
+
+TEST(RandomAccessIteratorTest, converted_iterator_compares_with_weaker)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    sample::any_random_access_iterator<int> first(begin(d));
+
+    // WHEN
+    sample::any_bidirectional_iterator<int> converted(first);
+    sample::any_bidirectional_iterator<int> direct(end(d));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(converted, Ne(direct));
+    EXPECT_THAT(std::next(converted, 3), Eq(direct));
+}
+
+TEST(RandomAccessIteratorTest, relational_operators_work_as_expected)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    sample::any_random_access_iterator<int> first(begin(d));
+    sample::any_random_access_iterator<int> last(end(d));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first < last, Eq(true));
+    EXPECT_THAT(first > last, Eq(false));
+    EXPECT_THAT(first <= first, Eq(true));
+    EXPECT_THAT(last >= first, Eq(true));
+    EXPECT_THAT(last - 3, Eq(first));
+}
+
+TEST(StoragePolicyTest, compact_policies_use_three_pointers)
+{
+    // GIVEN
+    using InlineIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::inline_storage<sizeof(void*)>>;
+    using HeapIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sizeof(InlineIterator), Eq(3u * sizeof(void*)));
+    EXPECT_THAT(sizeof(HeapIterator), Eq(3u * sizeof(void*)));
+}
+
+TEST(StoragePolicyTest, inline_storage_works_as_expected)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::inline_storage<sizeof(void*)>>;
+    Iterator first(begin(v));
+    Iterator last(end(v));
+
+    // WHEN
+    Iterator copy(first);
+    std::vector<int> result{++copy, last};
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(last - first, Eq(3));
+    EXPECT_THAT(result, ElementsAre(2, 3));
+}
+
+TEST(StoragePolicyTest, heap_storage_works_as_expected)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    Iterator first(begin(d));
+    Iterator last(end(d));
+
+    // WHEN
+    Iterator copy(first);
+    Iterator moved(std::move(copy));
+    std::vector<int> result{moved, last};
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAreArray(cbegin(d), cend(d)));
+}
+
+TEST(StoragePolicyTest, convertible_between_policies)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    std::vector<int> v{4, 5, 6};
+    using HeapIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    using InlineIterator = sample::any_forward_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::inline_storage<2u * sizeof(void*)>>;
+    sample::any_random_access_iterator<int> first(begin(d));
+    InlineIterator inlined(begin(v));
+
+    // WHEN
+    HeapIterator heap(first);
+    sample::any_forward_iterator<int> fromHeap(std::move(heap));
+    sample::any_forward_iterator<int> fromInline(inlined);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*fromHeap, Eq(1));
+    EXPECT_THAT(*++fromHeap, Eq(2));
+    EXPECT_THAT(*fromInline, Eq(4));
+    EXPECT_THAT((std::is_constructible_v<InlineIterator, HeapIterator>),
+        Eq(false));
+    EXPECT_THAT((std::is_constructible_v<
+        sample::any_forward_iterator<int>, InlineIterator>), Eq(true));
+}
+
+TEST(RandomAccessIteratorTest, move_and_swap_do_not_reallocate)
+{
+    // GIVEN
+    std::deque<int> d{1, 2};
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    Iterator first(begin(d));
+    Iterator second(begin(d) + 1);
+    void* const address = first.base();
+    void* const address2 = second.base();
+
+    // WHEN
+    Iterator moved(std::move(first));
+    swap(moved, second);
+
+    // THEN
+    using namespace ::testing;
+    static_assert(std::is_nothrow_move_constructible_v<Iterator>);
+    static_assert(std::is_nothrow_move_assignable_v<
+        sample::any_random_access_iterator<int>>);
+    EXPECT_THAT(second.base(), Eq(address));
+    EXPECT_THAT(moved.base(), Eq(address2));
+    EXPECT_THAT(*moved, Eq(2));
+}
+
+TEST(RandomAccessIteratorTest, cursors_sortable)
+{
+    // GIVEN
+    std::deque<int> d{3, 1, 2};
+    std::list<int> l{5, 4};
+    std::vector<sample::any_forward_iterator<int>> cursors{
+        begin(d), std::next(begin(d)), std::next(begin(d), 2),
+        begin(l), std::next(begin(l))};
+
+    // WHEN
+    std::sort(begin(cursors), end(cursors),
+        [](const auto& lhs, const auto& rhs) { return *lhs < *rhs; });
+    cursors.reserve(2u * cursors.capacity());
+
+    // THEN
+    using namespace ::testing;
+    std::vector<int> values;
+    for (const auto& cursor : cursors) {
+        values.push_back(*cursor);
+    }
+    EXPECT_THAT(values, ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(AllocatorTest, heap_iterator_allocated_from_resource)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    std::byte arena[256];
+    std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena),
+        std::pmr::null_memory_resource());
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+
+    // WHEN
+    Iterator first(std::allocator_arg, &resource, begin(d));
+    Iterator last(std::allocator_arg, &resource, end(d));
+    Iterator copy(first);
+    sample::any_forward_iterator<int> converted(copy);
+    std::vector<int> result{converted, sample::any_forward_iterator<int>(last)};
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAreArray(cbegin(d), cend(d)));
+}
+
+TEST(AllocatorTest, copies_propagate_resource)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    CountingResource resource;
+
+    {
+        // WHEN
+        sample::any_bidirectional_iterator<int, int&, int*, std::ptrdiff_t,
+            sample::heap_storage> it(std::allocator_arg, &resource, begin(l));
+        auto copy = it;
+        ++copy;
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(*copy, Eq(2));
+        EXPECT_THAT(resource.d_allocations, Eq(2));
+        EXPECT_THAT(resource.d_deallocations, Eq(0));
+    }
+
+    using namespace ::testing;
+    EXPECT_THAT(resource.d_deallocations, Eq(2));
+}
+
+TEST(AllocatorTest, inline_iterator_spills_to_its_resource)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    CountingResource resource;
+    using Iterator = sample::any_random_access_iterator<int>;
+    using SmallIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::sbo_storage<sizeof(void*)>>;
+    using HeapIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+
+    {
+        const Iterator it(std::allocator_arg, &resource, begin(d));
+        Iterator copy = it;
+        const int before = resource.d_allocations;
+
+        // WHEN
+        SmallIterator small(copy);
+        HeapIterator heap(std::move(copy));
+        Iterator back(heap);
+        HeapIterator fromSmall(small);
+        SmallIterator fromBack(back);
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(before, Eq(0));
+        EXPECT_THAT(*++small, Eq(2));
+        EXPECT_THAT(*heap, Eq(1));
+        EXPECT_THAT(back[2], Eq(3));
+        EXPECT_THAT(*fromBack, Eq(1));
+        EXPECT_THAT(resource.d_allocations, Eq(4));
+    }
+
+    using namespace ::testing;
+    EXPECT_THAT(resource.d_deallocations, Eq(4));
+}
+
+TEST(AllocatorTest, inline_iterator_does_not_allocate)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    CountingResource resource;
+
+    // WHEN
+    sample::any_bidirectional_iterator<int> it(std::allocator_arg, &resource,
+        begin(l));
+    auto copy = it;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*copy, Eq(1));
+    EXPECT_THAT(resource.d_allocations, Eq(0));
+}
+
+TEST(AllocatorTest, singular_iterator_does_not_allocate)
+{
+    // GIVEN
+    using HeapIterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    using SharedIterator = sample::any_bidirectional_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::shared_storage<0>>;
+    CountingResource resource;
+    std::pmr::memory_resource *const previous =
+        std::pmr::set_default_resource(&resource);
+
+    // WHEN
+    {
+        HeapIterator heap;
+        HeapIterator heapCopy = heap;
+        HeapIterator heapMoved = std::move(heapCopy);
+        heapCopy = heapMoved;
+        SharedIterator shared;
+        SharedIterator sharedCopy = shared;
+        sharedCopy = SharedIterator();
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(heap == heapCopy, Eq(true));
+        EXPECT_THAT(heap == heapMoved, Eq(true));
+        EXPECT_THAT(shared == sharedCopy, Eq(true));
+    }
+    std::pmr::set_default_resource(previous);
+
+    using namespace ::testing;
+    EXPECT_THAT(resource.d_allocations, Eq(0));
+    EXPECT_THAT(noexcept(HeapIterator()), Eq(true));
+    EXPECT_THAT(noexcept(SharedIterator()), Eq(true));
+}
+
+TEST(TargetTest, target_matches_underlying_type)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    std::vector<int> v{3, 4};
+    using Iterator = sample::any_bidirectional_iterator<int>;
+
+    // WHEN
+    Iterator listIt(begin(l));
+    Iterator vectorIt(begin(v));
+    Iterator singular;
+
+    // THEN
+    using namespace ::testing;
+    using ListIterator = std::list<int>::iterator;
+    EXPECT_THAT(listIt.target_type() == sample::type_token::of<ListIterator>(),
+        Eq(true));
+    EXPECT_THAT(listIt.target<ListIterator>(), Eq(listIt.base()));
+    EXPECT_THAT(listIt.target<std::vector<int>::iterator>(), Eq(nullptr));
+    EXPECT_THAT(vectorIt.target<int*>(), Eq(vectorIt.base()));
+    EXPECT_THAT(**vectorIt.target<int*>(), Eq(3));
+    EXPECT_THAT(singular.target_type() == sample::type_token::of<void>(),
+        Eq(true));
+}
+
+TEST(TargetTest, type_token_names_type)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    sample::any_forward_iterator<int> it(begin(l));
+    std::unordered_set<sample::type_token> tokens;
+
+    // WHEN
+    tokens.insert(it.target_type());
+    tokens.insert(sample::type_token::of<std::list<int>::iterator>());
+    tokens.insert(sample::type_token::of<int*>());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sample::type_token::of<int>().name(), Eq("int"));
+    EXPECT_THAT(sample::type_token::of<const char*>().name(),
+        Eq("const char*"));
+    EXPECT_THAT(it.target_type().name(),
+        Eq(sample::type_token::of<std::list<int>::iterator>().name()));
+    EXPECT_THAT(std::string(it.target_type().name()), HasSubstr("int>"));
+    EXPECT_THAT(tokens.size(), Eq(2u));
+}
+
+TEST(TargetTest, target_survives_conversion)
+{
+    // GIVEN
+    std::deque<int> d{1, 2};
+    using DequeIterator = std::deque<int>::iterator;
+    sample::any_random_access_iterator<int> it(begin(d));
+
+    // WHEN
+    sample::any_forward_iterator<int> converted(it);
+    ++*converted.target<DequeIterator>();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(converted.target_type() == it.target_type(), Eq(true));
+    EXPECT_THAT(*converted, Eq(2));
+}
@@ -0,0 +1,155 @@
+#include <sample_anyrange.hpp>
+
+#include <array>
+#include <forward_list>
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(AnyRangeTest, constructible_from_iterator_pair)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+
+    // WHEN
+    sample::any_bidirectional_range<int> range(begin(l), end(l));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::vector<int>(range.begin(), range.last()), ElementsAre(1, 2, 3));
+    EXPECT_THAT(range.is_sized(), Eq(false));
+    EXPECT_THAT(range.empty(), Eq(false));
+}
+
+TEST(AnyRangeTest, input_range_works_as_expected)
+{
+    // GIVEN
+    std::istringstream ss("a b c");
+
+    // WHEN
+    sample::any_input_range<std::string, const std::string&,
+        const std::string*> range{std::istream_iterator<std::string>(ss),
+        std::istream_iterator<std::string>()};
+
+    // THEN
+    using namespace ::testing;
+    std::vector<std::string> result;
+    for (const std::string& s : range) {
+        result.push_back(s);
+    }
+    EXPECT_THAT(result, ElementsAre("a", "b", "c"));
+}
+
+TEST(AnyRangeTest, loop_compares_with_sentinel)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    using Range = sample::any_bidirectional_range<int>;
+    const Range range(l);
+
+    // WHEN
+    std::vector<int> result;
+    for (int element : range) {
+        result.push_back(element);
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT((std::is_same_v<decltype(range.end()), Range::sentinel>),
+                Eq(true));
+    EXPECT_THAT(std::ranges::range<const Range>, Eq(true));
+    EXPECT_THAT(result, ElementsAre(1, 2, 3));
+    EXPECT_THAT(range.begin() == range.end(), Eq(false));
+    EXPECT_THAT(range.last() == range.end(), Eq(true));
+}
+
+TEST(AnyRangeTest, lvalue_range_is_referenced)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+
+    // WHEN
+    sample::any_random_access_range<int> range(v);
+    v[0] = 4;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(range.is_sized(), Eq(true));
+    EXPECT_THAT(range.size(), Eq(3u));
+    EXPECT_THAT(range.begin()[0], Eq(4));
+}
+
+TEST(AnyRangeTest, rvalue_range_is_owned)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    const int* const data = v.data();
+
+    // WHEN
+    sample::any_forward_range<int> range(std::move(v));
+    sample::any_forward_range<int> copy(range);
+    *copy.begin() = 4;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(&*range.begin(), Eq(data));
+    EXPECT_THAT(std::vector<int>(range.begin(), range.last()), ElementsAre(1, 2, 3));
+    EXPECT_THAT(std::vector<int>(copy.begin(), copy.last()), ElementsAre(4, 2, 3));
+}
+
+TEST(AnyRangeTest, sized_when_std_size_applies)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    std::forward_list<int> fl{1, 2};
+
+    // WHEN
+    sample::any_forward_range<int> sized(l);
+    sample::any_forward_range<int> unsized(fl);
+    sample::any_forward_range<int> empty(std::array<int, 0>{});
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sized.is_sized(), Eq(true));
+    EXPECT_THAT(sized.size(), Eq(2u));
+    EXPECT_THAT(unsized.is_sized(), Eq(false));
+    EXPECT_THAT(unsized.empty(), Eq(false));
+    EXPECT_THAT(empty.empty(), Eq(true));
+}
+
+TEST(AnyRangeTest, holds_range_in_single_buffer)
+{
+    // GIVEN
+    using Range = sample::any_random_access_range<int>;
+    using Iterator = sample::any_random_access_iterator<int>;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sizeof(Range), Eq(sizeof(Iterator)));
+    EXPECT_THAT((std::is_same_v<Range::iterator, Iterator>), Eq(true));
+}
+
+TEST(AnyRangeTest, assignable_and_swappable)
+{
+    // GIVEN
+    std::vector<int> v{1, 2};
+    std::list<int> l{3};
+    sample::any_forward_range<int> first(v);
+    sample::any_forward_range<int> second(l);
+
+    // WHEN
+    swap(first, second);
+    sample::any_forward_range<int> third(std::vector<int>{5});
+    third = first;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::vector<int>(first.begin(), first.last()), ElementsAre(3));
+    EXPECT_THAT(std::vector<int>(second.begin(), second.last()), ElementsAre(1, 2));
+    EXPECT_THAT(std::vector<int>(third.begin(), third.last()), ElementsAre(3));
+}
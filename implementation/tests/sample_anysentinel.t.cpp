@@ -0,0 +1,155 @@
+#include <sample_anysentinel.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <ranges>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+struct NullTerminator {
+    // A sentinel for null terminated strings.
+
+    friend bool operator==(const char* it, NullTerminator)
+    {
+        return *it == '\0';
+    }
+};
+
+} // close anonymous namespace
+
+TEST(AnySentinelTest, models_sentinel_for_any_iterator)
+{
+    using namespace ::testing;
+    using Iterator = sample::any_forward_iterator<int>;
+    EXPECT_THAT((std::sentinel_for<sample::any_sentinel<Iterator>, Iterator>),
+        Eq(true));
+    EXPECT_THAT((std::sentinel_for<std::unreachable_sentinel_t, Iterator>),
+        Eq(true));
+    EXPECT_THAT((std::input_iterator<sample::any_input_iterator<int>>),
+        Eq(true));
+    EXPECT_THAT((std::output_iterator<sample::any_output_iterator<int>, int>),
+        Eq(true));
+}
+
+TEST(AnySentinelTest, null_terminated_string_works_as_expected)
+{
+    // GIVEN
+    const char* const str = "hello";
+    using Iterator = sample::any_forward_iterator<const char>;
+
+    // WHEN
+    Iterator first(str);
+    sample::any_sentinel<Iterator> last(std::in_place_type<const char*>,
+        NullTerminator{});
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::ranges::distance(first, last), Eq(5));
+    EXPECT_THAT(*std::ranges::find(first, last, 'l'), Eq('l'));
+    EXPECT_THAT(std::ranges::find(first, last, 'x') == last, Eq(true));
+}
+
+TEST(AnySentinelTest, counted_iterator_works_as_expected)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3, 4};
+    using Underlying = std::counted_iterator<std::list<int>::iterator>;
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    Iterator first(Underlying(begin(l), 3));
+    sample::any_sentinel<Iterator> last(std::in_place_type<Underlying>,
+        std::default_sentinel);
+    std::vector<int> result;
+    std::ranges::copy(std::ranges::subrange(first, last),
+        std::back_inserter(result));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAre(1, 2, 3));
+}
+
+TEST(AnySentinelTest, end_iterator_usable_as_sentinel)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    std::list<int> l{4, 5};
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    sample::any_sentinel<Iterator> vectorEnd(
+        std::in_place_type<std::vector<int>::iterator>, end(v));
+    sample::any_sentinel<Iterator> listEnd(
+        std::in_place_type<std::list<int>::iterator>, end(l));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::ranges::count_if(Iterator(begin(v)), vectorEnd,
+        [](int i) { return i > 1; }), Eq(2));
+    EXPECT_THAT(std::ranges::distance(Iterator(begin(l)), listEnd), Eq(2));
+    EXPECT_THAT(Iterator(end(l)) == listEnd, Eq(true));
+    EXPECT_THAT(listEnd != Iterator(begin(l)), Eq(true));
+}
+
+TEST(AnySentinelTest, compares_with_category_converted_iterator)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    using Underlying = std::list<int>::iterator;
+    using Iterator = sample::any_forward_iterator<int>;
+    sample::any_bidirectional_iterator<int> stronger(begin(l));
+
+    // WHEN
+    Iterator first(stronger);
+    sample::any_sentinel<Iterator> last(std::in_place_type<Underlying>,
+        end(l));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first == last, Eq(false));
+    EXPECT_THAT(std::ranges::distance(first, last), Eq(3));
+    EXPECT_THAT(Iterator(std::ranges::next(stronger, 3)) == last, Eq(true));
+}
+
+TEST(AnySentinelTest, unreachable_sentinel_never_compares_equal)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    using Iterator = sample::any_forward_iterator<int>;
+
+    // WHEN
+    sample::any_sentinel<Iterator> last;
+    sample::any_sentinel<Iterator> copy(std::unreachable_sentinel);
+    copy = last;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*std::ranges::find(Iterator(begin(l)), last, 3), Eq(3));
+    EXPECT_THAT(Iterator(end(l)) == copy, Eq(false));
+}
+
+TEST(AnySentinelTest, unreachable_sentinel_does_not_allocate)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    using Iterator = sample::any_forward_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    std::pmr::memory_resource *const previous =
+        std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    // WHEN
+    sample::any_sentinel<Iterator> last;
+    sample::any_sentinel<Iterator> copy = last;
+    std::pmr::set_default_resource(previous);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(Iterator(end(l)) == copy, Eq(false));
+    EXPECT_THAT(noexcept(sample::any_sentinel<Iterator>()), Eq(true));
+}
@@ -0,0 +1,125 @@
+#include <benchmarks/sample_benchmarkbaseline.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(BenchmarkBaselineTest, saved_samples_load_back)
+{
+    // GIVEN
+    const sample::baseline::Samples samples = {
+        { "BM_First<int>/200", { 1.5, 2.25, 1e-3 } },
+        { "BM_Second/real_time", { 123456.789012345 } } };
+    std::stringstream stream;
+
+    // WHEN
+    sample::baseline::save(stream, samples);
+    const sample::baseline::Samples loaded = sample::baseline::load(stream);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(loaded, Eq(samples));
+}
+
+TEST(BenchmarkBaselineTest, rejects_streams_that_are_not_baselines)
+{
+    // GIVEN
+    std::istringstream empty;
+    std::istringstream json("{ \"benchmarks\": [] }\n");
+    std::istringstream malformed("# sample benchmark baseline 1\n"
+                                 "BM_First\t1.5\tfast\n");
+
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    EXPECT_THROW(sample::baseline::load(empty), std::runtime_error);
+    EXPECT_THROW(sample::baseline::load(json), std::runtime_error);
+    EXPECT_THROW(sample::baseline::load(malformed), std::runtime_error);
+}
+
+TEST(BenchmarkBaselineTest, median_of_odd_and_even_counts)
+{
+    // GIVEN
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sample::baseline::median({ 3.0, 1.0, 2.0 }), DoubleEq(2.0));
+    EXPECT_THAT(sample::baseline::median({ 4.0, 1.0, 3.0, 2.0 }),
+                DoubleEq(2.5));
+    EXPECT_THAT(sample::baseline::median({}), DoubleEq(0.0));
+}
+
+TEST(BenchmarkBaselineTest, mann_whitney_p_value_matches_normal_approximation)
+{
+    // GIVEN
+    const std::vector<double> low = { 1, 2, 3, 4, 5 };
+    const std::vector<double> high = { 6, 7, 8, 9, 10 };
+    const std::vector<double> tiedLow = { 1, 2, 2, 3, 4 };
+    const std::vector<double> tiedHigh = { 2, 3, 3, 5, 6 };
+
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue(low, high),
+                DoubleNear(0.0121858, 1e-6));
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue(high, low),
+                DoubleNear(0.0121858, 1e-6));
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue(tiedLow, tiedHigh),
+                DoubleNear(0.1988289, 1e-6));
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue(low, low), DoubleEq(1.0));
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue({ 1, 1 }, { 1, 1 }),
+                DoubleEq(1.0));
+    EXPECT_THAT(sample::baseline::mannWhitneyPValue(low, {}), DoubleEq(1.0));
+}
+
+TEST(BenchmarkBaselineTest, reports_significant_slowdowns_and_speedups)
+{
+    // GIVEN
+    const sample::baseline::Samples baseline = {
+        { "BM_Faster", { 20, 21, 22, 20, 21, 22, 20, 21 } },
+        { "BM_Noisy", { 10, 30, 10, 30, 10, 30, 10, 30 } },
+        { "BM_Removed", { 1, 1, 1, 1, 1, 1, 1, 1 } },
+        { "BM_Slower", { 10, 11, 10, 11, 10, 11, 10, 11 } } };
+    const sample::baseline::Samples current = {
+        { "BM_Added", { 1, 1, 1, 1, 1, 1, 1, 1 } },
+        { "BM_Faster", { 15, 16, 15, 16, 15, 16, 15, 16 } },
+        { "BM_Noisy", { 11, 31, 11, 31, 11, 31, 11, 31 } },
+        { "BM_Slower", { 12, 13, 12, 13, 12, 13, 12, 13 } } };
+
+    // WHEN
+    const std::vector<sample::baseline::Comparison> comparisons =
+        sample::baseline::compare(baseline, current);
+    std::ostringstream table;
+    sample::baseline::printSignificant(table, comparisons, 0.05, 0.05);
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(comparisons.size(), Eq(3u));
+    EXPECT_THAT(comparisons[0].d_name, Eq("BM_Faster"));
+    EXPECT_THAT(comparisons[0].d_change, DoubleNear(-0.2619, 1e-4));
+    EXPECT_THAT(comparisons[1].d_name, Eq("BM_Noisy"));
+    EXPECT_THAT(comparisons[2].d_name, Eq("BM_Slower"));
+    EXPECT_THAT(comparisons[2].d_baselineMedian, DoubleEq(10.5));
+    EXPECT_THAT(comparisons[2].d_currentMedian, DoubleEq(12.5));
+
+    EXPECT_THAT(sample::baseline::isSignificant(comparisons[0], 0.05, 0.05),
+                Eq(true));
+    EXPECT_THAT(sample::baseline::isSignificant(comparisons[1], 0.05, 0.05),
+                Eq(false));
+    EXPECT_THAT(sample::baseline::isSignificant(comparisons[2], 0.05, 0.05),
+                Eq(true));
+    EXPECT_THAT(sample::baseline::isSignificant(comparisons[2], 0.05, 0.25),
+                Eq(false));
+
+    const std::string output = table.str();
+    EXPECT_THAT(output, HasSubstr("Significant slowdowns"));
+    EXPECT_THAT(output, HasSubstr("Significant speedups"));
+    EXPECT_THAT(output, HasSubstr("+19.0%"));
+    EXPECT_THAT(output, HasSubstr("-26.2%"));
+    EXPECT_THAT(output, Not(HasSubstr("BM_Noisy")));
+    EXPECT_THAT(output, HasSubstr("1 slower, 1 faster, 1 unchanged"));
+}
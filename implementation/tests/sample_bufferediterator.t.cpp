@@ -0,0 +1,110 @@
+#include <sample_bufferediterator.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(BufferedInputIteratorTest, reads_range_spanning_several_refills)
+{
+    // GIVEN
+    std::list<int> l(100);
+    std::iota(begin(l), end(l), 0);
+    using Iterator = sample::any_input_iterator<int>;
+    using Buffered = sample::buffered_input_iterator<Iterator, 8>;
+
+    // WHEN
+    std::vector<int> result;
+    std::copy(Buffered(Iterator(begin(l)), Iterator(end(l))), Buffered(),
+        std::back_inserter(result));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAreArray(l));
+    EXPECT_THAT((std::input_iterator<Buffered>), Eq(true));
+}
+
+TEST(BufferedInputIteratorTest, empty_range_equals_end)
+{
+    // GIVEN
+    std::vector<int> v;
+    using Iterator = sample::any_input_iterator<int>;
+
+    // WHEN
+    sample::buffered_input_iterator first(Iterator(begin(v)), Iterator(end(v)));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first == decltype(first)(), Eq(true));
+}
+
+TEST(BufferedInputIteratorTest, reads_from_stream)
+{
+    // GIVEN
+    std::istringstream ss("a bb ccc");
+    using Iterator = sample::any_input_iterator<std::string,
+        const std::string&, const std::string*>;
+    using Buffered = sample::buffered_input_iterator<Iterator, 2>;
+
+    // WHEN
+    Buffered first{Iterator(std::istream_iterator<std::string>(ss)),
+        Iterator(std::istream_iterator<std::string>())};
+    std::vector<std::size_t> sizes;
+    std::transform(first, Buffered(), std::back_inserter(sizes),
+        [](const std::string& s) { return s.size(); });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sizes, ElementsAre(1u, 2u, 3u));
+}
+
+TEST(BufferedOutputIteratorTest, flushes_when_full_and_on_destruction)
+{
+    // GIVEN
+    std::vector<int> v;
+    using Buffered = sample::buffered_output_iterator<
+        sample::any_output_iterator<int>, 4>;
+
+    // WHEN
+    {
+        Buffered output(std::back_inserter(v));
+        for (int i = 0; i != 5; ++i) {
+            *output++ = i;
+        }
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(v, ElementsAre(0, 1, 2, 3));
+    }
+    using namespace ::testing;
+    EXPECT_THAT(v, ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT((std::output_iterator<Buffered, int>), Eq(true));
+}
+
+TEST(BufferedOutputIteratorTest, copies_do_not_duplicate_values)
+{
+    // GIVEN
+    std::vector<int> input{1, 2, 3};
+    std::ostringstream ss;
+    using Buffered = sample::buffered_output_iterator<
+        sample::any_output_iterator<int>>;
+
+    // WHEN
+    Buffered output(std::ostream_iterator<int>(ss, ","));
+    Buffered result = std::copy(begin(input), end(input), output);
+    *result = 4;
+    Buffered copy(result);
+    *copy = 5;
+    copy.flush();
+    result.flush();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(ss.str(), StrEq("1,2,3,4,5,"));
+}
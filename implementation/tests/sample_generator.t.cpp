@@ -0,0 +1,223 @@
+#include <sample_generator.hpp>
+#include <sample_algorithm.hpp>
+#include <sample_anyiterator.hpp>
+
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+sample::generator<int> iota(int count)
+    // Yield the integers in `[0, count)`.
+{
+    for (int i = 0; i != count; ++i) {
+        co_yield i;
+    }
+}
+
+sample::generator<int> addressOfYielded(int **address)
+    // Yield a local, after storing its address in `*address`.
+{
+    int value = 42;
+    *address = &value;
+    co_yield value;
+}
+
+sample::generator<std::unique_ptr<int>> pointers(int count)
+    // Yield `count` pointers to the integers in `[0, count)`, which can only
+    // be moved.
+{
+    for (int i = 0; i != count; ++i) {
+        std::unique_ptr<int> pointer = std::make_unique<int>(i);
+        co_yield pointer;
+    }
+}
+
+sample::generator<int> failAfter(int count)
+    // Yield the integers in `[0, count)`, then throw.
+{
+    for (int i = 0; i != count; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("failed");
+}
+
+sample::generator<int> flagOnExit(bool *exited)
+    // Yield integers forever, setting `*exited` once the frame is destroyed.
+{
+    struct Guard {
+        bool *d_exited;
+        ~Guard() { *d_exited = true; }
+    } guard{exited};
+    for (int i = 0;; ++i) {
+        co_yield i;
+    }
+}
+
+sample::batch_generator<int> batches(int count, std::size_t batchSize)
+    // Yield the integers in `[0, count)`, in batches of `batchSize`,
+    // with an empty batch before each.
+{
+    std::vector<int> batch;
+    for (int i = 0; i != count; ++i) {
+        batch.push_back(i);
+        if (batch.size() == batchSize || i + 1 == count) {
+            co_yield std::span<int>();
+            co_yield batch;
+            batch.clear();
+        }
+    }
+}
+
+} // close unnamed namespace
+
+TEST(GeneratorTest, yields_elements_through_any_input_iterator)
+{
+    // GIVEN
+    sample::generator<int> g = iota(5);
+
+    // WHEN
+    sample::any_input_iterator<int> first(g.begin());
+    sample::any_input_iterator<int> last(g.end());
+    std::vector<int> result(first, last);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(GeneratorTest, empty_coroutine_is_empty_range)
+{
+    // GIVEN
+    sample::generator<int> g = iota(0);
+
+    // WHEN
+    auto first = g.begin();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first == g.end(), Eq(true));
+}
+
+TEST(GeneratorTest, yields_by_reference)
+{
+    // GIVEN
+    int *address = nullptr;
+    sample::generator<int> g = addressOfYielded(&address);
+
+    // WHEN
+    sample::any_input_iterator<int> it(g.begin());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(&*it, Eq(address));
+    EXPECT_THAT(*it, Eq(42));
+}
+
+TEST(GeneratorTest, yields_move_only_elements_without_copies)
+{
+    // GIVEN
+    sample::generator<std::unique_ptr<int>> g = pointers(3);
+
+    // WHEN
+    std::vector<int> result;
+    for (std::unique_ptr<int>& pointer : g) {
+        std::unique_ptr<int> taken = std::move(pointer);
+        result.push_back(*taken);
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAre(0, 1, 2));
+}
+
+TEST(GeneratorTest, iterator_is_stored_inline)
+{
+    // GIVEN
+    sample::generator<int> g = iota(3);
+    sample::batch_generator<int> b = batches(3, 2);
+
+    // WHEN
+    sample::any_input_iterator<int> first(std::allocator_arg,
+        std::pmr::null_memory_resource(), g.begin());
+    sample::any_input_iterator<int> batchFirst(std::allocator_arg,
+        std::pmr::null_memory_resource(), b.begin());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*first, Eq(0));
+    EXPECT_THAT(*batchFirst, Eq(0));
+}
+
+TEST(GeneratorTest, increment_rethrows_exception_from_coroutine)
+{
+    // GIVEN
+    sample::generator<int> g = failAfter(2);
+    auto it = g.begin();
+    ++it;
+
+    // WHEN
+    using namespace ::testing;
+    EXPECT_THROW(++it, std::runtime_error);
+
+    // THEN
+    EXPECT_THAT(it == g.end(), Eq(true));
+}
+
+TEST(GeneratorTest, destroying_generator_destroys_unfinished_coroutine)
+{
+    // GIVEN
+    bool exited = false;
+    {
+        sample::generator<int> g = flagOnExit(&exited);
+        sample::any_input_iterator<int> it(g.begin());
+        ++it;
+
+        // WHEN
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(exited, Eq(true));
+}
+
+TEST(BatchGeneratorTest, yields_elements_of_batches)
+{
+    // GIVEN
+    sample::batch_generator<int> b = batches(10, 3);
+
+    // WHEN
+    sample::any_input_iterator<int> first(b.begin());
+    sample::any_input_iterator<int> last(b.end());
+    const int sum = sample::accumulate(first, last, 0);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sum, Eq(45));
+}
+
+TEST(BatchGeneratorTest, yields_elements_in_place)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    auto batch = [](std::vector<int>& v) -> sample::batch_generator<int> {
+        co_yield v;
+    };
+    sample::batch_generator<int> b = batch(v);
+
+    // WHEN
+    for (int& element : b) {
+        element *= 10;
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(v, ElementsAre(10, 20, 30));
+}
@@ -0,0 +1,139 @@
+#include <sample_inlinefit.hpp>
+#include <sample_anyiterator.hpp>
+#include <tests/sample_testsupport.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+using sample::testsupport::Padded;
+
+struct alignas(16) OverAligned {
+    // A forward iterator over nothing, aligned more strictly than a buffer.
+
+    // TYPES
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using reference = const int&;
+    using pointer = const int*;
+
+    // MANIPULATORS
+    OverAligned& operator++() { return *this; }
+    OverAligned operator++(int) { return *this; }
+
+    // ACCESSORS
+    reference operator*() const { return d_value; }
+    pointer operator->() const { return &d_value; }
+    bool operator==(const OverAligned&) const { return true; }
+
+    // DATA
+    int d_value = 0;
+};
+
+using ListIterator = std::list<int>::iterator;
+using Fits = Padded<ListIterator, 56>;       // exactly 64 bytes
+using Spills = Padded<ListIterator, 57>;     // one byte over
+using Forward = sample::any_forward_iterator<int>;
+using ConstForward = sample::any_forward_iterator<const int>;
+
+} // close anonymous namespace
+
+TEST(InlineFitTest, mirrors_buffer_size_and_alignment)
+{
+    // GIVEN
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    static_assert(sizeof(Fits) == 64);
+    static_assert(sample::fits_inline_v<ListIterator, Forward>);
+    static_assert(sample::fits_inline_v<Fits, Forward>);
+    static_assert(!sample::fits_inline_v<Spills, Forward>);
+    static_assert(!sample::fits_inline_v<OverAligned, ConstForward>);
+    static_assert(!sample::fits_inline_v<ListIterator,
+        sample::any_forward_iterator<int, int&, int*, std::ptrdiff_t,
+                                     sample::heap_storage>>);
+    static_assert(sample::fits_inline_v<ListIterator,
+        sample::any_forward_iterator<int, int&, int*, std::ptrdiff_t,
+                                     sample::inline_storage<8>>>);
+    static_assert(!sample::fits_inline_v<Fits,
+        sample::any_forward_iterator<int, int&, int*, std::ptrdiff_t,
+                                     sample::sbo_storage<32>>>);
+
+    using SpillsFit = sample::inline_fit<Spills, Forward>;
+    static_assert(SpillsFit::size == 72);
+    static_assert(SpillsFit::unused_bytes == 64);
+    static_assert(SpillsFit::heap_bytes >= SpillsFit::stored_size);
+    using ListFit = sample::inline_fit<ListIterator, Forward>;
+    static_assert(ListFit::unused_bytes == 64 - sizeof(ListIterator));
+    static_assert(ListFit::heap_bytes == 0);
+}
+
+TEST(InlineFitTest, agrees_with_allocations)
+{
+    // GIVEN
+    std::list<int> l{1, 2};
+    std::pmr::memory_resource *const none = std::pmr::null_memory_resource();
+
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    EXPECT_NO_THROW(Forward(std::allocator_arg, none, Fits{begin(l)}));
+    EXPECT_THROW(Forward(std::allocator_arg, none, Spills{begin(l)}),
+                 std::bad_alloc);
+}
+
+TEST(InlineFitTest, contiguous_iterators_store_their_address)
+{
+    // GIVEN
+    using VectorIterator = std::vector<int>::iterator;
+    using Fit = sample::inline_fit<Padded<VectorIterator, 0>, Forward>;
+    using ContiguousFit = sample::inline_fit<VectorIterator, Forward>;
+
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    static_assert(ContiguousFit::contiguous);
+    static_assert(ContiguousFit::stored_size == sizeof(int*));
+    static_assert(ContiguousFit::is_inline);
+    static_assert(!Fit::contiguous);
+}
+
+TEST(InlineFitTest, report_lists_each_type)
+{
+    // GIVEN
+    using Report = sample::sizing_report<Forward, ListIterator, Spills,
+                                         std::vector<int>::iterator>;
+    std::ostringstream stream;
+
+    // WHEN
+    Report::print(stream);
+
+    // THEN
+    using namespace ::testing;
+    static_assert(!Report::all_inline);
+    static_assert(sample::sizing_report<Forward, ListIterator,
+                                        Fits>::all_inline);
+    static_assert(Report::rows.size() == 3);
+    static_assert(Report::rows[0].d_inline);
+    static_assert(!Report::rows[1].d_inline);
+    static_assert(Report::rows[1].d_size == 72);
+    static_assert(Report::rows[2].d_contiguous);
+    EXPECT_THAT(Report::rows[0].d_type,
+                Eq(sample::type_token::of<ListIterator>().name()));
+
+    const std::string report = stream.str();
+    EXPECT_THAT(report, StartsWith("Inline buffer of 64 bytes\n"));
+    EXPECT_THAT(report, HasSubstr("inline\n"));
+    EXPECT_THAT(report, HasSubstr("heap\n"));
+    EXPECT_THAT(report, HasSubstr("inline, contiguous\n"));
+}
@@ -0,0 +1,117 @@
+#include <sample_iteratorpool.hpp>
+#include <sample_anyiterator.hpp>
+
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(IteratorPool, freed_block_is_reused)
+{
+    // GIVEN
+    std::pmr::memory_resource* const pool = sample::iterator_pool_resource();
+    const sample::iterator_pool_statistics before = sample::iterator_pool_stats();
+
+    // WHEN
+    void* const first = pool->allocate(40);
+    pool->deallocate(first, 40);
+    void* const second = pool->allocate(64);
+    pool->deallocate(second, 64);
+
+    // THEN
+    using namespace ::testing;
+    const sample::iterator_pool_statistics after = sample::iterator_pool_stats();
+    EXPECT_THAT(second, Eq(first));
+    EXPECT_THAT(after.hits - before.hits, Ge(1u));
+    EXPECT_THAT(after.recycled - before.recycled, Eq(2u));
+}
+
+TEST(IteratorPool, large_blocks_bypass_freelists)
+{
+    // GIVEN
+    std::pmr::memory_resource* const pool = sample::iterator_pool_resource();
+    const sample::iterator_pool_statistics before = sample::iterator_pool_stats();
+
+    // WHEN
+    void* const block = pool->allocate(4096);
+    pool->deallocate(block, 4096);
+
+    // THEN
+    using namespace ::testing;
+    const sample::iterator_pool_statistics after = sample::iterator_pool_stats();
+    EXPECT_THAT(after.hits, Eq(before.hits));
+    EXPECT_THAT(after.misses, Eq(before.misses));
+    EXPECT_THAT(after.recycled, Eq(before.recycled));
+}
+
+TEST(IteratorPool, freelists_bounded)
+{
+    // GIVEN
+    std::pmr::memory_resource* const pool = sample::iterator_pool_resource();
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i != 2 * sample::detail::POOL_CACHE_LIMIT; ++i) {
+        blocks.push_back(pool->allocate(256));
+    }
+    const sample::iterator_pool_statistics before = sample::iterator_pool_stats();
+
+    // WHEN
+    for (void* block : blocks) {
+        pool->deallocate(block, 256);
+    }
+
+    // THEN
+    using namespace ::testing;
+    const sample::iterator_pool_statistics after = sample::iterator_pool_stats();
+    EXPECT_THAT(after.released - before.released,
+        Ge(sample::detail::POOL_CACHE_LIMIT));
+}
+
+TEST(IteratorPool, iterator_copies_recycle_blocks)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    Iterator first(std::allocator_arg, sample::iterator_pool_resource(),
+        begin(d));
+    { Iterator warm(first); }
+    const sample::iterator_pool_statistics before = sample::iterator_pool_stats();
+
+    // WHEN
+    for (int i = 0; i != 10; ++i) {
+        Iterator copy(first);
+        ASSERT_THAT(*copy, testing::Eq(1));
+    }
+
+    // THEN
+    using namespace ::testing;
+    const sample::iterator_pool_statistics after = sample::iterator_pool_stats();
+    EXPECT_THAT(after.hits - before.hits, Eq(10u));
+    EXPECT_THAT(after.misses, Eq(before.misses));
+}
+
+TEST(IteratorPool, blocks_returned_on_other_threads)
+{
+    // GIVEN
+    std::deque<int> d{1, 2, 3};
+    using Iterator = sample::any_random_access_iterator<int, int&, int*,
+        std::ptrdiff_t, sample::heap_storage>;
+    std::vector<Iterator> iterators;
+    for (int i = 0; i != 8; ++i) {
+        iterators.emplace_back(std::allocator_arg,
+            sample::iterator_pool_resource(), begin(d) + i % 3);
+    }
+
+    // WHEN
+    sample::iterator_pool_statistics worker;
+    std::thread([&] {
+        iterators.clear();
+        worker = sample::iterator_pool_stats();
+    }).join();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(worker.recycled, Eq(8u));
+}
@@ -0,0 +1,193 @@
+#include <sample_mappedrecords.hpp>
+#include <sample_algorithm.hpp>
+#include <sample_anyiterator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+struct Record {
+    std::int64_t d_key;
+    double       d_value;
+};
+
+class TemporaryFile {
+    // A file in the temporary directory, removed on destruction.
+
+public:
+    // CREATORS
+    explicit TemporaryFile(const std::string& name)
+        : d_path(std::filesystem::temp_directory_path() /
+                 (name + "." + std::to_string(::getpid())))
+    {}
+
+    ~TemporaryFile()
+    {
+        std::error_code ignored;
+        std::filesystem::remove(d_path, ignored);
+    }
+
+    // MANIPULATORS
+    template <typename T>
+    void write(const std::vector<T>& records)
+        // Replace the contents of the file with `records`.
+    {
+        std::ofstream stream(d_path, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(records.data()),
+                     static_cast<std::streamsize>(records.size() *
+                                                  sizeof(T)));
+    }
+
+    // ACCESSORS
+    const std::filesystem::path& path() const { return d_path; }
+
+private:
+    // DATA
+    std::filesystem::path d_path;
+};
+
+std::vector<Record> sortedRecords(std::size_t size)
+{
+    std::vector<Record> records(size);
+    for (std::size_t i = 0; i != size; ++i) {
+        records[i] = { static_cast<std::int64_t>(i * 3), i * 0.5 };
+    }
+    return records;
+}
+
+} // close unnamed namespace
+
+TEST(MappedRecordsTest, maps_records_of_file)
+{
+    // GIVEN
+    TemporaryFile file("sample_mappedrecords_maps");
+    file.write(sortedRecords(1000));
+
+    // WHEN
+    sample::mapped_records<Record> records(file.path());
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(records.size(), Eq(1000u));
+    EXPECT_THAT(records[0].d_key, Eq(0));
+    EXPECT_THAT(records[999].d_key, Eq(2997));
+    EXPECT_THAT(records[999].d_value, DoubleEq(499.5));
+}
+
+TEST(MappedRecordsTest, erased_iterators_refer_to_mapping_inline)
+{
+    // GIVEN
+    TemporaryFile file("sample_mappedrecords_erased");
+    file.write(sortedRecords(1000));
+    sample::mapped_records<Record> records(file.path(),
+                                           sample::access_pattern::random);
+    using It = sample::any_random_access_iterator<const Record>;
+
+    // WHEN
+    It first(std::allocator_arg, std::pmr::null_memory_resource(),
+             records.begin());
+    It last(std::allocator_arg, std::pmr::null_memory_resource(),
+            records.end());
+    const It found = std::lower_bound(first, last, 1500,
+        [](const Record& record, std::int64_t key) {
+            return record.d_key < key;
+        });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(&*found, Eq(&records[500]));
+    EXPECT_THAT(last - first, Eq(1000));
+}
+
+TEST(MappedRecordsTest, algorithms_use_contiguous_kernels)
+{
+    // GIVEN
+    TemporaryFile file("sample_mappedrecords_kernels");
+    std::vector<int> values(4097);
+    for (std::size_t i = 0; i != values.size(); ++i) {
+        values[i] = static_cast<int>(i % 100);
+    }
+    file.write(values);
+    sample::mapped_records<int> records(file.path(),
+                                        sample::access_pattern::sequential);
+    using It = sample::any_random_access_iterator<const int>;
+    It first(records.begin());
+    It last(records.end());
+
+    // WHEN
+    const long long sum = sample::accumulate(first, last, 0ll);
+    const auto count = sample::count(first, last, 42);
+
+    // THEN
+    using namespace ::testing;
+    static_assert(sample::detail::is_reducible_v<It>);
+    EXPECT_THAT(sum, Eq(std::accumulate(values.begin(), values.end(), 0ll)));
+    EXPECT_THAT(count, Eq(std::count(values.begin(), values.end(), 42)));
+}
+
+TEST(MappedRecordsTest, empty_file_has_no_records)
+{
+    // GIVEN
+    TemporaryFile file("sample_mappedrecords_empty");
+    file.write(std::vector<Record>());
+
+    // WHEN
+    sample::mapped_records<Record> records(file.path());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(records.empty(), Eq(true));
+    EXPECT_THAT(records.begin() == records.end(), Eq(true));
+}
+
+TEST(MappedRecordsTest, moving_transfers_mapping)
+{
+    // GIVEN
+    TemporaryFile file("sample_mappedrecords_move");
+    file.write(sortedRecords(10));
+    sample::mapped_records<Record> records(file.path());
+    const Record *data = records.data();
+
+    // WHEN
+    sample::mapped_records<Record> moved(std::move(records));
+    sample::mapped_records<Record> assigned;
+    assigned = std::move(moved);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(assigned.data(), Eq(data));
+    EXPECT_THAT(assigned.size(), Eq(10u));
+    EXPECT_THAT(records.empty(), Eq(true));
+    EXPECT_THAT(moved.empty(), Eq(true));
+}
+
+TEST(MappedRecordsTest, rejects_missing_and_partial_files)
+{
+    // GIVEN
+    TemporaryFile missing("sample_mappedrecords_missing");
+    TemporaryFile partial("sample_mappedrecords_partial");
+    partial.write(std::vector<char>(sizeof(Record) + 1));
+
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    EXPECT_THROW(sample::mapped_records<Record>{missing.path()},
+                 std::system_error);
+    EXPECT_THROW(sample::mapped_records<Record>{partial.path()},
+                 std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+#include <sample_parallelalgorithm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+constexpr std::size_t SIZE = 10007;
+    // Several chunks, of unequal sizes.
+
+} // close unnamed namespace
+
+TEST(ParallelForEachTest, visits_every_element_once)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::deque<int> d(SIZE, 1);
+    using Iterator = sample::any_random_access_iterator<int>;
+
+    // WHEN
+    sample::parallel::for_each(pool, Iterator(begin(d)), Iterator(end(d)),
+        [](int& i) { i *= 2; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::count(begin(d), end(d), 2), Eq(SIZE));
+}
+
+TEST(ParallelForEachTest, scheduler_keeps_estimate_between_calls)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    sample::work_stealing_scheduler scheduler(pool);
+    std::vector<int> v(SIZE, 1);
+    std::vector<int> out(SIZE);
+
+    // WHEN
+    sample::parallel::for_each(scheduler, begin(v), end(v),
+        [](int& i) { i *= 2; });
+    const double cost = scheduler.element_cost();
+    sample::parallel::transform(scheduler, begin(v), end(v), begin(out),
+        [](int i) { return i + 1; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(cost, Gt(0.0));
+    EXPECT_THAT(std::count(begin(out), end(out), 3), Eq(SIZE));
+}
+
+TEST(ParallelTransformTest, transforms_into_erased_output)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::deque<int> d(SIZE);
+    std::iota(begin(d), end(d), 0);
+    std::vector<std::int64_t> v(SIZE);
+    using Iterator = sample::any_random_access_iterator<int>;
+    using Output = sample::any_random_access_iterator<std::int64_t>;
+
+    // WHEN
+    const Output result = sample::parallel::transform(pool,
+        Iterator(begin(d)), Iterator(end(d)), Output(begin(v)),
+        [](int i) { return std::int64_t{i} * i; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result == Output(end(v)), Eq(true));
+    for (std::size_t i = 0; i != SIZE; ++i) {
+        ASSERT_THAT(v[i], Eq(std::int64_t(i) * std::int64_t(i)));
+    }
+}
+
+TEST(ParallelReduceTest, reduces_contiguous_and_other_ranges)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::vector<std::int64_t> v(SIZE);
+    std::iota(begin(v), end(v), 1);
+    std::deque<std::string> d(100, "ab");
+    using Iterator = sample::any_random_access_iterator<std::int64_t>;
+    using Strings = sample::any_random_access_iterator<std::string>;
+
+    // WHEN
+    const std::int64_t sum = sample::parallel::reduce(pool,
+        Iterator(begin(v)), Iterator(end(v)), std::int64_t{5},
+        std::plus<>());
+    const std::int64_t empty = sample::parallel::reduce(pool,
+        Iterator(begin(v)), Iterator(begin(v)), std::int64_t{5},
+        std::plus<>());
+    const std::string joined = sample::parallel::reduce(pool,
+        Strings(begin(d)), Strings(end(d)), std::string("-"),
+        std::plus<>());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sum, Eq(std::int64_t(SIZE) * (SIZE + 1) / 2 + 5));
+    EXPECT_THAT(empty, Eq(5));
+    EXPECT_THAT(joined, StrEq("-" + std::accumulate(begin(d), end(d),
+        std::string())));
+}
+
+TEST(ParallelInclusiveScanTest, matches_sequential_scan)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::deque<int> d(SIZE);
+    std::iota(begin(d), end(d), -100);
+    std::vector<int> expected(SIZE);
+    std::inclusive_scan(begin(d), end(d), begin(expected));
+    using Iterator = sample::any_random_access_iterator<int>;
+
+    // WHEN
+    std::vector<int> result(SIZE);
+    std::vector<int> small(3);
+    sample::parallel::inclusive_scan(pool, Iterator(begin(d)),
+        Iterator(end(d)), begin(result), std::plus<>());
+    sample::parallel::inclusive_scan(pool, Iterator(begin(d)),
+        Iterator(begin(d) + 3), begin(small), std::plus<>());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAreArray(expected));
+    EXPECT_THAT(small, ElementsAre(-100, -199, -297));
+}
+
+TEST(ParallelForEachTest, rethrows_exception_from_chunk)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::vector<int> v(SIZE);
+    using Iterator = sample::any_random_access_iterator<int>;
+
+    // WHEN
+    auto run = [&] {
+        sample::parallel::for_each(pool, Iterator(begin(v)), Iterator(end(v)),
+            [](int& i) {
+                if (i == 0) {
+                    throw std::invalid_argument("zero");
+                }
+            });
+    };
+
+    // THEN
+    EXPECT_THROW(run(), std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+#include <sample_readahead.hpp>
+#include <sample_algorithm.hpp>
+#include <sample_anyiterator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+struct Counter {
+    // An endless input iterator over the integers from zero, which throws on
+    // reaching `d_failAt`, and counts the elements read in `*d_read`.
+
+    // TYPES
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using reference = int;
+    using pointer = void;
+
+    // ACCESSORS
+    int operator*() const
+    {
+        if (d_value == d_failAt) {
+            throw std::runtime_error("failed");
+        }
+        return d_value;
+    }
+
+    bool operator==(const Counter&) const { return false; }
+
+    // MANIPULATORS
+    Counter& operator++()
+    {
+        ++d_value;
+        ++*d_read;
+        return *this;
+    }
+
+    // DATA
+    int          d_value = 0;
+    int          d_failAt = -1;
+    std::size_t *d_read = nullptr;
+};
+
+} // close unnamed namespace
+
+TEST(ReadAheadRangeTest, reads_stream_through_any_input_iterator)
+{
+    // GIVEN
+    std::istringstream stream("one two three four five");
+    sample::read_ahead_range<std::string> range(
+        std::istream_iterator<std::string>(stream),
+        std::istream_iterator<std::string>(), 2);
+
+    // WHEN
+    sample::any_input_iterator<std::string> first(range.begin());
+    sample::any_input_iterator<std::string> last(range.end());
+    std::vector<std::string> result;
+    for (; first != last; ++first) {
+        result.push_back(std::move(*first));
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(result, ElementsAre("one", "two", "three", "four", "five"));
+}
+
+TEST(ReadAheadRangeTest, passes_every_element_through_small_ring)
+{
+    // GIVEN
+    std::vector<int> v(10000);
+    for (std::size_t i = 0; i != v.size(); ++i) {
+        v[i] = static_cast<int>(i);
+    }
+
+    for (const std::size_t depth : { 0, 1, 3, 64 }) {
+        sample::read_ahead_range<int> range(v.begin(), v.end(), depth);
+
+        // WHEN
+        sample::any_input_iterator<int> first(range.begin());
+        sample::any_input_iterator<int> last(range.end());
+        const long long sum = sample::accumulate(first, last, 0ll);
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(sum, Eq(49995000ll));
+    }
+}
+
+TEST(ReadAheadRangeTest, iterator_is_stored_inline)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3};
+    sample::read_ahead_range<int> range(v.begin(), v.end());
+
+    // WHEN
+    sample::any_input_iterator<int> first(std::allocator_arg,
+        std::pmr::null_memory_resource(), range.begin());
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*first, Eq(1));
+}
+
+TEST(ReadAheadRangeTest, stops_endless_source_when_consumer_drops_early)
+{
+    // GIVEN
+    std::size_t read = 0;
+
+    {
+        sample::read_ahead_range<int> range(Counter{0, -1, &read},
+                                            Counter{}, 8);
+        auto it = range.begin();
+        ++it;
+        ++it;
+
+        // WHEN
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(read, Le(2u + 8u + 1u));
+}
+
+TEST(ReadAheadRangeTest, rethrows_source_exception_after_earlier_elements)
+{
+    // GIVEN
+    std::size_t read = 0;
+    sample::read_ahead_range<int> range(Counter{0, 3, &read}, Counter{}, 16);
+
+    // WHEN
+    std::vector<int> result;
+    auto it = range.begin();
+    using namespace ::testing;
+    EXPECT_THROW({
+        for (; it != range.end(); ++it) {
+            result.push_back(*it);
+        }
+    }, std::runtime_error);
+
+    // THEN
+    EXPECT_THAT(result, ElementsAre(0, 1, 2));
+    EXPECT_THAT(it == range.end(), Eq(true));
+}
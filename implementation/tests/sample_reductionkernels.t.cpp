@@ -0,0 +1,134 @@
+#include <sample_reductionkernels.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+std::vector<sample::simd_level> supportedLevels()
+    // Return the levels whose kernels may be run on this processor.
+{
+    std::vector<sample::simd_level> levels;
+    for (auto level : { sample::simd_level::scalar,
+                        sample::simd_level::sse42,
+                        sample::simd_level::avx2,
+                        sample::simd_level::avx512 }) {
+        if (level <= sample::active_simd_level()) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+template <typename T>
+std::vector<T> randomValues(std::size_t size, std::mt19937& generator)
+    // Return `size` values drawn from a small range, so that the values
+    // searched for occur several times.
+{
+    std::uniform_int_distribution<int> distribution(-20, 20);
+    std::vector<T> values(size);
+    for (T& value : values) {
+        value = static_cast<T>(distribution(generator));
+    }
+    return values;
+}
+
+template <typename T>
+void expectKernelsMatchStandardAlgorithms()
+{
+    std::mt19937 generator(15);
+    for (const sample::simd_level level : supportedLevels()) {
+        const auto& kernels = sample::detail::reductionKernels<T>(level);
+        for (const std::size_t size : { 0, 1, 7, 31, 64, 65, 1000 }) {
+            const std::vector<T> v = randomValues<T>(size, generator);
+            const T* const first = v.data();
+            const T* const last = first + size;
+            SCOPED_TRACE(testing::Message() << "level "
+                << static_cast<int>(level) << ", size " << size);
+
+            using namespace ::testing;
+            EXPECT_THAT(kernels.sum(first, last),
+                Eq(std::accumulate(first, last, T{})));
+            EXPECT_THAT(kernels.count(first, last, T{3}),
+                Eq(std::count(first, last, T{3})));
+            EXPECT_THAT(kernels.find(first, last, T{3}),
+                Eq(std::find(first, last, T{3})));
+            EXPECT_THAT(kernels.find(first, last, T{100}), Eq(last));
+            EXPECT_THAT(kernels.minElement(first, last),
+                Eq(std::min_element(first, last)));
+            EXPECT_THAT(kernels.maxElement(first, last),
+                Eq(std::max_element(first, last)));
+        }
+    }
+}
+
+template <typename T>
+void expectKernelsHandleNaN()
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    for (const sample::simd_level level : supportedLevels()) {
+        const auto& kernels = sample::detail::reductionKernels<T>(level);
+        for (const std::size_t position : { 0, 5, 40, 99 }) {
+            std::vector<T> v(100);
+            std::iota(v.begin(), v.end(), T{-50});
+            v[position] = nan;
+            const T* const first = v.data();
+            const T* const last = first + v.size();
+            SCOPED_TRACE(testing::Message() << "level "
+                << static_cast<int>(level) << ", position " << position);
+
+            using namespace ::testing;
+            EXPECT_THAT(std::isnan(kernels.sum(first, last)), Eq(true));
+            EXPECT_THAT(kernels.count(first, last, nan), Eq(0));
+            EXPECT_THAT(kernels.find(first, last, nan), Eq(last));
+            EXPECT_THAT(kernels.minElement(first, last),
+                Eq(std::min_element(first, last)));
+            EXPECT_THAT(kernels.maxElement(first, last),
+                Eq(std::max_element(first, last)));
+        }
+    }
+}
+
+} // close unnamed namespace
+
+TEST(ReductionKernelsTest, kernels_match_standard_algorithms)
+{
+    expectKernelsMatchStandardAlgorithms<int>();
+    expectKernelsMatchStandardAlgorithms<std::int64_t>();
+    expectKernelsMatchStandardAlgorithms<float>();
+    expectKernelsMatchStandardAlgorithms<double>();
+}
+
+TEST(ReductionKernelsTest, kernels_handle_nan_as_standard_algorithms)
+{
+#if __FINITE_MATH_ONLY__
+    GTEST_SKIP() << "NaN comparisons are not preserved with -ffinite-math-only";
+#endif
+    expectKernelsHandleNaN<float>();
+    expectKernelsHandleNaN<double>();
+}
+
+TEST(ReductionKernelsTest, integer_sums_wrap)
+{
+    // GIVEN
+    std::vector<int> v(100, std::numeric_limits<int>::max());
+
+    // WHEN
+    std::vector<int> sums;
+    for (const sample::simd_level level : supportedLevels()) {
+        const auto& kernels = sample::detail::reductionKernels<int>(level);
+        sums.push_back(kernels.sum(v.data(), v.data() + v.size()));
+    }
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(sums, Each(Eq(-100)));
+}
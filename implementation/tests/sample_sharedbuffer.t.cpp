@@ -0,0 +1,278 @@
+#include <sample_sharedbuffer.hpp>
+#include <sample_anyiterator.hpp>
+#include <sample_inlinefit.hpp>
+#include <tests/sample_testsupport.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+using sample::testsupport::CountingResource;
+using sample::testsupport::Padded;
+
+struct Counter {
+    // A value on which to exercise a `SharedBuffer`.
+
+    // CREATORS
+    explicit Counter(int value) : d_value(value) {}
+    virtual ~Counter() = default;
+
+    // DATA
+    int d_value;
+};
+
+struct Large : Counter {
+    // A `Counter` too large to be held inline.
+
+    // CREATORS
+    using Counter::Counter;
+
+    // DATA
+    std::array<std::byte, 64> d_padding{};
+};
+
+using ListIterator = std::list<int>::iterator;
+using Shared = sample::any_forward_iterator<int, int&, int*, std::ptrdiff_t,
+                                            sample::shared_storage<>>;
+using SharedOnHeap = sample::any_random_access_iterator<int, int&, int*,
+    std::ptrdiff_t, sample::shared_storage<0, false>>;
+
+} // close anonymous namespace
+
+TEST(SharedBufferTest, copies_share_until_modified)
+{
+    // GIVEN
+    using Buffer = sample::detail::SharedBuffer<Counter, 0, false>;
+    CountingResource resource;
+
+    {
+        Buffer buffer(std::allocator_arg, &resource,
+                      std::in_place_type<Counter>, 1);
+
+        // WHEN
+        Buffer copy(buffer);
+        Buffer other(buffer);
+        const bool sharedBefore = copy.isShared();
+        copy.unshare().d_value = 2;
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(sharedBefore, Eq(true));
+        EXPECT_THAT(resource.d_allocations, Eq(2));
+        EXPECT_THAT(copy->d_value, Eq(2));
+        EXPECT_THAT(buffer->d_value, Eq(1));
+        EXPECT_THAT(other.operator->(), Eq(buffer.operator->()));
+        EXPECT_THAT(copy.isShared(), Eq(false));
+        EXPECT_THAT(buffer.isShared(), Eq(true));
+    }
+
+    using namespace ::testing;
+    EXPECT_THAT(resource.d_deallocations, Eq(2));
+}
+
+TEST(SharedBufferTest, sole_owner_modifies_in_place)
+{
+    // GIVEN
+    using Buffer = sample::detail::SharedBuffer<Counter, 0>;
+    CountingResource resource;
+    Buffer buffer(std::allocator_arg, &resource, std::in_place_type<Counter>,
+                  1);
+    Counter *const original = buffer.operator->();
+
+    // WHEN
+    {
+        Buffer copy(buffer);
+        Buffer moved(std::move(copy));
+    }
+    buffer.unshare().d_value = 2;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(buffer.operator->(), Eq(original));
+    EXPECT_THAT(buffer->d_value, Eq(2));
+    EXPECT_THAT(resource.d_allocations, Eq(1));
+}
+
+TEST(SharedBufferTest, assignment_and_swap_exchange_shares)
+{
+    // GIVEN
+    using Buffer = sample::detail::SharedBuffer<Counter, sizeof(Counter)>;
+    Buffer inlined(std::in_place_type<Counter>, 1);
+    Buffer heap(std::in_place_type<Large>, 2);
+    Buffer first(std::in_place_type<Counter>, 3);
+    Buffer second(std::in_place_type<Counter>, 4);
+
+    // WHEN
+    first = heap;
+    second = inlined;
+    swap(first, second);
+    const bool sharedAfterSwap = second.isShared();
+    second = second;
+    heap = Buffer(std::in_place_type<Counter>, 5);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first->d_value, Eq(1));
+    EXPECT_THAT(second->d_value, Eq(2));
+    EXPECT_THAT(sharedAfterSwap, Eq(true));
+    EXPECT_THAT(second.isShared(), Eq(false));
+    EXPECT_THAT(heap->d_value, Eq(5));
+    EXPECT_THAT(inlined.isShared(), Eq(false));
+}
+
+TEST(SharedStorageTest, copies_allocate_only_when_advanced)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    CountingResource resource;
+
+    {
+        Shared first(std::allocator_arg, &resource,
+                     Padded<ListIterator>{begin(l)});
+
+        // WHEN
+        Shared copy = first;
+        Shared other = copy;
+        const int before = resource.d_allocations;
+        ++copy;
+        ++copy;
+
+        // THEN
+        using namespace ::testing;
+        EXPECT_THAT(before, Eq(1));
+        EXPECT_THAT(resource.d_allocations, Eq(2));
+        EXPECT_THAT(*first, Eq(1));
+        EXPECT_THAT(*other, Eq(1));
+        EXPECT_THAT(*copy, Eq(3));
+        EXPECT_THAT(first == other, Eq(true));
+    }
+
+    using namespace ::testing;
+    EXPECT_THAT(resource.d_deallocations, Eq(2));
+}
+
+TEST(SharedStorageTest, target_is_unshared)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    Shared first(Padded<ListIterator>{begin(l)});
+    Shared copy = first;
+
+    // WHEN
+    ++copy.target<Padded<ListIterator>>()->d_it;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*first, Eq(1));
+    EXPECT_THAT(*copy, Eq(2));
+    EXPECT_THAT(noexcept(copy.target<int>()), Eq(false));
+    EXPECT_THAT(noexcept(sample::any_forward_iterator<int>().target<int>()),
+                Eq(true));
+}
+
+TEST(SharedStorageTest, contiguous_cursor_is_unshared)
+{
+    // GIVEN
+    std::vector<int> v{1, 2, 3, 4};
+    CountingResource resource;
+    SharedOnHeap first(std::allocator_arg, &resource, begin(v));
+
+    // WHEN
+    SharedOnHeap copy = first;
+    copy += 2;
+    SharedOnHeap last = copy;
+    --last;
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(*first, Eq(1));
+    EXPECT_THAT(*copy, Eq(3));
+    EXPECT_THAT(*last, Eq(2));
+    EXPECT_THAT(copy - first, Eq(2));
+    EXPECT_THAT(resource.d_allocations, Eq(3));
+}
+
+TEST(SharedStorageTest, algorithms_see_independent_copies)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3, 3, 4, 1, 2, 3, 5};
+    const std::list<int> needle{1, 2, 3, 5};
+    using Iterator = Padded<ListIterator>;
+    using Sbo = sample::any_forward_iterator<int>;
+    CountingResource sharedResource;
+    CountingResource sboResource;
+
+    // WHEN
+    const Shared first(std::allocator_arg, &sharedResource,
+                       Iterator{begin(l)});
+    const Shared last(std::allocator_arg, &sharedResource, Iterator{end(l)});
+    const Sbo sboFirst(std::allocator_arg, &sboResource, Iterator{begin(l)});
+    const Sbo sboLast(std::allocator_arg, &sboResource, Iterator{end(l)});
+    const int sharedBefore = sharedResource.d_allocations;
+    const int sboBefore = sboResource.d_allocations;
+
+    const Shared adjacent = std::adjacent_find(first, last);
+    const Shared found = std::search(first, last, begin(needle),
+                                     end(needle));
+    const Sbo sboFound = std::search(sboFirst, sboLast, begin(needle),
+                                     end(needle));
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(std::distance(first, adjacent), Eq(2));
+    EXPECT_THAT(std::distance(first, found), Eq(5));
+    EXPECT_THAT(std::distance(sboFirst, sboFound), Eq(5));
+    EXPECT_THAT(sharedResource.d_allocations - sharedBefore,
+                Lt(sboResource.d_allocations - sboBefore));
+}
+
+TEST(SharedStorageTest, copies_modified_on_other_threads)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    const Shared first(Padded<ListIterator>{begin(l)});
+    int sums[4] = {};
+
+    // WHEN
+    std::vector<std::thread> workers;
+    for (int& sum : sums) {
+        workers.emplace_back([&sum, first] {
+            for (int i = 0; i != 100; ++i) {
+                Shared it = first;
+                sum += *++it;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // THEN
+    using namespace ::testing;
+    for (int sum : sums) {
+        EXPECT_THAT(sum, Eq(200));
+    }
+    EXPECT_THAT(*first, Eq(1));
+}
+
+TEST(SharedStorageTest, inline_fit_reports_shared_header)
+{
+    // GIVEN
+    // WHEN
+    // THEN
+    using namespace ::testing;
+    using Fit = sample::inline_fit<Padded<ListIterator>, Shared>;
+    static_assert(!Fit::is_inline);
+    static_assert(Fit::heap_bytes == Fit::stored_size + 2 * sizeof(void*));
+    static_assert(sample::fits_inline_v<ListIterator, Shared>);
+}
@@ -236,3 +236,95 @@ TEST(SmallBuffer, large_derived_movable)
     using namespace ::testing;
     ASSERT_THAT(dynamic_cast<test::TestDerived&>(*buffer2), Eq(test));
 }
+
+TEST(SmallBuffer, large_base_convertible_to_larger_buffer)
+{
+    // GIVEN
+    test::TestDerived test{1, 2, 3, 4, 5, 6};
+    using SmallBufferType = sample::detail::SmallBuffer<test::TestBase, 
+        sizeof(test) - (2u * sizeof(int))>;
+    using LargeBufferType = sample::detail::SmallBuffer<test::TestBase,
+        2u * sizeof(test)>;
+    SmallBufferType buffer(std::in_place_type<decltype(test)>, test);
+
+    // WHEN
+    LargeBufferType copied(buffer);
+    LargeBufferType moved(std::move(buffer));
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*copied), Eq(test));
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*moved), Eq(test));
+}
+
+TEST(SmallBuffer, holds_one_lifecycle_pointer)
+{
+    // GIVEN
+    using BufferType = sample::detail::SmallBuffer<test::TestBase, 64u>;
+
+    // THEN
+    using namespace ::testing;
+    // The lifecycle table, the held object and the memory resource.
+    EXPECT_THAT(sizeof(BufferType), Le(64u + 3u * sizeof(void*)));
+}
+
+TEST(SmallBuffer, large_derived_move_takes_heap_address)
+{
+    // GIVEN
+    test::TestDerived test{1, 2, 3, 4, 5, 6};
+    using BufferType = sample::detail::SmallBuffer<test::TestBase, 
+        sizeof(test) - (2u * sizeof(int))>;
+    BufferType buffer(std::in_place_type<decltype(test)>, test);
+    test::TestBase* const address = &*buffer;
+
+    // WHEN
+    BufferType buffer2(std::move(buffer));
+
+    // THEN
+    using namespace ::testing;
+    static_assert(std::is_nothrow_move_constructible_v<BufferType>);
+    ASSERT_THAT(&*buffer2, Eq(address));
+}
+
+TEST(SmallBuffer, large_derived_swap_exchanges_heap_addresses)
+{
+    // GIVEN
+    test::TestDerived first{1, 2, 3, 4, 5, 6};
+    test::TestDerived second{7, 8, 9, 10, 11, 12};
+    using BufferType = sample::detail::SmallBuffer<test::TestBase, 
+        sizeof(first) - (2u * sizeof(int))>;
+    BufferType buffer(std::in_place_type<test::TestDerived>, first);
+    BufferType buffer2(std::in_place_type<test::TestDerived>, second);
+    test::TestBase* const address = &*buffer;
+    test::TestBase* const address2 = &*buffer2;
+
+    // WHEN
+    swap(buffer, buffer2);
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(&*buffer, Eq(address2));
+    ASSERT_THAT(&*buffer2, Eq(address));
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*buffer), Eq(second));
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*buffer2), Eq(first));
+}
+
+TEST(SmallBuffer, small_derived_swappable_with_large_derived)
+{
+    // GIVEN
+    test::TestBase small{1, 2, 3};
+    test::TestDerived large{4, 5, 6, 7, 8, 9};
+    using BufferType = sample::detail::SmallBuffer<test::TestBase, 
+        sizeof(small)>;
+    BufferType buffer(std::in_place_type<test::TestBase>, small);
+    BufferType buffer2(std::in_place_type<test::TestDerived>, large);
+
+    // WHEN
+    swap(buffer, buffer2);
+    buffer2 = buffer;
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*buffer), Eq(large));
+    ASSERT_THAT(dynamic_cast<test::TestDerived&>(*buffer2), Eq(large));
+}
@@ -0,0 +1,95 @@
+#include <sample_splitrange.hpp>
+#include <sample_anyrange.hpp>
+
+#include <deque>
+#include <list>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+template <typename Piece>
+std::vector<int> elements(const Piece& piece)
+{
+    return std::vector<int>(piece.begin(), piece.end());
+}
+
+} // close unnamed namespace
+
+TEST(SplitTest, splits_random_access_range_into_balanced_parts)
+{
+    // GIVEN
+    std::deque<int> d(10);
+    std::iota(begin(d), end(d), 0);
+    const sample::any_random_access_range<int> range(d);
+
+    // WHEN
+    const auto parts = sample::split(range, 3);
+
+    // THEN
+    using namespace ::testing;
+    ASSERT_THAT(parts.size(), Eq(3u));
+    EXPECT_THAT(elements(parts[0]), ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(elements(parts[1]), ElementsAre(4, 5, 6));
+    EXPECT_THAT(elements(parts[2]), ElementsAre(7, 8, 9));
+    EXPECT_THAT(parts[1].size(), Eq(3u));
+    EXPECT_THAT(parts[2].offset(), Eq(7u));
+    EXPECT_THAT(&*parts[2].begin(), Eq(&d[7]));
+}
+
+TEST(SplitTest, splits_sized_forward_range)
+{
+    // GIVEN
+    std::list<int> l{0, 1, 2, 3, 4};
+    const sample::any_forward_range<int> range(l);
+
+    // WHEN
+    const auto parts = sample::split(range, 2);
+    const auto subparts = sample::split(parts[0], 2);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(elements(parts[0]), ElementsAre(0, 1, 2));
+    EXPECT_THAT(elements(parts[1]), ElementsAre(3, 4));
+    EXPECT_THAT(elements(subparts[0]), ElementsAre(0, 1));
+    EXPECT_THAT(elements(subparts[1]), ElementsAre(2));
+    EXPECT_THAT(subparts[1].offset(), Eq(2u));
+    EXPECT_THAT(&*parts[1].begin(), Eq(&*std::next(begin(l), 3)));
+}
+
+TEST(SplitTest, splits_short_range_with_empty_parts)
+{
+    // GIVEN
+    std::vector<int> v{1, 2};
+    const sample::any_random_access_range<int> range(v);
+
+    // WHEN
+    const auto parts = sample::split(range, 4);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(elements(parts[0]), ElementsAre(1));
+    EXPECT_THAT(elements(parts[1]), ElementsAre(2));
+    EXPECT_THAT(parts[2].empty(), Eq(true));
+    EXPECT_THAT(parts[3].empty(), Eq(true));
+}
+
+TEST(BisectTest, halves_split_range)
+{
+    // GIVEN
+    std::list<int> l{0, 1, 2, 3, 4};
+    const sample::split_range<std::list<int>::iterator> range(begin(l),
+        end(l), l.size(), 10);
+
+    // WHEN
+    const auto [first, second] = sample::bisect(range);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(elements(first), ElementsAre(0, 1, 2));
+    EXPECT_THAT(elements(second), ElementsAre(3, 4));
+    EXPECT_THAT(second.offset(), Eq(13u));
+}
@@ -0,0 +1,218 @@
+#include <sample_stats.hpp>
+#include <sample_anyiterator.hpp>
+#include <sample_anyrange.hpp>
+#include <tests/sample_testsupport.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+
+template <typename It>
+using Padded = sample::testsupport::Padded<It, 96,
+    std::bidirectional_iterator_tag>;
+    // A bidirectional iterator forwarding to an `It`, which never fits
+    // inline.
+
+std::uint64_t delta(const sample::stats_snapshot& before,
+                    const sample::stats_snapshot& after,
+                    sample::type_token type, sample::stats_counter counter)
+    // Returns the growth of the count of `counter` for `type` from `before`
+    // to `after`.
+{
+    const sample::type_stats *first = before.find(type);
+    const sample::type_stats *last = after.find(type);
+    return (last ? (*last)[counter] : 0) - (first ? (*first)[counter] : 0);
+}
+
+} // close anonymous namespace
+
+TEST(StatsTest, empty_unless_enabled)
+{
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    sample::any_forward_iterator<int> it(begin(l));
+
+    // WHEN
+    ++it;
+    const sample::stats_snapshot snapshot = sample::stats();
+
+    // THEN
+    using namespace ::testing;
+    if (sample::stats_enabled) {
+        EXPECT_THAT(snapshot.types().empty(), Eq(false));
+    } else {
+        EXPECT_THAT(snapshot.types().empty(), Eq(true));
+        EXPECT_THAT(snapshot.total(sample::stats_counter::increment), Eq(0u));
+    }
+}
+
+TEST(StatsTest, counts_dispatches_by_underlying_type)
+{
+    if (!sample::stats_enabled) {
+        GTEST_SKIP() << "SAMPLE_ANYITERATOR_STATS is not defined";
+    }
+
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    std::vector<int> v{1, 2, 3};
+    using ListIterator = std::list<int>::iterator;
+    const sample::type_token list = sample::type_token::of<ListIterator>();
+    const sample::type_token pointer = sample::type_token::of<int*>();
+    sample::any_bidirectional_iterator<int> first(begin(l));
+    sample::any_bidirectional_iterator<int> last(end(l));
+    sample::any_bidirectional_iterator<int> contiguous(begin(v));
+    const sample::stats_snapshot before = sample::stats();
+
+    // WHEN
+    int sum = 0;
+    for (auto it = first; it != last; ++it) {
+        sum += *it;
+    }
+    --last;
+    sum += *++contiguous;
+    const sample::stats_snapshot after = sample::stats();
+
+    // THEN
+    using namespace ::testing;
+    using sample::stats_counter;
+    EXPECT_THAT(sum, Eq(8));
+    EXPECT_THAT(delta(before, after, list, stats_counter::dereference),
+                Eq(3u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::increment), Eq(3u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::equal), Eq(4u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::decrement), Eq(1u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::clone), Eq(1u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::spill), Eq(0u));
+    EXPECT_THAT(delta(before, after, pointer, stats_counter::dereference),
+                Eq(0u));
+    EXPECT_THAT(delta(before, after, pointer, stats_counter::increment),
+                Eq(0u));
+    ASSERT_THAT(after.find(list), NotNull());
+    EXPECT_THAT(after.find(list)->dispatches(),
+                Ge(after.find(list)->operator[](stats_counter::increment)));
+}
+
+TEST(StatsTest, range_loop_dispatches_once_per_element)
+{
+    if (!sample::stats_enabled) {
+        GTEST_SKIP() << "SAMPLE_ANYITERATOR_STATS is not defined";
+    }
+
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    const sample::type_token list =
+        sample::type_token::of<std::list<int>::iterator>();
+    const sample::any_bidirectional_range<int> range(l);
+    const sample::stats_snapshot before = sample::stats();
+
+    // WHEN
+    int sum = 0;
+    for (int element : range) {
+        sum += element;
+    }
+    const sample::stats_snapshot after = sample::stats();
+
+    // THEN
+    using namespace ::testing;
+    using sample::stats_counter;
+    EXPECT_THAT(sum, Eq(6));
+    EXPECT_THAT(delta(before, after, list, stats_counter::equal), Eq(4u));
+    EXPECT_THAT(delta(before, after, list, stats_counter::clone), Eq(0u));
+    ASSERT_THAT(after.find(list), NotNull());
+    EXPECT_THAT(after.find(list)->dispatches() -
+                (before.find(list) ? before.find(list)->dispatches() : 0),
+                Eq(3u * l.size() + 1u));
+}
+
+TEST(StatsTest, counts_clones_moves_and_spills)
+{
+    if (!sample::stats_enabled) {
+        GTEST_SKIP() << "SAMPLE_ANYITERATOR_STATS is not defined";
+    }
+
+    // GIVEN
+    std::list<int> l{1, 2, 3};
+    using Spilled = Padded<std::list<int>::iterator>;
+    const sample::type_token spilled = sample::type_token::of<Spilled>();
+    const sample::stats_snapshot before = sample::stats();
+
+    // WHEN
+    sample::any_bidirectional_iterator<int> it(Spilled{begin(l)});
+    sample::any_bidirectional_iterator<int> copy(it);
+    sample::any_bidirectional_iterator<int> moved(std::move(copy));
+    const sample::stats_snapshot after = sample::stats();
+
+    // THEN
+    using namespace ::testing;
+    using sample::stats_counter;
+    EXPECT_THAT(delta(before, after, spilled, stats_counter::spill), Eq(2u));
+    EXPECT_THAT(delta(before, after, spilled, stats_counter::clone), Eq(1u));
+    EXPECT_THAT(delta(before, after, spilled, stats_counter::move), Eq(1u));
+    EXPECT_THAT(delta(before, after, spilled, stats_counter::heap_bytes),
+                Ge(2 * sizeof(Spilled)));
+}
+
+TEST(StatsTest, gathers_counts_of_other_threads)
+{
+    if (!sample::stats_enabled) {
+        GTEST_SKIP() << "SAMPLE_ANYITERATOR_STATS is not defined";
+    }
+
+    // GIVEN
+    std::list<char> l{'a', 'b'};
+    const sample::type_token list =
+        sample::type_token::of<std::list<char>::iterator>();
+    const sample::stats_snapshot before = sample::stats();
+
+    // WHEN
+    std::thread worker([&l] {
+        for (int i = 0; i != 100; ++i) {
+            sample::any_forward_iterator<char> it(begin(l));
+            ++it;
+        }
+    });
+    worker.join();
+    const sample::stats_snapshot after = sample::stats();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(delta(before, after, list, sample::stats_counter::increment),
+                Eq(100u));
+}
+
+TEST(StatsTest, prints_text_and_json)
+{
+    // GIVEN
+    sample::type_stats entry(sample::type_token::of<int*>());
+    entry.add(sample::stats_counter::increment, 5);
+    entry.add(sample::stats_counter::heap_bytes, 64);
+    const sample::stats_snapshot snapshot({ entry });
+    std::ostringstream text;
+    std::ostringstream json;
+    std::ostringstream empty;
+
+    // WHEN
+    snapshot.print(text);
+    snapshot.print_json(json);
+    sample::stats_snapshot().print_json(empty);
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(text.str(), Eq("int*: increment=5 heap_bytes=64\n"));
+    EXPECT_THAT(json.str(), Eq("{\"types\": [\n"
+                               "  {\"type\": \"int*\", \"counts\": "
+                               "{\"increment\": 5, \"heap_bytes\": 64}}\n"
+                               "]}\n"));
+    EXPECT_THAT(empty.str(), Eq("{\"types\": []}\n"));
+    EXPECT_THAT(sample::to_string(sample::stats_counter::for_each),
+                Eq("for_each"));
+}
@@ -0,0 +1,82 @@
+#ifndef SAMPLE_TESTSUPPORT
+#define SAMPLE_TESTSUPPORT
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+
+namespace sample {
+namespace testsupport {
+
+struct CountingResource : std::pmr::memory_resource {
+    // A memory resource counting the allocations and deallocations made
+    // through it, which it forwards to `std::pmr::new_delete_resource()`.
+
+    // DATA
+    int d_allocations = 0;
+    int d_deallocations = 0;
+
+private:
+    // PRIVATE MANIPULATORS
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++d_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override
+    {
+        ++d_deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    // PRIVATE ACCESSORS
+    bool do_is_equal(const std::pmr::memory_resource& other) const
+        noexcept override
+    {
+        return this == &other;
+    }
+};
+
+template <typename It, std::size_t Bytes = 96,
+          typename Category = std::forward_iterator_tag>
+struct Padded {
+    // An iterator of the given `Category`, which must be forward or
+    // bidirectional, forwarding to an `It` followed by `Bytes` bytes of
+    // padding.  With the default padding it never fits inline.
+
+    // TYPES
+    using iterator_category = Category;
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using reference = typename std::iterator_traits<It>::reference;
+    using pointer = typename std::iterator_traits<It>::pointer;
+
+    // MANIPULATORS
+    Padded& operator++() { ++d_it; return *this; }
+    Padded operator++(int) { Padded tmp(*this); ++d_it; return tmp; }
+
+    template <typename C = Category, typename = std::enable_if_t<
+        std::is_base_of_v<std::bidirectional_iterator_tag, C>>>
+    Padded& operator--() { --d_it; return *this; }
+    template <typename C = Category, typename = std::enable_if_t<
+        std::is_base_of_v<std::bidirectional_iterator_tag, C>>>
+    Padded operator--(int) { Padded tmp(*this); --d_it; return tmp; }
+
+    // ACCESSORS
+    reference operator*() const { return *d_it; }
+    pointer operator->() const { return &*d_it; }
+    bool operator==(const Padded& rhs) const { return d_it == rhs.d_it; }
+
+    // DATA
+    It                           d_it;
+    std::array<std::byte, Bytes> d_padding{};
+};
+
+} // close namespace testsupport
+} // close namespace sample
+
+#endif // SAMPLE_TESTSUPPORT
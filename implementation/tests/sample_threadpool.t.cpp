@@ -0,0 +1,80 @@
+#include <sample_threadpool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(ThreadPoolTest, runs_every_task_once)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    std::vector<std::atomic<int>> calls(1000);
+
+    // WHEN
+    pool.run(calls.size(), [&](std::size_t i) { ++calls[i]; });
+    pool.run(calls.size(), [&](std::size_t i) { ++calls[i]; });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(pool.concurrency(), Eq(4u));
+    for (const std::atomic<int>& count : calls) {
+        EXPECT_THAT(count.load(), Eq(2));
+    }
+}
+
+TEST(ThreadPoolTest, runs_on_calling_thread_without_workers)
+{
+    // GIVEN
+    sample::thread_pool pool(0);
+    std::vector<std::size_t> order;
+
+    // WHEN
+    pool.run(3, [&](std::size_t i) { order.push_back(i); });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(order, ElementsAre(0u, 1u, 2u));
+}
+
+TEST(ThreadPoolTest, rethrows_exception_from_task)
+{
+    // GIVEN
+    sample::thread_pool pool(2);
+    std::atomic<int> calls{0};
+
+    // WHEN
+    auto run = [&] {
+        pool.run(100, [&](std::size_t i) {
+            ++calls;
+            if (i == 10) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    };
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THROW(run(), std::runtime_error);
+    EXPECT_THAT(calls.load(), Le(100));
+    pool.run(1, [&](std::size_t) { calls = -1; });
+    EXPECT_THAT(calls.load(), Eq(-1));
+}
+
+TEST(ThreadPoolTest, runs_nested_jobs_inline)
+{
+    // GIVEN
+    sample::thread_pool pool(2);
+    std::atomic<int> calls{0};
+
+    // WHEN
+    pool.run(8, [&](std::size_t) {
+        pool.run(8, [&](std::size_t) { ++calls; });
+    });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(calls.load(), Eq(64));
+}
@@ -0,0 +1,116 @@
+#include <sample_workstealingscheduler.hpp>
+#include <sample_anyrange.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(WorkStealingSchedulerTest, covers_range_with_disjoint_pieces)
+{
+    // GIVEN
+    sample::thread_pool pool(3);
+    sample::work_stealing_scheduler scheduler(pool,
+        std::chrono::microseconds(20));
+    std::vector<int> v(100000);
+    std::vector<std::atomic<int>> visits(v.size());
+    const sample::any_random_access_range<int> range(v);
+    using Piece = sample::split_range<
+        sample::any_random_access_range<int>::iterator>;
+
+    // WHEN
+    std::atomic<std::size_t> pieces{0};
+    scheduler.run(range, [&](const Piece& piece) {
+        ++pieces;
+        std::size_t offset = piece.offset();
+        for (int& element : piece) {
+            EXPECT_THAT(&element, ::testing::Eq(&v[offset]));
+            ++visits[offset++];
+        }
+    });
+
+    // THEN
+    using namespace ::testing;
+    for (const std::atomic<int>& count : visits) {
+        ASSERT_THAT(count.load(), Eq(1));
+    }
+    EXPECT_THAT(pieces.load(), Gt(1u));
+    EXPECT_THAT(scheduler.element_cost(), Gt(0.0));
+}
+
+TEST(WorkStealingSchedulerTest, shrinks_chunks_as_elements_become_costlier)
+{
+    // GIVEN
+    sample::thread_pool pool(1);
+    sample::work_stealing_scheduler scheduler(pool,
+        std::chrono::microseconds(200));
+    std::list<int> l(2000);
+    const sample::any_forward_range<int> range(l);
+    using Piece = sample::split_range<
+        sample::any_forward_range<int>::iterator>;
+
+    // WHEN
+    auto costly = [](const Piece& piece) {
+        std::this_thread::sleep_for(std::chrono::microseconds(10) *
+                                    piece.size());
+    };
+    scheduler.run(range, [](const Piece&) {});
+    const std::size_t cheapChunk = scheduler.chunk_size();
+    scheduler.run(range, costly);
+    scheduler.run(range, costly);
+    const std::size_t costlyChunk = scheduler.chunk_size();
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(costlyChunk, Lt(cheapChunk));
+    EXPECT_THAT(costlyChunk, Le(25u));
+}
+
+TEST(WorkStealingSchedulerTest, rethrows_exception_and_stops)
+{
+    // GIVEN
+    sample::thread_pool pool(2);
+    sample::work_stealing_scheduler scheduler(pool);
+    std::vector<int> v(1000);
+    const sample::any_random_access_range<int> range(v);
+    using Piece = sample::split_range<
+        sample::any_random_access_range<int>::iterator>;
+
+    // WHEN
+    auto run = [&] {
+        scheduler.run(range, [](const Piece&) {
+            throw std::runtime_error("failed");
+        });
+    };
+
+    // THEN
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(WorkStealingSchedulerTest, starts_with_a_piece_per_thread)
+{
+    // GIVEN
+    sample::thread_pool pool(1);
+    sample::work_stealing_scheduler scheduler(pool);
+    std::vector<int> v(1000);
+    const sample::any_random_access_range<int> range(v);
+    using Piece = sample::split_range<
+        sample::any_random_access_range<int>::iterator>;
+
+    // WHEN
+    std::atomic<std::size_t> first{0};
+    scheduler.run(range, [&](const Piece& piece) {
+        std::size_t none = 0;
+        first.compare_exchange_strong(none, piece.size());
+    });
+
+    // THEN
+    using namespace ::testing;
+    EXPECT_THAT(first.load(), Eq(v.size() / pool.concurrency()));
+}